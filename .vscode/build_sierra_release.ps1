@@ -39,6 +39,29 @@ $extraSources = @(
     'CombinationGenerator.cpp'
     'InputParameter.cpp'
     'ReportGenerator.cpp'
+    'LaneDispatcher.cpp'
+    'LeaseCoordinator.cpp'
+    'TradeMetrics.cpp'
+    'ParetoFront.cpp'
+    'GridNeighborhood.cpp'
+    'MonteCarloResampler.cpp'
+    'SweepStatistics.cpp'
+    'WalkForward.cpp'
+    'EquityClustering.cpp'
+    'HeatmapCubes.cpp'
+    'SurrogateModel.cpp'
+    'ScidReader.cpp'
+    'MappedFile.cpp'
+    'ColumnarCache.cpp'
+    'BarAggregator.cpp'
+    'IndicatorCache.cpp'
+    'IndicatorKernels.cpp'
+    'StrategyPlugin.cpp'
+    'FillSimulator.cpp'
+    'NativeEngine.cpp'
+    'ParityHarness.cpp'
+    'Portfolio.cpp'
+    'JobQueue.cpp'
 )
 
 # Join into a single space-separated string
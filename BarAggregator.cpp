@@ -0,0 +1,403 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "BarAggregator.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const long long MILLISECONDS_PER_DAY = 86400000LL;
+    const long long OUTSIDE_SESSION = -1;
+
+    // Ticks prepared per block, small enough for the block arrays to stay in cache while every spec runs over them
+    const size_t TICK_BLOCK = 4096;
+
+    // Open values Sierra Chart writes into a record that holds a single trade, with the bid and ask in High and Low.
+    // Any other record carries the open, high and low of the trades it aggregates.
+    const float SINGLE_TRADE_WITH_BID_ASK = 0.0f;
+    const float SUB_TRADE_MARKER_LIMIT = -1.0e37f;
+
+    const uint32_t BAR_FILE_VERSION = 1;
+    const char BAR_FILE_MAGIC[4] = {'S', 'B', 'A', 'R'};
+
+    struct BarFileHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t Type;
+        int32_t SessionStartSeconds;
+        int32_t SessionEndSeconds;
+        uint32_t Reserved;
+        double Size;
+        uint64_t SourceRecordCount; // Tick records the bars were built from
+        SCDateTimeMS SourceLastDateTime;
+        uint64_t BarCount;
+    };
+
+    // Ticks of one block with the record kinds resolved, so the bar state machines only read plain prices
+    struct TickBlock
+    {
+        long long Milliseconds[TICK_BLOCK];
+        long long SessionStart[TICK_BLOCK]; // In milliseconds, OUTSIDE_SESSION for ticks the chart leaves out
+        float Open[TICK_BLOCK];
+        float High[TICK_BLOCK];
+        float Low[TICK_BLOCK];
+        float Close[TICK_BLOCK];
+    };
+
+    struct BarBuilder
+    {
+        BarSeries *Series = nullptr;
+        long long SessionStart = OUTSIDE_SESSION;
+        bool Forming = false;
+        long long TimeBarIndex = 0;
+        bool HasBrick = false;
+        double BrickTop = 0.0; // Upper and lower end of the last Renko brick, or the first price of the session
+        double BrickBottom = 0.0;
+    };
+
+    void StartBar(BarSeries &series, long long milliseconds, float open)
+    {
+        series.DateTime.push_back(SCDateTimeMS((double)milliseconds / MILLISECONDS_PER_DAY));
+        series.Open.push_back(open);
+        series.High.push_back(open);
+        series.Low.push_back(open);
+        series.Close.push_back(open);
+        series.NumTrades.push_back(0);
+        series.Volume.push_back(0);
+        series.BidVolume.push_back(0);
+        series.AskVolume.push_back(0);
+    }
+
+    void AddTick(BarSeries &series, const TickBlock &block, const ColumnarCache &ticks, size_t position, size_t i)
+    {
+        size_t bar = series.GetSize() - 1;
+        series.High[bar] = (std::max)(series.High[bar], block.High[i]);
+        series.Low[bar] = (std::min)(series.Low[bar], block.Low[i]);
+        series.Close[bar] = block.Close[i];
+        series.NumTrades[bar] += ticks.GetNumTrades()[position];
+        series.Volume[bar] += ticks.GetTotalVolume()[position];
+        series.BidVolume[bar] += ticks.GetBidVolume()[position];
+        series.AskVolume[bar] += ticks.GetAskVolume()[position];
+    }
+
+    // Emits the Renko bricks the close of tick i completes. The first closes the forming bar, further ones are
+    // bricks of the same tick without volume.
+    void AddBricks(BarBuilder &builder, const TickBlock &block, size_t i)
+    {
+        BarSeries &series = *builder.Series;
+        double brickSize = series.Spec.Size;
+        double tolerance = brickSize * 1e-6;
+        double price = block.Close[i];
+        while (true)
+        {
+            double open, close;
+            if (price >= builder.BrickTop + brickSize - tolerance)
+            {
+                open = builder.BrickTop;
+                close = builder.BrickTop + brickSize;
+                builder.BrickBottom = open;
+                builder.BrickTop = close;
+            }
+            else if (price <= builder.BrickBottom - brickSize + tolerance)
+            {
+                open = builder.BrickBottom;
+                close = builder.BrickBottom - brickSize;
+                builder.BrickTop = open;
+                builder.BrickBottom = close;
+            }
+            else
+            {
+                break;
+            }
+
+            if (!builder.Forming)
+                StartBar(series, block.Milliseconds[i], (float)open);
+            size_t bar = series.GetSize() - 1;
+            series.Open[bar] = (float)open;
+            series.Close[bar] = (float)close;
+            series.High[bar] = (std::max)(series.High[bar], (float)(std::max)(open, close));
+            series.Low[bar] = (std::min)(series.Low[bar], (float)(std::min)(open, close));
+            builder.Forming = false;
+        }
+    }
+
+    long long GetMilliseconds(const SCDateTimeMS &dateTime)
+    {
+        return (long long)(dateTime.GetAsDouble() * MILLISECONDS_PER_DAY + 0.5);
+    }
+
+    // Start of the session holding the time in milliseconds, OUTSIDE_SESSION when the chart leaves it out
+    long long GetSessionStart(long long milliseconds, const SessionTimes &session)
+    {
+        long long sessionStart = session.StartSeconds * 1000LL;
+        long long sessionEnd = (session.EndSeconds + 1) * 1000LL;
+        long long dayStart = milliseconds / MILLISECONDS_PER_DAY * MILLISECONDS_PER_DAY;
+        long long timeOfDay = milliseconds - dayStart;
+        if (session.StartSeconds <= session.EndSeconds)
+            return timeOfDay >= sessionStart && timeOfDay < sessionEnd ? dayStart + sessionStart : OUTSIDE_SESSION;
+        if (timeOfDay >= sessionStart)
+            return dayStart + sessionStart;
+        return timeOfDay < sessionEnd ? dayStart - MILLISECONDS_PER_DAY + sessionStart : OUTSIDE_SESSION;
+    }
+
+    void PrepareBlock(const ColumnarCache &ticks, size_t first, size_t count, const SessionTimes &session, TickBlock &block)
+    {
+        const SCDateTimeMS *dateTimes = ticks.GetDateTimes().Data + first;
+        const float *open = ticks.GetOpen().Data + first;
+        const float *high = ticks.GetHigh().Data + first;
+        const float *low = ticks.GetLow().Data + first;
+        const float *close = ticks.GetClose().Data + first;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            block.Milliseconds[i] = GetMilliseconds(dateTimes[i]);
+            block.SessionStart[i] = GetSessionStart(block.Milliseconds[i], session);
+
+            bool singleTrade = open[i] == SINGLE_TRADE_WITH_BID_ASK || open[i] < SUB_TRADE_MARKER_LIMIT;
+            block.Open[i] = singleTrade ? close[i] : open[i];
+            block.High[i] = singleTrade ? close[i] : high[i];
+            block.Low[i] = singleTrade ? close[i] : low[i];
+            block.Close[i] = close[i];
+        }
+    }
+
+    void RunBlock(BarBuilder &builder, const ColumnarCache &ticks, size_t first, size_t count, const TickBlock &block)
+    {
+        BarSeries &series = *builder.Series;
+        long long timeBarMilliseconds = (long long)(series.Spec.Size * 1000.0 + 0.5);
+        double rangeLimit = series.Spec.Size * (1.0 + 1e-6);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (block.SessionStart[i] == OUTSIDE_SESSION)
+                continue;
+            if (block.SessionStart[i] != builder.SessionStart)
+            {
+                builder.SessionStart = block.SessionStart[i];
+                builder.Forming = false;
+                builder.HasBrick = false;
+            }
+
+            switch (series.Spec.Type)
+            {
+            case BarType::Time:
+            {
+                long long index = (block.Milliseconds[i] - builder.SessionStart) / timeBarMilliseconds;
+                if (!builder.Forming || index != builder.TimeBarIndex)
+                {
+                    StartBar(series, builder.SessionStart + index * timeBarMilliseconds, block.Open[i]);
+                    builder.Forming = true;
+                    builder.TimeBarIndex = index;
+                }
+                AddTick(series, block, ticks, first + i, i);
+                break;
+            }
+            case BarType::Volume:
+                if (!builder.Forming)
+                {
+                    StartBar(series, block.Milliseconds[i], block.Open[i]);
+                    builder.Forming = true;
+                }
+                AddTick(series, block, ticks, first + i, i);
+                if (series.Volume.back() >= series.Spec.Size)
+                    builder.Forming = false;
+                break;
+            case BarType::Range:
+                if (builder.Forming && (std::max)(series.High.back(), block.High[i]) - (std::min)(series.Low.back(), block.Low[i]) > rangeLimit)
+                    builder.Forming = false;
+                if (!builder.Forming)
+                {
+                    StartBar(series, block.Milliseconds[i], block.Open[i]);
+                    builder.Forming = true;
+                }
+                AddTick(series, block, ticks, first + i, i);
+                break;
+            case BarType::Renko:
+                if (!builder.HasBrick)
+                {
+                    builder.BrickTop = block.Close[i];
+                    builder.BrickBottom = block.Close[i];
+                    builder.HasBrick = true;
+                }
+                if (!builder.Forming)
+                {
+                    StartBar(series, block.Milliseconds[i], block.Open[i]);
+                    builder.Forming = true;
+                }
+                AddTick(series, block, ticks, first + i, i);
+                AddBricks(builder, block, i);
+                break;
+            }
+        }
+    }
+
+    fs::path GetCachePath(const std::string &scidPath, const BarSpec &spec, const SessionTimes &session)
+    {
+        return fs::path(scidPath + ".bars") / (spec.GetKey() + "-" + std::to_string(session.StartSeconds) + "-" + std::to_string(session.EndSeconds) + ".bars");
+    }
+
+    template <typename T>
+    bool ReadColumn(std::ifstream &file, std::vector<T> &column, size_t count)
+    {
+        column.resize(count);
+        return count == 0 || (bool)file.read(reinterpret_cast<char *>(column.data()), count * sizeof(T));
+    }
+
+    template <typename T>
+    void WriteColumn(std::ofstream &file, const std::vector<T> &column)
+    {
+        file.write(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(T));
+    }
+
+    bool ReadSeries(const fs::path &path, const BarFileHeader &expected, BarSeries &series)
+    {
+        std::ifstream file(path, std::ios::binary);
+        BarFileHeader header;
+        if (!file.is_open() || !file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.Magic, expected.Magic, sizeof(header.Magic)) != 0 || header.Version != expected.Version ||
+            header.Type != expected.Type || header.Size != expected.Size || header.SessionStartSeconds != expected.SessionStartSeconds ||
+            header.SessionEndSeconds != expected.SessionEndSeconds || header.SourceRecordCount != expected.SourceRecordCount ||
+            !(header.SourceLastDateTime == expected.SourceLastDateTime))
+            return false;
+
+        size_t count = (size_t)header.BarCount;
+        return ReadColumn(file, series.DateTime, count) && ReadColumn(file, series.Open, count) && ReadColumn(file, series.High, count) &&
+               ReadColumn(file, series.Low, count) && ReadColumn(file, series.Close, count) && ReadColumn(file, series.NumTrades, count) &&
+               ReadColumn(file, series.Volume, count) && ReadColumn(file, series.BidVolume, count) && ReadColumn(file, series.AskVolume, count);
+    }
+
+    bool WriteSeries(const fs::path &path, BarFileHeader header, const BarSeries &series)
+    {
+        // Written aside and renamed, so a reader never loads half a series
+        fs::path pendingPath = path;
+        pendingPath += ".tmp";
+        {
+            std::ofstream file(pendingPath, std::ios::binary | std::ios::trunc);
+            header.BarCount = series.GetSize();
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            WriteColumn(file, series.DateTime);
+            WriteColumn(file, series.Open);
+            WriteColumn(file, series.High);
+            WriteColumn(file, series.Low);
+            WriteColumn(file, series.Close);
+            WriteColumn(file, series.NumTrades);
+            WriteColumn(file, series.Volume);
+            WriteColumn(file, series.BidVolume);
+            WriteColumn(file, series.AskVolume);
+            if (!file)
+                return false;
+        }
+
+        std::error_code ec;
+        fs::rename(pendingPath, path, ec);
+        return !ec;
+    }
+}
+
+SCDateTimeMS SessionTimes::GetSessionEnd(const SCDateTimeMS &dateTime) const
+{
+    long long sessionStart = GetSessionStart(GetMilliseconds(dateTime), *this);
+    if (sessionStart == OUTSIDE_SESSION)
+        return dateTime;
+
+    long long length = (EndSeconds + 1 - StartSeconds) * 1000LL;
+    if (StartSeconds > EndSeconds)
+        length += MILLISECONDS_PER_DAY;
+    return SCDateTimeMS((double)(sessionStart + length) / MILLISECONDS_PER_DAY);
+}
+
+std::string BarSpec::GetKey() const
+{
+    const char *typeName = Type == BarType::Time ? "Time" : Type == BarType::Volume ? "Volume" : Type == BarType::Range ? "Range" : "Renko";
+    char key[64];
+    std::snprintf(key, sizeof(key), "%s-%.10g", typeName, Size);
+    return key;
+}
+
+namespace BarAggregator
+{
+    std::vector<BarSeries> Build(const ColumnarCache &ticks, const std::vector<BarSpec> &specs, const SessionTimes &session)
+    {
+        std::vector<BarSeries> series(specs.size());
+        std::vector<BarBuilder> builders(specs.size());
+        for (size_t spec = 0; spec < specs.size(); ++spec)
+        {
+            series[spec].Spec = specs[spec];
+            builders[spec].Series = &series[spec];
+        }
+
+        // One pass over the mapped columns: each block is prepared once, then every spec runs over it while it is in cache
+        std::vector<TickBlock> block(1); // 128 KB, kept off the stack
+        for (size_t first = 0; first < ticks.GetRecordCount(); first += TICK_BLOCK)
+        {
+            size_t count = (std::min)(TICK_BLOCK, ticks.GetRecordCount() - first);
+            PrepareBlock(ticks, first, count, session, block[0]);
+            for (BarBuilder &builder : builders)
+            {
+                RunBlock(builder, ticks, first, count, block[0]);
+            }
+        }
+        return series;
+    }
+
+    bool Load(const std::string &scidPath, const std::vector<BarSpec> &specs, const SessionTimes &session, std::vector<BarSeries> &series, std::string &error)
+    {
+        ColumnarCache ticks;
+        if (!ticks.Open(scidPath, error))
+            return false;
+
+        for (const BarSpec &spec : specs)
+        {
+            if (spec.Size <= 0.0)
+            {
+                error = "Bar size of " + spec.GetKey() + " must be greater than 0.";
+                return false;
+            }
+        }
+
+        BarFileHeader header = {};
+        std::memcpy(header.Magic, BAR_FILE_MAGIC, sizeof(BAR_FILE_MAGIC));
+        header.Version = BAR_FILE_VERSION;
+        header.SessionStartSeconds = session.StartSeconds;
+        header.SessionEndSeconds = session.EndSeconds;
+        header.SourceRecordCount = ticks.GetRecordCount();
+        header.SourceLastDateTime = ticks.GetRecordCount() > 0 ? ticks.GetDateTimes()[ticks.GetRecordCount() - 1] : SCDateTimeMS();
+
+        series.assign(specs.size(), BarSeries());
+        std::vector<BarSpec> missingSpecs;
+        std::vector<size_t> missingPositions;
+        for (size_t spec = 0; spec < specs.size(); ++spec)
+        {
+            header.Type = (uint32_t)specs[spec].Type;
+            header.Size = specs[spec].Size;
+            series[spec].Spec = specs[spec];
+            if (!ReadSeries(GetCachePath(scidPath, specs[spec], session), header, series[spec]))
+            {
+                missingSpecs.push_back(specs[spec]);
+                missingPositions.push_back(spec);
+            }
+        }
+        if (missingSpecs.empty())
+            return true;
+
+        std::vector<BarSeries> built = Build(ticks, missingSpecs, session);
+        std::error_code ec;
+        fs::create_directories(fs::path(scidPath + ".bars"), ec);
+        for (size_t i = 0; i < built.size(); ++i)
+        {
+            // A cache that cannot be written only costs a rebuild next time
+            header.Type = (uint32_t)missingSpecs[i].Type;
+            header.Size = missingSpecs[i].Size;
+            if (!ec)
+                WriteSeries(GetCachePath(scidPath, missingSpecs[i], session), header, built[i]);
+            series[missingPositions[i]] = std::move(built[i]);
+        }
+        return true;
+    }
+}
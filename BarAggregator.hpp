@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "ColumnarCache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class BarType
+{
+    Time,   // Size in seconds, bars aligned to the session start
+    Volume, // Size in contracts, a bar closes on the trade that reaches it
+    Range,  // Size in price, a bar closes before the trade that would stretch it past the range
+    Renko   // Size in price per brick, a reversal takes two bricks
+};
+
+struct BarSpec
+{
+    BarType Type = BarType::Time;
+    double Size = 60.0;
+
+    // File name safe identity of the spec, e.g. "Volume-1000"
+    std::string GetKey() const;
+};
+
+// Chart session in seconds of the day, as sc.StartTime1 and sc.EndTime1. The end second is part of the session and a start
+// after the end is a session that runs over midnight. Trades outside the session are not charted and no bar spans two sessions.
+struct SessionTimes
+{
+    int StartSeconds = 0;
+    int EndSeconds = 86399;
+
+    // First date time after the session holding the date time, the date time itself when it is outside every session
+    SCDateTimeMS GetSessionEnd(const SCDateTimeMS &dateTime) const;
+};
+
+// Bars of one spec, one entry per bar in every array. DateTime is the bar start for time bars and the first trade otherwise.
+struct BarSeries
+{
+    BarSpec Spec;
+    std::vector<SCDateTimeMS> DateTime;
+    std::vector<float> Open;
+    std::vector<float> High;
+    std::vector<float> Low;
+    std::vector<float> Close;
+    std::vector<uint32_t> NumTrades;
+    std::vector<uint32_t> Volume;
+    std::vector<uint32_t> BidVolume;
+    std::vector<uint32_t> AskVolume;
+
+    size_t GetSize() const { return DateTime.size(); }
+};
+
+// Builds the bars of a chart from the tick data of its .scid file, the way Sierra Chart forms them
+namespace BarAggregator
+{
+    // Every spec is built in a single pass over the tick columns, one series per spec in spec order
+    std::vector<BarSeries> Build(const ColumnarCache &ticks, const std::vector<BarSpec> &specs, const SessionTimes &session);
+
+    // Reads each series from <scid>.bars/, building the missing or stale ones in one pass and caching them.
+    // The columnar cache of the .scid file must be up to date.
+    bool Load(const std::string &scidPath, const std::vector<BarSpec> &specs, const SessionTimes &session, std::vector<BarSeries> &series, std::string &error);
+}
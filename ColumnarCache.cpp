@@ -0,0 +1,349 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "ColumnarCache.hpp"
+#include "DateTimeIndex.hpp"
+#include "ScidReader.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const uint32_t MANIFEST_VERSION = 1;
+    const char MANIFEST_MAGIC[4] = {'S', 'C', 'O', 'L'};
+    const char *MANIFEST_FILE_NAME = "manifest.bin";
+
+    const uint32_t INDEX_VERSION = 1;
+    const char INDEX_MAGIC[4] = {'S', 'C', 'I', 'X'};
+    const char *INDEX_FILE_NAME = "DateTime.idx";
+
+    // Records transposed per write, 40 bytes each
+    const size_t CONVERT_CHUNK = 65536;
+
+    // In ColumnId order
+    const char *COLUMN_FILE_NAMES[] = {"DateTime.col", "Open.col", "High.col", "Low.col", "Close.col",
+                                       "NumTrades.col", "TotalVolume.col", "BidVolume.col", "AskVolume.col"};
+    const size_t COLUMN_VALUE_SIZES[] = {sizeof(SCDateTimeMS), sizeof(float), sizeof(float), sizeof(float), sizeof(float),
+                                         sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t)};
+
+    struct ManifestFile
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint64_t RecordCount;
+        SCDateTimeMS FirstDateTime; // Of the source records, to tell an append from a rewrite
+        SCDateTimeMS LastDateTime;
+    };
+
+    // Sparse date time index of the DateTime column, valid for the manifest with the same count and date times
+    struct IndexFileHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t Stride;
+        uint32_t Reserved;
+        uint64_t RecordCount;
+        SCDateTimeMS FirstDateTime;
+        SCDateTimeMS LastDateTime;
+    };
+
+    std::string GetDirectory(const std::string &scidPath)
+    {
+        return scidPath + ".columns";
+    }
+
+    bool ReadManifest(const fs::path &directory, ManifestFile &manifest)
+    {
+        std::ifstream manifestFile(directory / MANIFEST_FILE_NAME, std::ios::binary);
+        return manifestFile.is_open() && manifestFile.read(reinterpret_cast<char *>(&manifest), sizeof(manifest)) &&
+               std::memcmp(manifest.Magic, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC)) == 0 && manifest.Version == MANIFEST_VERSION;
+    }
+
+    bool WriteManifest(const fs::path &directory, const ManifestFile &manifest)
+    {
+        fs::path manifestPath = directory / MANIFEST_FILE_NAME;
+        fs::path pendingPath = manifestPath;
+        pendingPath += ".tmp";
+        {
+            std::ofstream manifestFile(pendingPath, std::ios::binary | std::ios::trunc);
+            if (!manifestFile.write(reinterpret_cast<const char *>(&manifest), sizeof(manifest)))
+                return false;
+        }
+
+        std::error_code ec;
+        fs::rename(pendingPath, manifestPath, ec);
+        return !ec;
+    }
+
+    bool ReadIndex(const fs::path &directory, const ManifestFile &manifest, std::vector<SCDateTimeMS> &index)
+    {
+        index.clear();
+        std::ifstream indexFile(directory / INDEX_FILE_NAME, std::ios::binary);
+        IndexFileHeader header;
+        if (!indexFile.is_open() || !indexFile.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.Magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header.Version != INDEX_VERSION || header.Stride != DateTimeIndex::STRIDE ||
+            header.RecordCount != manifest.RecordCount || !(header.FirstDateTime == manifest.FirstDateTime) || !(header.LastDateTime == manifest.LastDateTime))
+            return false;
+
+        index.resize((size_t)((header.RecordCount + DateTimeIndex::STRIDE - 1) / DateTimeIndex::STRIDE));
+        if (!index.empty() && !indexFile.read(reinterpret_cast<char *>(index.data()), index.size() * sizeof(SCDateTimeMS)))
+        {
+            index.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // Written aside and renamed like the manifest. A read-only data folder only costs rebuilding the index on open.
+    bool WriteIndex(const fs::path &directory, const ManifestFile &manifest, const std::vector<SCDateTimeMS> &index)
+    {
+        fs::path indexPath = directory / INDEX_FILE_NAME;
+        fs::path pendingPath = indexPath;
+        pendingPath += ".tmp";
+        {
+            std::ofstream indexFile(pendingPath, std::ios::binary | std::ios::trunc);
+            IndexFileHeader header = {};
+            std::memcpy(header.Magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+            header.Version = INDEX_VERSION;
+            header.Stride = (uint32_t)DateTimeIndex::STRIDE;
+            header.RecordCount = manifest.RecordCount;
+            header.FirstDateTime = manifest.FirstDateTime;
+            header.LastDateTime = manifest.LastDateTime;
+            indexFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            indexFile.write(reinterpret_cast<const char *>(index.data()), index.size() * sizeof(SCDateTimeMS));
+            if (!indexFile)
+                return false;
+        }
+
+        std::error_code ec;
+        fs::rename(pendingPath, indexPath, ec);
+        if (ec)
+            fs::remove(pendingPath, ec);
+        return !ec;
+    }
+
+    template <typename T, typename Field>
+    void Transpose(const s_IntradayRecord *records, size_t count, std::vector<char> &buffer, Field field)
+    {
+        buffer.resize(count * sizeof(T));
+        T *values = reinterpret_cast<T *>(buffer.data());
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = field(records[i]);
+        }
+    }
+}
+
+ColumnarCache::ColumnarCache()
+    : recordCount(0)
+{
+}
+
+bool ColumnarCache::Update(const std::string &scidPath, std::string &error)
+{
+    ScidReader reader;
+    if (!reader.Open(scidPath, error))
+        return false;
+
+    IntradayRecordSpan records = reader.GetRecords();
+    fs::path directory = GetDirectory(scidPath);
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec)
+    {
+        error = "Cannot create '" + directory.string() + "': " + ec.message();
+        return false;
+    }
+
+    // Continue from the converted count when the source only grew since, and every column holds at least that much
+    ManifestFile manifest;
+    uint64_t convertedCount = 0;
+    std::vector<SCDateTimeMS> index;
+    if (ReadManifest(directory, manifest) && manifest.RecordCount <= records.Size &&
+        (manifest.RecordCount == 0 || (records.Data[0].DateTime == manifest.FirstDateTime &&
+                                       records.Data[manifest.RecordCount - 1].DateTime == manifest.LastDateTime)))
+    {
+        convertedCount = manifest.RecordCount;
+        for (int column = 0; column < COLUMN_COUNT; ++column)
+        {
+            uintmax_t columnSize = fs::file_size(directory / COLUMN_FILE_NAMES[column], ec);
+            if (ec || columnSize < convertedCount * COLUMN_VALUE_SIZES[column])
+                convertedCount = 0;
+        }
+    }
+
+    if (convertedCount == records.Size && records.Size > 0)
+        return true;
+
+    // The index of the converted records is extended with the new ones, not rebuilt
+    if (convertedCount == 0 || !ReadIndex(directory, manifest, index))
+        index.clear();
+
+    // Values an interrupted update wrote past the manifest are dropped before appending
+    std::ofstream columnFiles[COLUMN_COUNT];
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        fs::path columnPath = directory / COLUMN_FILE_NAMES[column];
+        if (convertedCount == 0)
+        {
+            std::ofstream(columnPath, std::ios::binary | std::ios::trunc);
+        }
+        else
+        {
+            fs::resize_file(columnPath, convertedCount * COLUMN_VALUE_SIZES[column], ec);
+        }
+        columnFiles[column].open(columnPath, std::ios::binary | std::ios::app);
+        if (ec || !columnFiles[column].is_open())
+        {
+            error = "Cannot write '" + columnPath.string() + "'.";
+            return false;
+        }
+    }
+
+    std::vector<char> buffer;
+    for (size_t first = (size_t)convertedCount; first < records.Size; first += CONVERT_CHUNK)
+    {
+        const s_IntradayRecord *chunk = records.Data + first;
+        size_t count = (std::min)(CONVERT_CHUNK, records.Size - first);
+        for (int column = 0; column < COLUMN_COUNT; ++column)
+        {
+            switch (column)
+            {
+            case DATE_TIME:
+                Transpose<SCDateTimeMS>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                        { return record.DateTime; });
+                break;
+            case OPEN:
+                Transpose<float>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                 { return record.Open; });
+                break;
+            case HIGH:
+                Transpose<float>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                 { return record.High; });
+                break;
+            case LOW:
+                Transpose<float>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                 { return record.Low; });
+                break;
+            case CLOSE:
+                Transpose<float>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                 { return record.Close; });
+                break;
+            case NUM_TRADES:
+                Transpose<uint32_t>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                    { return record.NumTrades; });
+                break;
+            case TOTAL_VOLUME:
+                Transpose<uint32_t>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                    { return record.TotalVolume; });
+                break;
+            case BID_VOLUME:
+                Transpose<uint32_t>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                    { return record.BidVolume; });
+                break;
+            case ASK_VOLUME:
+                Transpose<uint32_t>(chunk, count, buffer, [](const s_IntradayRecord &record)
+                                    { return record.AskVolume; });
+                break;
+            }
+            columnFiles[column].write(buffer.data(), buffer.size());
+        }
+    }
+
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        columnFiles[column].close();
+        if (columnFiles[column].fail())
+        {
+            error = "Cannot write '" + (directory / COLUMN_FILE_NAMES[column]).string() + "'.";
+            return false;
+        }
+    }
+
+    std::memcpy(manifest.Magic, MANIFEST_MAGIC, sizeof(MANIFEST_MAGIC));
+    manifest.Version = MANIFEST_VERSION;
+    manifest.RecordCount = records.Size;
+    manifest.FirstDateTime = records.IsEmpty() ? SCDateTimeMS() : records.Data[0].DateTime;
+    manifest.LastDateTime = records.IsEmpty() ? SCDateTimeMS() : records.Data[records.Size - 1].DateTime;
+
+    // Before the manifest, so an index is never newer than the manifest it is checked against
+    DateTimeIndex::Extend(index, records.Size, [&records](size_t i)
+                          { return records.Data[i].DateTime; });
+    WriteIndex(directory, manifest, index);
+
+    if (!WriteManifest(directory, manifest))
+    {
+        error = "Cannot write the manifest of '" + directory.string() + "'.";
+        return false;
+    }
+    return true;
+}
+
+bool ColumnarCache::Open(const std::string &scidPath, std::string &error)
+{
+    Close();
+
+    fs::path directory = GetDirectory(scidPath);
+    ManifestFile manifest;
+    if (!ReadManifest(directory, manifest))
+    {
+        error = "'" + directory.string() + "' has no columnar cache, run an update first.";
+        return false;
+    }
+
+    // Columns may run past the manifest after an interrupted update, only the converted records are used
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        if (!columns[column].Open((directory / COLUMN_FILE_NAMES[column]).string(), error))
+        {
+            Close();
+            return false;
+        }
+        if (columns[column].GetSize() < manifest.RecordCount * COLUMN_VALUE_SIZES[column])
+        {
+            error = "'" + (directory / COLUMN_FILE_NAMES[column]).string() + "' is shorter than its manifest.";
+            Close();
+            return false;
+        }
+    }
+    recordCount = (size_t)manifest.RecordCount;
+
+    // An index missing or out of step with the manifest is rebuilt from the DateTime column and saved for the next open
+    if (!ReadIndex(directory, manifest, indexDateTimes))
+    {
+        ColumnSpan<SCDateTimeMS> dateTimes = GetDateTimes();
+        DateTimeIndex::Extend(indexDateTimes, recordCount, [&dateTimes](size_t i)
+                              { return dateTimes[i]; });
+        WriteIndex(directory, manifest, indexDateTimes);
+    }
+    return true;
+}
+
+void ColumnarCache::Close()
+{
+    for (MappedFile &column : columns)
+    {
+        column.Close();
+    }
+    recordCount = 0;
+    indexDateTimes.clear();
+}
+
+size_t ColumnarCache::LowerBound(const SCDateTimeMS &dateTime) const
+{
+    ColumnSpan<SCDateTimeMS> dateTimes = GetDateTimes();
+    return DateTimeIndex::LowerBound(indexDateTimes, recordCount, dateTime, [&dateTimes](size_t i)
+                                     { return dateTimes[i]; });
+}
+
+ColumnRange ColumnarCache::GetRange(const SCDateTimeMS &startDateTime, const SCDateTimeMS &endDateTime) const
+{
+    ColumnRange range;
+    range.First = LowerBound(startDateTime);
+    range.Last = endDateTime.GetAsDouble() == 0.0 ? recordCount : (std::max)(range.First, LowerBound(endDateTime));
+    return range;
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only view of consecutive values of one column, valid while the cache stays open
+template <typename T>
+struct ColumnSpan
+{
+    const T *Data = nullptr;
+    size_t Size = 0;
+
+    const T *begin() const { return Data; }
+    const T *end() const { return Data + Size; }
+    bool IsEmpty() const { return Size == 0; }
+    const T &operator[](size_t i) const { return Data[i]; }
+
+    // Values at positions first to last - 1
+    ColumnSpan Slice(size_t first, size_t last) const { return {Data + first, last - first}; }
+};
+
+// Positions first to last - 1 of every column
+struct ColumnRange
+{
+    size_t First = 0;
+    size_t Last = 0;
+
+    size_t GetSize() const { return Last - First; }
+};
+
+// Column by column copy of a .scid file, kept in <file>.columns/ with one headerless file of raw values per
+// s_IntradayRecord field. A column is a contiguous, page aligned array of one type, so a scan over the closes or
+// the volumes reads only that data and vectorizes. All columns share the date time order of the source file.
+//
+// Update converts the records appended since the last call and leaves the converted history untouched. The manifest,
+// which holds the converted record count, is written last, so an interrupted update is redone from the previous count.
+// The sparse date time index is kept in the same folder and only used while it matches the manifest.
+class ColumnarCache
+{
+public:
+    ColumnarCache();
+    ColumnarCache(const ColumnarCache &) = delete;
+    ColumnarCache &operator=(const ColumnarCache &) = delete;
+
+    // Brings the cache of the .scid file up to date, rebuilding it when the file was rewritten rather than appended to
+    static bool Update(const std::string &scidPath, std::string &error);
+
+    bool Open(const std::string &scidPath, std::string &error);
+    void Close();
+
+    size_t GetRecordCount() const { return recordCount; }
+
+    ColumnSpan<SCDateTimeMS> GetDateTimes() const { return GetColumn<SCDateTimeMS>(DATE_TIME); }
+    ColumnSpan<float> GetOpen() const { return GetColumn<float>(OPEN); }
+    ColumnSpan<float> GetHigh() const { return GetColumn<float>(HIGH); }
+    ColumnSpan<float> GetLow() const { return GetColumn<float>(LOW); }
+    ColumnSpan<float> GetClose() const { return GetColumn<float>(CLOSE); }
+    ColumnSpan<uint32_t> GetNumTrades() const { return GetColumn<uint32_t>(NUM_TRADES); }
+    ColumnSpan<uint32_t> GetTotalVolume() const { return GetColumn<uint32_t>(TOTAL_VOLUME); }
+    ColumnSpan<uint32_t> GetBidVolume() const { return GetColumn<uint32_t>(BID_VOLUME); }
+    ColumnSpan<uint32_t> GetAskVolume() const { return GetColumn<uint32_t>(ASK_VOLUME); }
+
+    // Position of the first record at or after dateTime, GetRecordCount() when there is none
+    size_t LowerBound(const SCDateTimeMS &dateTime) const;
+
+    // Records with startDateTime <= DateTime < endDateTime. A zero end date time runs to the end of the cache.
+    ColumnRange GetRange(const SCDateTimeMS &startDateTime, const SCDateTimeMS &endDateTime) const;
+
+private:
+    enum ColumnId
+    {
+        DATE_TIME,
+        OPEN,
+        HIGH,
+        LOW,
+        CLOSE,
+        NUM_TRADES,
+        TOTAL_VOLUME,
+        BID_VOLUME,
+        ASK_VOLUME,
+        COLUMN_COUNT
+    };
+
+    template <typename T>
+    ColumnSpan<T> GetColumn(ColumnId column) const
+    {
+        return {static_cast<const T *>(columns[column].GetData()), recordCount};
+    }
+
+    MappedFile columns[COLUMN_COUNT];
+    size_t recordCount;
+
+    // Date time of record i * DateTimeIndex::STRIDE
+    std::vector<SCDateTimeMS> indexDateTimes;
+};
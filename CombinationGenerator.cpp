@@ -59,6 +59,31 @@ namespace CombinationGenerator
         return combinations;
     }
 
+    std::vector<std::vector<double>> GetParamValues(const std::vector<InputConfig> &varyingParams)
+    {
+        std::vector<std::vector<double>> paramValues;
+        for (const auto &p : varyingParams)
+        {
+            std::vector<double> values;
+            if (p.Increment > 0)
+            {
+                for (double i = p.MinValue; i <= p.MaxValue + 1e-9; i += p.Increment)
+                {
+                    values.push_back(i);
+                }
+            }
+            else
+            {
+                for (double i = p.MinValue; i >= p.MaxValue - 1e-9; i += p.Increment)
+                {
+                    values.push_back(i);
+                }
+            }
+            paramValues.push_back(values);
+        }
+        return paramValues;
+    }
+
     std::vector<std::vector<double>> GenerateIterative(const std::vector<InputConfig> &params)
     {
         std::vector<std::vector<double>> combinations;
@@ -82,27 +107,7 @@ namespace CombinationGenerator
 
         std::vector<double> currentCombination;
         std::vector<size_t> p_indices(varyingParams.size(), 0);
-        std::vector<std::vector<double>> paramValues;
-
-        for (const auto &p : varyingParams)
-        {
-            std::vector<double> values;
-            if (p.Increment > 0)
-            {
-                for (double i = p.MinValue; i <= p.MaxValue + 1e-9; i += p.Increment)
-                {
-                    values.push_back(i);
-                }
-            }
-            else
-            {
-                for (double i = p.MinValue; i >= p.MaxValue - 1e-9; i += p.Increment)
-                {
-                    values.push_back(i);
-                }
-            }
-            paramValues.push_back(values);
-        }
+        std::vector<std::vector<double>> paramValues = GetParamValues(varyingParams);
 
         while (true)
         {
@@ -133,4 +138,90 @@ namespace CombinationGenerator
 
         return combinations;
     }
-}
\ No newline at end of file
+
+    std::vector<int> GetGridShape(const std::vector<InputConfig> &params)
+    {
+        std::vector<InputConfig> varyingParams;
+        for (const auto &p : params)
+        {
+            if (std::fabs(p.Increment) > 1e-9)
+            {
+                varyingParams.push_back(p);
+            }
+        }
+
+        std::vector<int> shape;
+        for (const auto &values : GetParamValues(varyingParams))
+        {
+            shape.push_back((int)values.size());
+        }
+        return shape;
+    }
+
+    std::vector<std::vector<double>> GenerateShard(const std::vector<InputConfig> &params, const ShardConfig &shardConfig, std::vector<int> &globalIndices)
+    {
+        std::vector<std::vector<double>> combinations;
+        globalIndices.clear();
+
+        std::vector<InputConfig> varyingParams;
+        for (const auto &p : params)
+        {
+            if (std::fabs(p.Increment) > 1e-9)
+            {
+                varyingParams.push_back(p);
+            }
+        }
+
+        std::vector<std::vector<double>> paramValues = GetParamValues(varyingParams);
+        long long total = params.empty() ? 0 : 1;
+        for (const auto &values : paramValues)
+        {
+            total *= (long long)values.size();
+        }
+
+        // Strided interleaves the lexicographic order so each shard sees the whole range of every parameter,
+        // blocked keeps neighbouring combinations together
+        std::vector<long long> slice;
+        if (shardConfig.Mode == ShardMode::STRIDED)
+        {
+            for (long long g = shardConfig.ShardIndex; g < total; g += shardConfig.ShardCount)
+                slice.push_back(g);
+        }
+        else
+        {
+            long long begin = total * shardConfig.ShardIndex / shardConfig.ShardCount;
+            long long end = total * (shardConfig.ShardIndex + 1) / shardConfig.ShardCount;
+            for (long long g = begin; g < end; ++g)
+                slice.push_back(g);
+        }
+
+        // Decode each global index as a mixed radix number, last parameter varying fastest like GenerateIterative
+        for (long long g : slice)
+        {
+            std::vector<double> combination(paramValues.size());
+            long long remainder = g;
+            for (size_t i = paramValues.size(); i-- > 0;)
+            {
+                combination[i] = paramValues[i][(size_t)(remainder % (long long)paramValues[i].size())];
+                remainder /= (long long)paramValues[i].size();
+            }
+            combinations.push_back(combination);
+            globalIndices.push_back((int)g);
+        }
+
+        return combinations;
+    }
+
+    std::vector<double> ExpandCombination(const std::vector<InputConfig> &params, const std::vector<double> &combination)
+    {
+        std::vector<double> values;
+        values.reserve(params.size());
+        size_t varying = 0;
+        for (const auto &p : params)
+        {
+            bool isVarying = std::fabs(p.Increment) > 1e-9 && varying < combination.size();
+            values.push_back(isVarying ? combination[varying++] : p.MinValue);
+        }
+        return values;
+    }
+}
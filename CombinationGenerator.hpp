@@ -11,6 +11,12 @@ namespace CombinationGenerator
 {
     std::vector<std::vector<double>> Generate(const std::vector<InputConfig> &param_configs);
     std::vector<std::vector<double>> GenerateIterative(const std::vector<InputConfig>& params);
+    std::vector<std::vector<double>> GetParamValues(const std::vector<InputConfig>& varyingParams);
+    std::vector<int> GetGridShape(const std::vector<InputConfig>& params);
+    std::vector<std::vector<double>> GenerateShard(const std::vector<InputConfig>& params, const ShardConfig& shardConfig, std::vector<int>& globalIndices);
+
+    // Values of every input in params order for a combination of the varying inputs, fixed inputs take their MinValue
+    std::vector<double> ExpandCombination(const std::vector<InputConfig>& params, const std::vector<double>& combination);
 }
 
 #endif // COMBINATION_GENERATOR_HPP
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <filesystem>
 #include "Enum.hpp"
 #include "OnChartLogging.hpp"
 #include "CombinationGenerator.hpp"
@@ -55,6 +56,16 @@ namespace
         SCDateTimeMS DateValue = sc.DateStringToSCDateTime(outConfig.ReplayConfig.StartDate);
         SCDateTimeMS TimeValue = sc.TimeStringToSCDateTime(outConfig.ReplayConfig.StartTime);
         outConfig.ReplayConfig.StartDateTime = DateValue + TimeValue;
+
+        outConfig.ReplayConfig.EndDateTime = 0.0;
+        if (replayParams.contains("endDate"))
+        {
+            SCDateTimeMS EndDateValue = sc.DateStringToSCDateTime(replayParams["endDate"].get<std::string>().c_str());
+            SCDateTimeMS EndTimeValue = sc.TimeStringToSCDateTime(replayParams.value("endTime", "23:59:59").c_str());
+            outConfig.ReplayConfig.EndDateTime = EndDateValue + EndTimeValue;
+            if (outConfig.ReplayConfig.EndDateTime <= outConfig.ReplayConfig.StartDateTime)
+                throw std::runtime_error("'endDate' in 'replayConfig' must be after the start date and time.");
+        }
     }
 
     void ParseLogConfig(const json &root, StrategyOptimizerConfig &outConfig)
@@ -74,6 +85,456 @@ namespace
         }
     }
 
+    void ParseWatchdogConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        if (root.contains("watchdogConfig"))
+        {
+            const auto &watchdogParams = root["watchdogConfig"];
+            outConfig.WatchdogConfig.StartTimeoutSeconds = watchdogParams.value("startTimeoutSeconds", 60);
+            outConfig.WatchdogConfig.RunTimeoutSeconds = watchdogParams.value("runTimeoutSeconds", 0);
+            outConfig.WatchdogConfig.MaxRetries = watchdogParams.value("maxRetries", 2);
+        }
+        else // Defaults if section is missing
+        {
+            outConfig.WatchdogConfig.StartTimeoutSeconds = 60;
+            outConfig.WatchdogConfig.RunTimeoutSeconds = 0;
+            outConfig.WatchdogConfig.MaxRetries = 2;
+        }
+
+        if (outConfig.WatchdogConfig.MaxRetries < 0)
+            throw std::runtime_error("'maxRetries' in 'watchdogConfig' must not be negative.");
+    }
+
+    void ParseLaneConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        outConfig.LaneConfig.ChartNumbers.clear();
+        outConfig.LaneConfig.LinkedReplay = false;
+        if (!root.contains("laneConfig"))
+            return;
+
+        const auto &laneParams = root["laneConfig"];
+        outConfig.LaneConfig.LinkedReplay = laneParams.value("linkedReplay", false);
+        if (laneParams.contains("chartNumbers"))
+        {
+            if (!laneParams["chartNumbers"].is_array())
+                throw std::runtime_error("'chartNumbers' in 'laneConfig' must be an array.");
+            for (const auto &chartNumber : laneParams["chartNumbers"])
+            {
+                outConfig.LaneConfig.ChartNumbers.push_back(chartNumber.get<int>());
+            }
+        }
+
+        if (outConfig.LaneConfig.LinkedReplay)
+        {
+            if (outConfig.ReplayConfig.ChartsToReplay != 2)
+                throw std::runtime_error("'linkedReplay' in 'laneConfig' requires 'chartsToReplay' to be 2 (Charts with Same Link Number).");
+        }
+        else if (!outConfig.LaneConfig.ChartNumbers.empty() && outConfig.ReplayConfig.ChartsToReplay != 0)
+            throw std::runtime_error("'laneConfig' requires 'chartsToReplay' to be 0 (Single Chart), otherwise lanes would replay each other's charts.");
+    }
+
+    void ParseDistributedConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        json distributedParams = root.contains("distributedConfig") ? root["distributedConfig"] : json::object();
+        outConfig.DistributedConfig.LeaseDirectory = distributedParams.value("leaseDirectory", "");
+        outConfig.DistributedConfig.WorkerId = distributedParams.value("workerId", "");
+        outConfig.DistributedConfig.ChunkSize = distributedParams.value("chunkSize", 20);
+        outConfig.DistributedConfig.LeaseTimeoutSeconds = distributedParams.value("leaseTimeoutSeconds", 600);
+        outConfig.DistributedConfig.HeartbeatSeconds = distributedParams.value("heartbeatSeconds", 30);
+
+        if (outConfig.DistributedConfig.ChunkSize <= 0)
+            throw std::runtime_error("'chunkSize' in 'distributedConfig' must be greater than 0.");
+        if (outConfig.DistributedConfig.HeartbeatSeconds >= outConfig.DistributedConfig.LeaseTimeoutSeconds)
+            throw std::runtime_error("'heartbeatSeconds' in 'distributedConfig' must be shorter than 'leaseTimeoutSeconds'.");
+    }
+
+    void ParseShardConfig(const json &root, const std::string &filePath, StrategyOptimizerConfig &outConfig)
+    {
+        json shardParams = root.contains("shardConfig") ? root["shardConfig"] : json::object();
+        outConfig.ShardConfig.ShardIndex = shardParams.value("shardIndex", 0);
+        outConfig.ShardConfig.ShardCount = shardParams.value("shardCount", 1);
+        outConfig.ShardConfig.RunName = shardParams.value("runName", "");
+        if (outConfig.ShardConfig.RunName.empty())
+        {
+            // Every shard reads the same config file, so its name gives all shards the same results folder
+            outConfig.ShardConfig.RunName = std::filesystem::path(filePath).stem().string();
+        }
+
+        std::string modeStr = shardParams.value("mode", "strided");
+        if (modeStr == "strided")
+            outConfig.ShardConfig.Mode = ShardMode::STRIDED;
+        else if (modeStr == "blocked")
+            outConfig.ShardConfig.Mode = ShardMode::BLOCKED;
+        else
+            throw std::runtime_error("'mode' in 'shardConfig' must be 'strided' or 'blocked'.");
+
+        if (outConfig.ShardConfig.ShardCount < 1)
+            throw std::runtime_error("'shardCount' in 'shardConfig' must be at least 1.");
+        if (outConfig.ShardConfig.ShardIndex < 0 || outConfig.ShardConfig.ShardIndex >= outConfig.ShardConfig.ShardCount)
+            throw std::runtime_error("'shardIndex' in 'shardConfig' must be between 0 and shardCount - 1.");
+        if (outConfig.ShardConfig.ShardCount > 1 && !outConfig.DistributedConfig.LeaseDirectory.empty())
+            throw std::runtime_error("'shardConfig' and 'distributedConfig' are alternatives, use only one of them.");
+    }
+
+    ResultMetric ParseResultMetric(const std::string &metricStr)
+    {
+        if (metricStr == "totalProfitLoss")
+            return ResultMetric::TOTAL_PROFIT_LOSS;
+        if (metricStr == "profitFactor")
+            return ResultMetric::PROFIT_FACTOR;
+        if (metricStr == "totalTrades")
+            return ResultMetric::TOTAL_TRADES;
+        if (metricStr == "winRate")
+            return ResultMetric::WIN_RATE;
+        if (metricStr == "maxDrawdown")
+            return ResultMetric::MAX_DRAWDOWN;
+        if (metricStr == "sharpeRatio")
+            return ResultMetric::SHARPE_RATIO;
+        if (metricStr == "sortinoRatio")
+            return ResultMetric::SORTINO_RATIO;
+        if (metricStr == "calmarRatio")
+            return ResultMetric::CALMAR_RATIO;
+        if (metricStr == "expectancy")
+            return ResultMetric::EXPECTANCY;
+        if (metricStr == "ulcerIndex")
+            return ResultMetric::ULCER_INDEX;
+        throw std::runtime_error("Unknown objective metric '" + metricStr + "'.");
+    }
+
+    void ParseAnalysisConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        json analysisParams = root.contains("analysisConfig") ? root["analysisConfig"] : json::object();
+        outConfig.AnalysisConfig.ParetoFronts = analysisParams.value("paretoFronts", 1);
+        outConfig.AnalysisConfig.Objectives.clear();
+
+        json objectives = analysisParams.value("objectives", json::array({{{"metric", "totalProfitLoss"}, {"goal", "max"}},
+                                                                         {{"metric", "maxDrawdown"}, {"goal", "min"}},
+                                                                         {{"metric", "totalTrades"}, {"goal", "max"}}}));
+        if (!objectives.is_array())
+            throw std::runtime_error("'objectives' in 'analysisConfig' must be an array.");
+
+        for (const auto &objective : objectives)
+        {
+            if (!objective.contains("metric"))
+                throw std::runtime_error("An 'objectives' entry in 'analysisConfig' is missing 'metric'.");
+
+            std::string name = objective["metric"].get<std::string>();
+            std::string goal = objective.value("goal", "max");
+            if (goal != "max" && goal != "min")
+                throw std::runtime_error("'goal' of objective '" + name + "' must be 'max' or 'min'.");
+            outConfig.AnalysisConfig.Objectives.push_back({name, ParseResultMetric(name), goal == "max"});
+        }
+
+        if (outConfig.AnalysisConfig.ParetoFronts < 0)
+            throw std::runtime_error("'paretoFronts' in 'analysisConfig' must be 0 (all fronts) or more.");
+
+        json robustnessParams = analysisParams.value("robustness", json::object());
+        std::string metricName = robustnessParams.value("metric", "totalProfitLoss");
+        std::string goal = robustnessParams.value("goal", "max");
+        if (goal != "max" && goal != "min")
+            throw std::runtime_error("'goal' in 'robustness' must be 'max' or 'min'.");
+        outConfig.AnalysisConfig.RobustnessObjective = {metricName, ParseResultMetric(metricName), goal == "max"};
+        outConfig.AnalysisConfig.NeighborhoodRadius = robustnessParams.value("radius", 1);
+        outConfig.AnalysisConfig.PlateauPenalty = robustnessParams.value("penalty", 1.0);
+
+        std::string shapeStr = robustnessParams.value("shape", "manhattan");
+        if (shapeStr == "manhattan")
+            outConfig.AnalysisConfig.Neighborhood = NeighborhoodShape::MANHATTAN;
+        else if (shapeStr == "chebyshev")
+            outConfig.AnalysisConfig.Neighborhood = NeighborhoodShape::CHEBYSHEV;
+        else
+            throw std::runtime_error("'shape' in 'robustness' must be 'manhattan' or 'chebyshev'.");
+
+        if (outConfig.AnalysisConfig.NeighborhoodRadius < 0)
+            throw std::runtime_error("'radius' in 'robustness' must be 0 (disabled) or more.");
+
+        json monteCarloParams = analysisParams.value("monteCarlo", json::object());
+        MonteCarloConfig &monteCarlo = outConfig.AnalysisConfig.MonteCarlo;
+        monteCarlo.TopK = monteCarloParams.value("topK", 10);
+        monteCarlo.Resamples = monteCarloParams.value("resamples", 5000);
+        monteCarlo.RuinCapital = monteCarloParams.value("ruinCapital", 10000.0);
+        monteCarlo.Seed = monteCarloParams.value("seed", 20250101ULL);
+        monteCarlo.Threads = monteCarloParams.value("threads", 0);
+
+        std::string methodStr = monteCarloParams.value("method", "bootstrap");
+        if (methodStr == "bootstrap")
+            monteCarlo.Method = ResampleMethod::BOOTSTRAP;
+        else if (methodStr == "permutation")
+            monteCarlo.Method = ResampleMethod::PERMUTATION;
+        else
+            throw std::runtime_error("'method' in 'monteCarlo' must be 'bootstrap' or 'permutation'.");
+
+        if (monteCarlo.TopK < 0)
+            throw std::runtime_error("'topK' in 'monteCarlo' must be 0 (disabled) or more.");
+        if (monteCarlo.Resamples < 1)
+            throw std::runtime_error("'resamples' in 'monteCarlo' must be at least 1.");
+        if (monteCarlo.RuinCapital <= 0)
+            throw std::runtime_error("'ruinCapital' in 'monteCarlo' must be greater than 0.");
+        if (monteCarlo.Threads < 0)
+            throw std::runtime_error("'threads' in 'monteCarlo' must be 0 (all cores) or more.");
+
+        json statisticsParams = analysisParams.value("statistics", json::object());
+        SweepStatisticsConfig &statistics = outConfig.AnalysisConfig.Statistics;
+        statistics.Enabled = statisticsParams.value("enabled", true);
+        statistics.Resamples = statisticsParams.value("resamples", 1000);
+        statistics.MeanBlockLength = statisticsParams.value("meanBlockLength", 5.0);
+        statistics.CscvBlocks = statisticsParams.value("cscvBlocks", 10);
+        statistics.Seed = statisticsParams.value("seed", 20250101ULL);
+        statistics.Threads = statisticsParams.value("threads", 0);
+
+        if (statistics.Resamples < 1)
+            throw std::runtime_error("'resamples' in 'statistics' must be at least 1.");
+        if (statistics.MeanBlockLength < 1.0)
+            throw std::runtime_error("'meanBlockLength' in 'statistics' must be at least 1.");
+        if (statistics.CscvBlocks < 2 || statistics.CscvBlocks > 16 || statistics.CscvBlocks % 2 != 0)
+            throw std::runtime_error("'cscvBlocks' in 'statistics' must be an even number from 2 to 16.");
+        if (statistics.Threads < 0)
+            throw std::runtime_error("'threads' in 'statistics' must be 0 (all cores) or more.");
+
+        json clusteringParams = analysisParams.value("clustering", json::object());
+        ClusteringConfig &clustering = outConfig.AnalysisConfig.Clustering;
+        clustering.Enabled = clusteringParams.value("enabled", true);
+        clustering.MinCorrelation = clusteringParams.value("minCorrelation", 0.9);
+        clustering.GridPoints = clusteringParams.value("gridPoints", 256);
+        clustering.Threads = clusteringParams.value("threads", 0);
+
+        std::string clusteringMetric = clusteringParams.value("metric", "totalProfitLoss");
+        std::string clusteringGoal = clusteringParams.value("goal", "max");
+        if (clusteringGoal != "max" && clusteringGoal != "min")
+            throw std::runtime_error("'goal' in 'clustering' must be 'max' or 'min'.");
+        clustering.Objective = {clusteringMetric, ParseResultMetric(clusteringMetric), clusteringGoal == "max"};
+
+        if (clustering.MinCorrelation <= -1.0 || clustering.MinCorrelation > 1.0)
+            throw std::runtime_error("'minCorrelation' in 'clustering' must be greater than -1 and at most 1.");
+        if (clustering.GridPoints < 3)
+            throw std::runtime_error("'gridPoints' in 'clustering' must be at least 3.");
+        if (clustering.Threads < 0)
+            throw std::runtime_error("'threads' in 'clustering' must be 0 (all cores) or more.");
+
+        json heatmapParams = analysisParams.value("heatmaps", json::object());
+        HeatmapConfig &heatmaps = outConfig.AnalysisConfig.Heatmaps;
+        heatmaps.Enabled = heatmapParams.value("enabled", true);
+        heatmaps.MetricNames = heatmapParams.value("metrics", std::vector<std::string>{"sharpeRatio", "totalProfitLoss"});
+        heatmaps.Metrics.clear();
+        for (const auto &metricName : heatmaps.MetricNames)
+        {
+            heatmaps.Metrics.push_back(ParseResultMetric(metricName));
+        }
+        if (heatmaps.Enabled && heatmaps.Metrics.empty())
+            throw std::runtime_error("'metrics' in 'heatmaps' must list at least one metric.");
+    }
+
+    void ParseWalkForwardConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        json walkForwardParams = root.contains("walkForwardConfig") ? root["walkForwardConfig"] : json::object();
+        WalkForwardConfig &walkForward = outConfig.WalkForwardConfig;
+        walkForward.Enabled = walkForwardParams.value("enabled", false);
+        walkForward.InSampleDays = walkForwardParams.value("inSampleDays", 60.0);
+        walkForward.OutOfSampleDays = walkForwardParams.value("outOfSampleDays", 20.0);
+        walkForward.StepDays = walkForwardParams.value("stepDays", walkForward.OutOfSampleDays);
+
+        json objectiveParams = walkForwardParams.value("objective", json::object());
+        std::string metricName = objectiveParams.value("metric", "totalProfitLoss");
+        std::string goal = objectiveParams.value("goal", "max");
+        if (goal != "max" && goal != "min")
+            throw std::runtime_error("'goal' in 'walkForwardConfig' must be 'max' or 'min'.");
+        walkForward.Objective = {metricName, ParseResultMetric(metricName), goal == "max"};
+
+        if (!walkForward.Enabled)
+            return;
+
+        if (walkForward.InSampleDays <= 0 || walkForward.OutOfSampleDays <= 0 || walkForward.StepDays <= 0)
+            throw std::runtime_error("'inSampleDays', 'outOfSampleDays' and 'stepDays' in 'walkForwardConfig' must be greater than 0.");
+        if (outConfig.ReplayConfig.EndDateTime.GetAsDouble() == 0.0)
+            throw std::runtime_error("'walkForwardConfig' needs 'endDate' in 'replayConfig' to split the date range into windows.");
+        if (outConfig.ReplayConfig.EndDateTime.GetAsDouble() - outConfig.ReplayConfig.StartDateTime.GetAsDouble() < walkForward.InSampleDays + walkForward.OutOfSampleDays)
+            throw std::runtime_error("The replay date range is shorter than one in-sample and out-of-sample window.");
+
+        // Out-of-sample replays depend on in-sample results that only this machine sees, and a linked batch shares one date range
+        if (outConfig.LaneConfig.LinkedReplay)
+            throw std::runtime_error("'walkForwardConfig' cannot be combined with 'linkedReplay'.");
+        if (!outConfig.DistributedConfig.LeaseDirectory.empty() || outConfig.ShardConfig.ShardCount > 1)
+            throw std::runtime_error("'walkForwardConfig' cannot be combined with 'distributedConfig' or 'shardConfig'.");
+    }
+
+    void ParseSurrogateConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        json surrogateParams = root.contains("surrogateConfig") ? root["surrogateConfig"] : json::object();
+        SurrogateConfig &surrogate = outConfig.SurrogateConfig;
+        surrogate.Enabled = surrogateParams.value("enabled", false);
+        surrogate.WarmUp = surrogateParams.value("warmUp", 100);
+        surrogate.RefitEvery = surrogateParams.value("refitEvery", 100);
+        surrogate.Budget = surrogateParams.value("budget", 0);
+        surrogate.Trees = surrogateParams.value("trees", 100);
+        surrogate.MaxDepth = surrogateParams.value("maxDepth", 12);
+        surrogate.MinLeafSize = surrogateParams.value("minLeafSize", 3);
+        surrogate.Exploration = surrogateParams.value("exploration", 1.0);
+        surrogate.Seed = surrogateParams.value("seed", 20250101ULL);
+        surrogate.Threads = surrogateParams.value("threads", 0);
+
+        json objectiveParams = surrogateParams.value("objective", json::object());
+        std::string metricName = objectiveParams.value("metric", "totalProfitLoss");
+        std::string goal = objectiveParams.value("goal", "max");
+        if (goal != "max" && goal != "min")
+            throw std::runtime_error("'goal' in 'surrogateConfig' must be 'max' or 'min'.");
+        surrogate.Objective = {metricName, ParseResultMetric(metricName), goal == "max"};
+
+        if (!surrogate.Enabled)
+            return;
+
+        if (surrogate.WarmUp < 2 || surrogate.RefitEvery < 1)
+            throw std::runtime_error("'warmUp' in 'surrogateConfig' must be 2 or more and 'refitEvery' 1 or more.");
+        if (surrogate.Budget < 0)
+            throw std::runtime_error("'budget' in 'surrogateConfig' must be 0 (whole grid) or more.");
+        if (surrogate.Trees < 1 || surrogate.MaxDepth < 1 || surrogate.MinLeafSize < 1)
+            throw std::runtime_error("'trees', 'maxDepth' and 'minLeafSize' in 'surrogateConfig' must be 1 or more.");
+        if (surrogate.Exploration < 0.0)
+            throw std::runtime_error("'exploration' in 'surrogateConfig' must be 0 or more.");
+        if (surrogate.Threads < 0)
+            throw std::runtime_error("'threads' in 'surrogateConfig' must be 0 (all cores) or more.");
+
+        // The queue is reordered locally, leased chunks and walk-forward windows have a fixed order
+        if (!outConfig.DistributedConfig.LeaseDirectory.empty())
+            throw std::runtime_error("'surrogateConfig' cannot be combined with 'distributedConfig'.");
+        if (outConfig.WalkForwardConfig.Enabled)
+            throw std::runtime_error("'surrogateConfig' cannot be combined with 'walkForwardConfig'.");
+    }
+
+    void ParseNativeConfig(const json &root, StrategyOptimizerConfig &outConfig, SCStudyInterfaceRef sc)
+    {
+        json nativeParams = root.contains("nativeConfig") ? root["nativeConfig"] : json::object();
+        NativeConfig &native = outConfig.NativeConfig;
+        native.PluginPath = nativeParams.value("pluginPath", "");
+        native.ScidPath = nativeParams.value("scidPath", "");
+        if (native.ScidPath.empty())
+        {
+            std::filesystem::path dataFile(sc.DataFile.GetChars());
+            if (dataFile.is_relative())
+                dataFile = std::filesystem::path(sc.DataFilesFolder().GetChars()) / dataFile;
+            native.ScidPath = dataFile.string();
+        }
+
+        std::string barType = nativeParams.value("barType", "time");
+        if (barType == "time")
+            native.Bars.Type = BarType::Time;
+        else if (barType == "volume")
+            native.Bars.Type = BarType::Volume;
+        else if (barType == "range")
+            native.Bars.Type = BarType::Range;
+        else if (barType == "renko")
+            native.Bars.Type = BarType::Renko;
+        else
+            throw std::runtime_error("'barType' in 'nativeConfig' must be 'time', 'volume', 'range' or 'renko'.");
+        native.Bars.Size = nativeParams.value("barSize", 60.0);
+
+        // Bars are formed like the chart's, so a native run sees the bars the replay saw
+        native.Session.StartSeconds = sc.StartTime1;
+        native.Session.EndSeconds = sc.EndTime1;
+
+        native.Fill.TickSize = nativeParams.value("tickSize", 0.25);
+        native.Fill.PointValue = nativeParams.value("pointValue", 1.0);
+        native.Fill.SlippageTicks = nativeParams.value("slippageTicks", 0.0);
+        native.Fill.CommissionPerContract = nativeParams.value("commissionPerContract", 0.0);
+        native.Fill.QueueVolume = nativeParams.value("queueVolume", 0.0);
+        native.IndicatorCacheMegabytes = nativeParams.value("indicatorCacheMegabytes", 256);
+
+        std::string limitQueue = nativeParams.value("limitQueue", "touch");
+        if (limitQueue == "touch")
+            native.Fill.LimitQueue = QueueModel::TOUCH;
+        else if (limitQueue == "tradeThrough")
+            native.Fill.LimitQueue = QueueModel::TRADE_THROUGH;
+        else if (limitQueue == "queue")
+            native.Fill.LimitQueue = QueueModel::QUEUE;
+        else
+            throw std::runtime_error("'limitQueue' in 'nativeConfig' must be 'touch', 'tradeThrough' or 'queue'.");
+
+        if (!(native.Bars.Size > 0.0))
+            throw std::runtime_error("'barSize' in 'nativeConfig' must be greater than 0.");
+        if (!(native.Fill.TickSize > 0.0) || !(native.Fill.PointValue > 0.0))
+            throw std::runtime_error("'tickSize' and 'pointValue' in 'nativeConfig' must be greater than 0.");
+        if (native.Fill.SlippageTicks < 0.0 || native.Fill.CommissionPerContract < 0.0 || native.Fill.QueueVolume < 0.0)
+            throw std::runtime_error("'slippageTicks', 'commissionPerContract' and 'queueVolume' in 'nativeConfig' must not be negative.");
+        if (native.IndicatorCacheMegabytes < 0)
+            throw std::runtime_error("'indicatorCacheMegabytes' in 'nativeConfig' must not be negative.");
+    }
+
+    void ParseParityConfig(const json &root, StrategyOptimizerConfig &outConfig)
+    {
+        json parityParams = root.contains("parityConfig") ? root["parityConfig"] : json::object();
+        ParityConfig &parity = outConfig.ParityConfig;
+        parity.ReferenceDirectory = parityParams.value("referenceDirectory", "");
+        parity.TimeToleranceSeconds = parityParams.value("timeToleranceSeconds", 1.0);
+        parity.PriceToleranceTicks = parityParams.value("priceToleranceTicks", 0.0);
+        parity.ProfitLossTolerance = parityParams.value("profitLossTolerance", 0.01);
+        parity.MetricTolerance = parityParams.value("metricTolerance", 1e-6);
+        parity.MaxMismatchesPerCombination = parityParams.value("maxMismatchesPerCombination", 10);
+
+        if (parity.ReferenceDirectory.empty())
+            return;
+
+        if (parity.TimeToleranceSeconds < 0.0 || parity.PriceToleranceTicks < 0.0 || parity.ProfitLossTolerance < 0.0 || parity.MetricTolerance < 0.0)
+            throw std::runtime_error("Tolerances in 'parityConfig' must not be negative.");
+        if (parity.MaxMismatchesPerCombination < 1)
+            throw std::runtime_error("'maxMismatchesPerCombination' in 'parityConfig' must be 1 or more.");
+        if (!std::filesystem::is_directory(parity.ReferenceDirectory))
+            throw std::runtime_error("'referenceDirectory' in 'parityConfig' is not a folder: '" + parity.ReferenceDirectory + "'.");
+        if (outConfig.NativeConfig.PluginPath.empty())
+            throw std::runtime_error("'parityConfig' needs the strategy library in 'pluginPath' of 'nativeConfig'.");
+    }
+
+    void ParsePortfolioConfig(const json &root, StrategyOptimizerConfig &outConfig, SCStudyInterfaceRef sc)
+    {
+        json portfolioParams = root.contains("portfolioConfig") ? root["portfolioConfig"] : json::object();
+        PortfolioConfig &portfolio = outConfig.PortfolioConfig;
+        portfolio.Enabled = portfolioParams.value("enabled", false);
+        portfolio.Threads = portfolioParams.value("threads", 0);
+        portfolio.BatchSize = portfolioParams.value("batchSize", 16);
+        portfolio.ScidPaths.clear();
+        if (portfolioParams.contains("scidPaths"))
+        {
+            if (!portfolioParams["scidPaths"].is_array())
+                throw std::runtime_error("'scidPaths' in 'portfolioConfig' must be an array.");
+            for (const auto &scidPath : portfolioParams["scidPaths"])
+            {
+                // Relative to the Data Files Folder, like the chart's own data file
+                std::filesystem::path path(scidPath.get<std::string>());
+                if (path.is_relative())
+                    path = std::filesystem::path(sc.DataFilesFolder().GetChars()) / path;
+                portfolio.ScidPaths.push_back(path.string());
+            }
+        }
+
+        if (!portfolio.Enabled)
+            return;
+
+        if (portfolio.Threads < 0)
+            throw std::runtime_error("'threads' in 'portfolioConfig' must be 0 (all cores) or more.");
+        if (portfolio.BatchSize < 1)
+            throw std::runtime_error("'batchSize' in 'portfolioConfig' must be 1 or more.");
+
+        if (!portfolio.ScidPaths.empty())
+        {
+            if (outConfig.NativeConfig.PluginPath.empty())
+                throw std::runtime_error("'scidPaths' in 'portfolioConfig' needs the strategy library in 'pluginPath' of 'nativeConfig'.");
+            if (!outConfig.LaneConfig.ChartNumbers.empty())
+                throw std::runtime_error("A native portfolio replays no charts, leave 'chartNumbers' in 'laneConfig' empty.");
+        }
+        else
+        {
+            // Every lane chart is one symbol and all of them replay the same combination at once
+            if (!outConfig.LaneConfig.LinkedReplay || outConfig.LaneConfig.ChartNumbers.empty())
+                throw std::runtime_error("A chart portfolio needs the symbol charts in 'chartNumbers' of 'laneConfig' with 'linkedReplay' on, or .scid files in 'scidPaths'.");
+        }
+
+        // Each combination is one portfolio, the work items of these modes are not
+        if (!outConfig.DistributedConfig.LeaseDirectory.empty())
+            throw std::runtime_error("'portfolioConfig' cannot be combined with 'distributedConfig'.");
+        if (outConfig.WalkForwardConfig.Enabled)
+            throw std::runtime_error("'portfolioConfig' cannot be combined with 'walkForwardConfig'.");
+        if (outConfig.SurrogateConfig.Enabled)
+            throw std::runtime_error("'portfolioConfig' cannot be combined with 'surrogateConfig'.");
+    }
+
     void ParseParamConfigs(const json &root, StrategyOptimizerConfig &outConfig)
     {
         if (!root.contains("paramConfigs"))
@@ -162,6 +623,11 @@ namespace ConfigLoader
             OnChartLogging::AddLog(sc, "INFO: Replay Config Loaded:");
             logMessage.Format("INFO:   - StartDateTime: %s", sc.DateTimeToString(outConfig.ReplayConfig.StartDateTime, FLAG_DT_COMPLETE_DATETIME_MS).GetChars());
             OnChartLogging::AddLog(sc, logMessage);
+            if (outConfig.ReplayConfig.EndDateTime.GetAsDouble() != 0.0)
+            {
+                logMessage.Format("INFO:   - EndDateTime: %s", sc.DateTimeToString(outConfig.ReplayConfig.EndDateTime, FLAG_DT_COMPLETE_DATETIME_MS).GetChars());
+                OnChartLogging::AddLog(sc, logMessage);
+            }
             logMessage.Format("INFO:   - Replay Speed: %.1f", outConfig.ReplayConfig.ReplaySpeed);
             OnChartLogging::AddLog(sc, logMessage);
 
@@ -174,6 +640,103 @@ namespace ConfigLoader
             logMessage.Format("INFO:   - Max Log Lines: %d", outConfig.LogConfig.MaxLogLines);
             OnChartLogging::AddLog(sc, logMessage);
 
+            ParseWatchdogConfig(root, outConfig);
+            OnChartLogging::AddLog(sc, "INFO: Watchdog Config Loaded:");
+            logMessage.Format("INFO:   - Start Timeout: %d s", outConfig.WatchdogConfig.StartTimeoutSeconds);
+            OnChartLogging::AddLog(sc, logMessage);
+            logMessage.Format("INFO:   - Run Timeout: %d s", outConfig.WatchdogConfig.RunTimeoutSeconds);
+            OnChartLogging::AddLog(sc, logMessage);
+            logMessage.Format("INFO:   - Max Retries: %d", outConfig.WatchdogConfig.MaxRetries);
+            OnChartLogging::AddLog(sc, logMessage);
+
+            ParseLaneConfig(root, outConfig);
+            logMessage.Format("INFO: Lane Config Loaded: %d additional lane chart(s), linked replay %s.", (int)outConfig.LaneConfig.ChartNumbers.size(), outConfig.LaneConfig.LinkedReplay ? "on" : "off");
+            OnChartLogging::AddLog(sc, logMessage);
+
+            ParseDistributedConfig(root, outConfig);
+            if (!outConfig.DistributedConfig.LeaseDirectory.empty())
+            {
+                logMessage.Format("INFO: Distributed Config Loaded: lease directory '%s', chunk size %d.", outConfig.DistributedConfig.LeaseDirectory.c_str(), outConfig.DistributedConfig.ChunkSize);
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParseShardConfig(root, filePath, outConfig);
+            if (outConfig.ShardConfig.ShardCount > 1)
+            {
+                logMessage.Format("INFO: Shard Config Loaded: shard %d of %d (%s), run '%s'.", outConfig.ShardConfig.ShardIndex, outConfig.ShardConfig.ShardCount, outConfig.ShardConfig.Mode == ShardMode::STRIDED ? "strided" : "blocked", outConfig.ShardConfig.RunName.c_str());
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParseAnalysisConfig(root, outConfig);
+            if (!outConfig.AnalysisConfig.Objectives.empty())
+            {
+                logMessage.Format("INFO: Analysis Config Loaded: %d Pareto objectives, %d fronts.", (int)outConfig.AnalysisConfig.Objectives.size(), outConfig.AnalysisConfig.ParetoFronts);
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+            if (outConfig.AnalysisConfig.NeighborhoodRadius > 0)
+            {
+                logMessage.Format("INFO: Robustness Config Loaded: %s (%s), radius %d.", outConfig.AnalysisConfig.RobustnessObjective.Name.c_str(), outConfig.AnalysisConfig.RobustnessObjective.Maximize ? "max" : "min", outConfig.AnalysisConfig.NeighborhoodRadius);
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+            if (outConfig.AnalysisConfig.MonteCarlo.TopK > 0)
+            {
+                logMessage.Format("INFO: Monte Carlo Config Loaded: top %d combinations, %d %s resamples.", outConfig.AnalysisConfig.MonteCarlo.TopK, outConfig.AnalysisConfig.MonteCarlo.Resamples, outConfig.AnalysisConfig.MonteCarlo.Method == ResampleMethod::BOOTSTRAP ? "bootstrap" : "permutation");
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+            if (outConfig.AnalysisConfig.Statistics.Enabled)
+            {
+                logMessage.Format("INFO: Sweep Statistics Config Loaded: %d bootstrap resamples, %d CSCV blocks.", outConfig.AnalysisConfig.Statistics.Resamples, outConfig.AnalysisConfig.Statistics.CscvBlocks);
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+            if (outConfig.AnalysisConfig.Clustering.Enabled)
+            {
+                logMessage.Format("INFO: Clustering Config Loaded: correlation %.2f or more, %d grid points, best by %s (%s).", outConfig.AnalysisConfig.Clustering.MinCorrelation, outConfig.AnalysisConfig.Clustering.GridPoints, outConfig.AnalysisConfig.Clustering.Objective.Name.c_str(), outConfig.AnalysisConfig.Clustering.Objective.Maximize ? "max" : "min");
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+            if (outConfig.AnalysisConfig.Heatmaps.Enabled)
+            {
+                logMessage.Format("INFO: Heatmap Config Loaded: %d metrics.", (int)outConfig.AnalysisConfig.Heatmaps.Metrics.size());
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParseWalkForwardConfig(root, outConfig);
+            if (outConfig.WalkForwardConfig.Enabled)
+            {
+                logMessage.Format("INFO: Walk-Forward Config Loaded: %.1f in-sample days, %.1f out-of-sample days, step %.1f days, %s (%s).", outConfig.WalkForwardConfig.InSampleDays, outConfig.WalkForwardConfig.OutOfSampleDays, outConfig.WalkForwardConfig.StepDays, outConfig.WalkForwardConfig.Objective.Name.c_str(), outConfig.WalkForwardConfig.Objective.Maximize ? "max" : "min");
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParseSurrogateConfig(root, outConfig);
+            if (outConfig.SurrogateConfig.Enabled)
+            {
+                logMessage.Format("INFO: Surrogate Config Loaded: %d trees, warm-up %d, refit every %d, budget %d, %s (%s).", outConfig.SurrogateConfig.Trees, outConfig.SurrogateConfig.WarmUp, outConfig.SurrogateConfig.RefitEvery, outConfig.SurrogateConfig.Budget, outConfig.SurrogateConfig.Objective.Name.c_str(), outConfig.SurrogateConfig.Objective.Maximize ? "max" : "min");
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParseNativeConfig(root, outConfig, sc);
+            if (!outConfig.NativeConfig.PluginPath.empty())
+            {
+                logMessage.Format("INFO: Native Config Loaded: '%s' on '%s', %s bars.", outConfig.NativeConfig.PluginPath.c_str(), outConfig.NativeConfig.ScidPath.c_str(), outConfig.NativeConfig.Bars.GetKey().c_str());
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParseParityConfig(root, outConfig);
+            if (!outConfig.ParityConfig.ReferenceDirectory.empty())
+            {
+                logMessage.Format("INFO: Parity Config Loaded: reference folder '%s', time tolerance %.3f s, price tolerance %.1f ticks.", outConfig.ParityConfig.ReferenceDirectory.c_str(), outConfig.ParityConfig.TimeToleranceSeconds, outConfig.ParityConfig.PriceToleranceTicks);
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
+            ParsePortfolioConfig(root, outConfig, sc);
+            if (outConfig.PortfolioConfig.Enabled)
+            {
+                if (outConfig.PortfolioConfig.ScidPaths.empty())
+                    logMessage.Format("INFO: Portfolio Config Loaded: %d symbol charts replayed together.", (int)outConfig.LaneConfig.ChartNumbers.size() + 1);
+                else
+                    logMessage.Format("INFO: Portfolio Config Loaded: %d .scid files in the native engine, %d combinations per batch.", (int)outConfig.PortfolioConfig.ScidPaths.size(), outConfig.PortfolioConfig.BatchSize);
+                OnChartLogging::AddLog(sc, logMessage);
+            }
+
             ParseParamConfigs(root, outConfig);
             logMessage.Format("INFO: Loaded %d parameter configurations for optimization.", (int)outConfig.ParamConfigs.size());
             OnChartLogging::AddLog(sc, logMessage);
@@ -4,6 +4,8 @@
 #pragma once
 #include "../sierrachart.h"
 #include "nlohmann/json.hpp"
+#include "BarAggregator.hpp"
+#include "FillSimulator.hpp"
 #include <string>
 #include <vector>
 
@@ -14,6 +16,38 @@ enum class InputType
     BOOL
 };
 
+enum class ShardMode
+{
+    STRIDED,
+    BLOCKED
+};
+
+enum class NeighborhoodShape
+{
+    MANHATTAN,
+    CHEBYSHEV
+};
+
+enum class ResampleMethod
+{
+    BOOTSTRAP,
+    PERMUTATION
+};
+
+enum class ResultMetric
+{
+    TOTAL_PROFIT_LOSS,
+    PROFIT_FACTOR,
+    TOTAL_TRADES,
+    WIN_RATE,
+    MAX_DRAWDOWN,
+    SHARPE_RATIO,
+    SORTINO_RATIO,
+    CALMAR_RATIO,
+    EXPECTANCY,
+    ULCER_INDEX
+};
+
 struct InputConfig
 {
     int Index;
@@ -29,12 +63,154 @@ struct ReplayConfig
     SCString StartDate;
     SCString StartTime;
     SCDateTimeMS StartDateTime;
+    SCDateTimeMS EndDateTime; // Zero when the replay runs to the end of the data
     int ReplayMode;
     int ChartsToReplay;
     int ClearExistingTradeSimulationDataForSymbolAndTradeAccount;
     int SkipEmptyPeriods;
 };
 
+struct WatchdogConfig
+{
+    int StartTimeoutSeconds;
+    int RunTimeoutSeconds;
+    int MaxRetries;
+};
+
+struct LaneConfig
+{
+    std::vector<int> ChartNumbers;
+    bool LinkedReplay;
+};
+
+struct DistributedConfig
+{
+    std::string LeaseDirectory;
+    std::string WorkerId;
+    int ChunkSize;
+    int LeaseTimeoutSeconds;
+    int HeartbeatSeconds;
+};
+
+struct ShardConfig
+{
+    int ShardIndex;
+    int ShardCount;
+    ShardMode Mode;
+    std::string RunName;
+};
+
+struct ObjectiveConfig
+{
+    std::string Name;
+    ResultMetric Metric;
+    bool Maximize;
+};
+
+struct MonteCarloConfig
+{
+    int TopK;
+    int Resamples;
+    ResampleMethod Method;
+    double RuinCapital;
+    unsigned long long Seed;
+    int Threads;
+};
+
+struct SweepStatisticsConfig
+{
+    bool Enabled;
+    int Resamples;
+    double MeanBlockLength;
+    int CscvBlocks;
+    unsigned long long Seed;
+    int Threads;
+};
+
+struct ClusteringConfig
+{
+    bool Enabled;
+    double MinCorrelation;
+    int GridPoints;
+    ObjectiveConfig Objective;
+    int Threads;
+};
+
+struct HeatmapConfig
+{
+    bool Enabled;
+    std::vector<std::string> MetricNames;
+    std::vector<ResultMetric> Metrics;
+};
+
+struct AnalysisConfig
+{
+    std::vector<ObjectiveConfig> Objectives;
+    int ParetoFronts;
+    ObjectiveConfig RobustnessObjective;
+    int NeighborhoodRadius;
+    NeighborhoodShape Neighborhood;
+    double PlateauPenalty;
+    MonteCarloConfig MonteCarlo;
+    SweepStatisticsConfig Statistics;
+    ClusteringConfig Clustering;
+    HeatmapConfig Heatmaps;
+};
+
+struct WalkForwardConfig
+{
+    bool Enabled;
+    double InSampleDays;
+    double OutOfSampleDays;
+    double StepDays;
+    ObjectiveConfig Objective;
+};
+
+struct SurrogateConfig
+{
+    bool Enabled;
+    int WarmUp;
+    int RefitEvery;
+    int Budget; // Most replays of the sweep, 0 replays the whole grid in model order
+    int Trees;
+    int MaxDepth;
+    int MinLeafSize;
+    double Exploration;
+    ObjectiveConfig Objective;
+    unsigned long long Seed;
+    int Threads;
+};
+
+// Evaluation of a strategy plug-in on the bars of a .scid file, without a chart
+struct NativeConfig
+{
+    std::string PluginPath; // Empty when the strategy has no native build
+    std::string ScidPath;   // The chart's data file when not set
+    BarSpec Bars;
+    SessionTimes Session; // The chart's session
+    FillConfig Fill;
+    int IndicatorCacheMegabytes; // Indicator series kept for plug-ins per data file
+};
+
+struct ParityConfig
+{
+    std::string ReferenceDirectory; // Results folder of replays to compare against, empty to run a normal sweep
+    double TimeToleranceSeconds;
+    double PriceToleranceTicks;
+    double ProfitLossTolerance;
+    double MetricTolerance; // Relative, for the performance metrics
+    int MaxMismatchesPerCombination;
+};
+
+// One parameter set evaluated on several symbols and ranked by the merged portfolio
+struct PortfolioConfig
+{
+    bool Enabled;
+    std::vector<std::string> ScidPaths; // Native symbols, empty to replay the lane charts as the symbols
+    int Threads;
+    int BatchSize; // Native combinations evaluated per call of the study
+};
+
 struct LogConfig
 {
     bool EnableLog;
@@ -48,6 +224,16 @@ struct StrategyOptimizerConfig
     ReplayConfig ReplayConfig;
     std::vector<InputConfig> ParamConfigs;
     LogConfig LogConfig;
+    WatchdogConfig WatchdogConfig;
+    LaneConfig LaneConfig;
+    DistributedConfig DistributedConfig;
+    ShardConfig ShardConfig;
+    AnalysisConfig AnalysisConfig;
+    WalkForwardConfig WalkForwardConfig;
+    SurrogateConfig SurrogateConfig;
+    NativeConfig NativeConfig;
+    ParityConfig ParityConfig;
+    PortfolioConfig PortfolioConfig;
 };
 
 namespace ConfigLoader
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Sparse index of a series of date times in ascending order: the date time of every STRIDE-th entry. A seek is a
+// binary search of the index followed by one of a single block, so it only touches the memory of that block.
+// dateTimeAt(i) returns entry i of the full series.
+namespace DateTimeIndex
+{
+    const size_t STRIDE = 4096;
+
+    // Adds the entries of a series that grew to count
+    template <typename DateTimeAt>
+    void Extend(std::vector<SCDateTimeMS> &index, size_t count, DateTimeAt dateTimeAt)
+    {
+        for (size_t i = index.size() * STRIDE; i < count; i += STRIDE)
+        {
+            index.push_back(dateTimeAt(i));
+        }
+    }
+
+    // Position of the first entry at or after dateTime, count when there is none
+    template <typename DateTimeAt>
+    size_t LowerBound(const std::vector<SCDateTimeMS> &index, size_t count, const SCDateTimeMS &dateTime, DateTimeAt dateTimeAt)
+    {
+        // The first index entry at or after the date time bounds the block the answer is in
+        size_t entry = std::lower_bound(index.begin(), index.end(), dateTime,
+                                        [](const SCDateTimeMS &indexed, const SCDateTimeMS &value)
+                                        { return indexed < value; }) -
+                       index.begin();
+        size_t first = entry == 0 ? 0 : (entry - 1) * STRIDE;
+        size_t last = (std::min)(entry * STRIDE, count);
+        while (first < last)
+        {
+            size_t middle = first + (last - first) / 2;
+            if (dateTimeAt(middle) < dateTime)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        return first;
+    }
+}
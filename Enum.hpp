@@ -6,6 +6,7 @@
 enum class ReplayState
 {
     Idle,
+    ReadyForReplay,
     WaitingForReplayToStart,
     ReplayInProgress
 };
@@ -14,8 +15,6 @@ namespace PersistentVars
 {
     enum
     {
-        ReplayStateEnum,
-        ComboIndex,
         LogDrawingLineNumber, // For GetPersistentInt
         BacktestStartDateTime,
         BacktestConfigPtr, // For GetPersistentPointer
@@ -25,6 +24,8 @@ namespace PersistentVars
         EnableLog,
         EnableShowLogOnChart,
         MaxLogLines,
+        SweepRunPtr,       // For GetPersistentPointer
+        JobQueuePtr,       // For GetPersistentPointer
     };
 }
 
@@ -37,7 +38,8 @@ namespace StudyInputs
         ResetButtonNumber,
         VerifyConfigButtonNumber,
         ConfigFilePath,
-        TargetStudyRef
+        TargetStudyRef,
+        JobQueueFilePath
     };
 }
 
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "EquityClustering.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+
+namespace
+{
+    // Each thread takes a band of 64 curves against every later band. Within a band pair, blocks of 4 x 8 dot
+    // products stay in registers, so each grid point of a curve is loaded once per block instead of once per pair.
+    const int CURVE_TILE = 64;
+    const int BLOCK_ROWS = 4;
+    const int BLOCK_COLUMNS = 8;
+
+    int FindRoot(std::vector<int> &parents, int i)
+    {
+        while (parents[i] != i)
+        {
+            parents[i] = parents[parents[i]];
+            i = parents[i];
+        }
+        return i;
+    }
+
+    void Union(std::vector<int> &parents, int a, int b)
+    {
+        a = FindRoot(parents, a);
+        b = FindRoot(parents, b);
+        if (a != b)
+        {
+            // The smaller index stays the root, so the result does not depend on the order of the unions
+            parents[(std::max)(a, b)] = (std::min)(a, b);
+        }
+    }
+
+    std::vector<int> GetGrid(const std::vector<std::vector<std::pair<int, double>>> &dailyProfitLoss, int gridPoints)
+    {
+        std::vector<int> calendar;
+        for (const auto &curve : dailyProfitLoss)
+        {
+            for (const auto &day : curve)
+            {
+                calendar.push_back(day.first);
+            }
+        }
+        std::sort(calendar.begin(), calendar.end());
+        calendar.erase(std::unique(calendar.begin(), calendar.end()), calendar.end());
+        if ((int)calendar.size() <= gridPoints)
+        {
+            return calendar;
+        }
+
+        // Evenly spaced trading days, always keeping the first and the last
+        std::vector<int> grid(gridPoints);
+        for (int g = 0; g < gridPoints; ++g)
+        {
+            grid[g] = calendar[(size_t)((double)g * (calendar.size() - 1) / (gridPoints - 1) + 0.5)];
+        }
+        return grid;
+    }
+}
+
+namespace EquityClustering
+{
+    EquityClusters Compute(const std::vector<std::vector<std::pair<int, double>>> &dailyProfitLoss, const ClusteringConfig &config)
+    {
+        EquityClusters clusters;
+        int curves = (int)dailyProfitLoss.size();
+        std::vector<int> grid = GetGrid(dailyProfitLoss, config.GridPoints);
+        int points = (int)grid.size();
+        clusters.GridPoints = points;
+
+        // Centred, unit length cumulative curves, so a correlation is a dot product. Each band of 64 curves is
+        // stored point-major on its own, padded with zero curves, so a band is read front to back.
+        int tiles = (curves + CURVE_TILE - 1) / CURVE_TILE;
+        std::vector<float> bands((size_t)tiles * points * CURVE_TILE, 0.0f);
+        std::vector<double> curve(points);
+        for (int c = 0; c < curves; ++c)
+        {
+            const auto &days = dailyProfitLoss[c];
+            double equity = 0.0;
+            size_t next = 0;
+            for (int g = 0; g < points; ++g)
+            {
+                // Days are sorted, the curve carries its last value over days without trades
+                while (next < days.size() && days[next].first <= grid[g])
+                {
+                    equity += days[next++].second;
+                }
+                curve[g] = equity;
+            }
+
+            double mean = std::accumulate(curve.begin(), curve.end(), 0.0) / (std::max)(points, 1);
+            double squares = 0.0;
+            for (double value : curve)
+            {
+                squares += (value - mean) * (value - mean);
+            }
+
+            // A flat curve correlates with nothing and stays on its own
+            double scale = squares > 0.0 ? 1.0 / std::sqrt(squares) : 0.0;
+            for (int g = 0; g < points; ++g)
+            {
+                bands[((size_t)(c / CURVE_TILE) * points + g) * CURVE_TILE + c % CURVE_TILE] = (float)((curve[g] - mean) * scale);
+            }
+        }
+
+        std::vector<int> parents(curves);
+        std::iota(parents.begin(), parents.end(), 0);
+        std::mutex parentsMutex;
+
+        int threadCount = Parallel::GetThreadCount(config.Threads);
+        float minCorrelation = (float)config.MinCorrelation;
+        Parallel::ForEach(threadCount, tiles, [&](int thread, int rowTile)
+                          {
+                              std::vector<std::pair<int, int>> pairs;
+
+                              // Upper triangle only, column tiles from the diagonal onwards
+                              for (int columnTile = rowTile; columnTile < tiles; ++columnTile)
+                              {
+                                  const float *rowBand = &bands[(size_t)rowTile * points * CURVE_TILE];
+                                  const float *columnBand = &bands[(size_t)columnTile * points * CURVE_TILE];
+                                  for (int i0 = 0; i0 < CURVE_TILE; i0 += BLOCK_ROWS)
+                                  {
+                                      for (int j0 = 0; j0 < CURVE_TILE; j0 += BLOCK_COLUMNS)
+                                      {
+                                          if (columnTile == rowTile && j0 + BLOCK_COLUMNS <= i0)
+                                              continue;
+
+                                          // A block of dot products held in registers while the grid points stream past
+                                          float dots[BLOCK_ROWS][BLOCK_COLUMNS] = {};
+                                          for (int g = 0; g < points; ++g)
+                                          {
+                                              const float *rowPoint = rowBand + (size_t)g * CURVE_TILE + i0;
+                                              const float *columnPoint = columnBand + (size_t)g * CURVE_TILE + j0;
+                                              for (int r = 0; r < BLOCK_ROWS; ++r)
+                                              {
+                                                  for (int j = 0; j < BLOCK_COLUMNS; ++j)
+                                                  {
+                                                      dots[r][j] += rowPoint[r] * columnPoint[j];
+                                                  }
+                                              }
+                                          }
+
+                                          for (int r = 0; r < BLOCK_ROWS; ++r)
+                                          {
+                                              for (int j = 0; j < BLOCK_COLUMNS; ++j)
+                                              {
+                                                  int a = rowTile * CURVE_TILE + i0 + r;
+                                                  int b = columnTile * CURVE_TILE + j0 + j;
+                                                  if (a < b && b < curves && dots[r][j] >= minCorrelation)
+                                                  {
+                                                      pairs.push_back({a, b});
+                                                  }
+                                              }
+                                          }
+                                      }
+                                  }
+
+                                  if (!pairs.empty())
+                                  {
+                                      std::lock_guard<std::mutex> lock(parentsMutex);
+                                      for (const auto &pair : pairs)
+                                      {
+                                          Union(parents, pair.first, pair.second);
+                                      }
+                                      pairs.clear();
+                                  }
+                              } });
+
+        clusters.Labels.assign(curves, -1);
+        for (int c = 0; c < curves; ++c)
+        {
+            int root = FindRoot(parents, c);
+            if (clusters.Labels[root] < 0)
+            {
+                clusters.Labels[root] = clusters.ClusterCount++;
+            }
+            clusters.Labels[c] = clusters.Labels[root];
+        }
+        return clusters;
+    }
+}
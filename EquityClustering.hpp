@@ -0,0 +1,24 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include <vector>
+#include <utility>
+
+struct EquityClusters
+{
+    std::vector<int> Labels; // Cluster of each curve, numbered by first member
+    int ClusterCount = 0;
+    int GridPoints = 0;
+};
+
+// Groups combinations whose cumulative P/L curves move together, so near-clones can be told apart from distinct strategies.
+// Curves are sampled on a common calendar and compared by Pearson correlation. Clusters are the single linkage
+// dendrogram cut at minCorrelation, which are the connected components of the pairs at or above it. The pairs are
+// computed tile by tile and folded into a union-find straight away, so the n x n matrix never exists.
+namespace EquityClustering
+{
+    // One entry per combination with its (day, P/L) pairs
+    EquityClusters Compute(const std::vector<std::vector<std::pair<int, double>>> &dailyProfitLoss, const ClusteringConfig &config);
+}
@@ -0,0 +1,252 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "FillSimulator.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    // Open values Sierra Chart writes into a record that holds a single trade, see BarAggregator
+    const float SINGLE_TRADE_WITH_BID_ASK = 0.0f;
+    const float SUB_TRADE_MARKER_LIMIT = -1.0e37f;
+}
+
+FillSimulator::FillSimulator(const FillConfig &config)
+    : config(config)
+{
+    Reset();
+}
+
+void FillSimulator::Reset()
+{
+    workingOrderCount = 0;
+    positionQuantity = 0;
+    maxOpenQuantity = 0;
+    averagePrice = 0.0;
+    closedProfitLoss = 0.0;
+    positionOpenDateTime = SCDateTimeMS();
+    maxOpenProfit = 0.0;
+    maxOpenLoss = 0.0;
+    trades.clear();
+}
+
+void FillSimulator::TakeTrades(std::vector<s_ACSTrade> &out)
+{
+    out.swap(trades);
+    trades.clear();
+}
+
+bool FillSimulator::Submit(const SoOrderRequest &request)
+{
+    WorkingOrder order = {};
+    switch (request.Action)
+    {
+    case SO_ACTION_CANCEL_ALL:
+        CancelAll();
+        return true;
+    case SO_ACTION_FLATTEN:
+        CancelAll();
+        order.OrderType = SO_ORDER_MARKET;
+        order.Flatten = true;
+        break;
+    case SO_ACTION_BUY:
+    case SO_ACTION_SELL:
+        if (request.Quantity <= 0 || request.OrderType < SO_ORDER_MARKET || request.OrderType > SO_ORDER_STOP ||
+            (request.OrderType != SO_ORDER_MARKET && !(request.Price > 0.0)))
+            return false;
+        order.Side = request.Action == SO_ACTION_BUY ? 1 : -1;
+        order.OrderType = request.OrderType;
+        order.Quantity = request.Quantity;
+        order.Price = request.Price;
+        order.QueueAhead = config.QueueVolume;
+        break;
+    default:
+        return false;
+    }
+
+    if (workingOrderCount == MAX_WORKING_ORDERS)
+        return false;
+    workingOrders[workingOrderCount++] = order;
+    return true;
+}
+
+void FillSimulator::Process(const ColumnarCache &ticks, size_t first, size_t last)
+{
+    if (first >= last || (workingOrderCount == 0 && positionQuantity == 0))
+        return;
+
+    const SCDateTimeMS *dateTimes = ticks.GetDateTimes().Data;
+    const float *open = ticks.GetOpen().Data;
+    const float *high = ticks.GetHigh().Data;
+    const float *low = ticks.GetLow().Data;
+    const float *close = ticks.GetClose().Data;
+    const uint32_t *volume = ticks.GetTotalVolume().Data;
+
+    // Without working orders the position cannot change, only its extremes over the range matter
+    if (workingOrderCount == 0)
+    {
+        float lowest = *std::min_element(close + first, close + last);
+        float highest = *std::max_element(close + first, close + last);
+        double best = positionQuantity > 0 ? highest : lowest;
+        double worst = positionQuantity > 0 ? lowest : highest;
+        maxOpenProfit = (std::max)(maxOpenProfit, (best - averagePrice) * positionQuantity * config.PointValue);
+        maxOpenLoss = (std::min)(maxOpenLoss, (worst - averagePrice) * positionQuantity * config.PointValue);
+        return;
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+        bool singleTrade = open[i] == SINGLE_TRADE_WITH_BID_ASK || open[i] < SUB_TRADE_MARKER_LIMIT;
+        double price = close[i];
+        double bid = singleTrade && low[i] > 0.0f ? low[i] : price;
+        double ask = singleTrade && high[i] > 0.0f ? high[i] : price;
+        double tickHigh = singleTrade ? price : high[i];
+        double tickLow = singleTrade ? price : low[i];
+
+        // In submission order, so an earlier order fills first on the same tick
+        for (int o = 0; o < workingOrderCount;)
+        {
+            // A flatten takes its side from the position it finds
+            if (workingOrders[o].Flatten)
+                workingOrders[o].Side = positionQuantity > 0 ? -1 : 1;
+
+            double fillPrice;
+            if (!TryFill(workingOrders[o], bid, ask, tickHigh, tickLow, volume[i], fillPrice))
+            {
+                ++o;
+                continue;
+            }
+
+            WorkingOrder filled = workingOrders[o];
+            std::copy(workingOrders + o + 1, workingOrders + workingOrderCount, workingOrders + o);
+            --workingOrderCount;
+            if (filled.Flatten)
+                filled.Quantity = std::abs(positionQuantity);
+            if (filled.Quantity > 0)
+                ApplyFill(filled.Side, filled.Quantity, fillPrice, dateTimes[i]);
+        }
+
+        if (positionQuantity != 0)
+        {
+            double openProfitLoss = (price - averagePrice) * positionQuantity * config.PointValue;
+            maxOpenProfit = (std::max)(maxOpenProfit, openProfitLoss);
+            maxOpenLoss = (std::min)(maxOpenLoss, openProfitLoss);
+        }
+    }
+}
+
+bool FillSimulator::TryFill(WorkingOrder &order, double bid, double ask, double high, double low, double volume, double &fillPrice)
+{
+    bool buy = order.Side > 0;
+    bool placed = order.Placed;
+    order.Placed = true;
+
+    // Prices are compared to a thousandth of a tick, the columns hold them as float
+    double tolerance = config.TickSize * 1e-3;
+    double slippage = config.SlippageTicks * config.TickSize;
+    switch (order.OrderType)
+    {
+    case SO_ORDER_MARKET:
+        fillPrice = buy ? ask + slippage : bid - slippage;
+        return true;
+    case SO_ORDER_STOP:
+        if (buy ? high < order.Price - tolerance : low > order.Price + tolerance)
+            return false;
+        fillPrice = buy ? (std::max)(order.Price, ask) + slippage : (std::min)(order.Price, bid) - slippage;
+        return true;
+    case SO_ORDER_LIMIT:
+    {
+        // A limit already through the market takes the quote it arrives at
+        if (!placed && (buy ? ask <= order.Price + tolerance : bid >= order.Price - tolerance))
+        {
+            fillPrice = buy ? ask : bid;
+            return true;
+        }
+
+        bool tradedThrough = buy ? low < order.Price - tolerance : high > order.Price + tolerance;
+        bool tradedAt = buy ? low <= order.Price + tolerance : high >= order.Price - tolerance;
+        bool filled = false;
+        switch (config.LimitQueue)
+        {
+        case QueueModel::TOUCH:
+            filled = tradedAt;
+            break;
+        case QueueModel::TRADE_THROUGH:
+            filled = tradedThrough;
+            break;
+        case QueueModel::QUEUE:
+            if (tradedAt && !tradedThrough)
+                order.QueueAhead -= volume;
+            filled = tradedThrough || order.QueueAhead < 0.0;
+            break;
+        }
+        fillPrice = order.Price;
+        return filled;
+    }
+    }
+    return false;
+}
+
+void FillSimulator::ApplyFill(int side, int quantity, double price, const SCDateTimeMS &dateTime)
+{
+    // An opposite fill closes first, whatever is left opens the other way at the same price
+    if (positionQuantity != 0 && (positionQuantity > 0) != (side > 0))
+    {
+        int closing = (std::min)(quantity, std::abs(positionQuantity));
+        CloseQuantity(closing, price, dateTime);
+        quantity -= closing;
+    }
+    if (quantity == 0)
+        return;
+
+    if (positionQuantity == 0)
+    {
+        positionOpenDateTime = dateTime;
+        averagePrice = price;
+        maxOpenQuantity = 0;
+        maxOpenProfit = 0.0;
+        maxOpenLoss = 0.0;
+    }
+    else
+    {
+        int openQuantity = std::abs(positionQuantity);
+        averagePrice = (averagePrice * openQuantity + price * quantity) / (openQuantity + quantity);
+    }
+    positionQuantity += side * quantity;
+    maxOpenQuantity = (std::max)(maxOpenQuantity, std::abs(positionQuantity));
+}
+
+void FillSimulator::CloseQuantity(int quantity, double price, const SCDateTimeMS &dateTime)
+{
+    int direction = positionQuantity > 0 ? 1 : -1;
+    double share = (double)quantity / std::abs(positionQuantity);
+
+    s_ACSTrade trade;
+    trade.OpenDateTime = positionOpenDateTime;
+    trade.CloseDateTime = dateTime;
+    trade.TradeType = direction;
+    trade.TradeQuantity = quantity;
+    trade.MaxClosedQuantity = quantity;
+    trade.MaxOpenQuantity = maxOpenQuantity;
+    trade.EntryPrice = averagePrice;
+    trade.ExitPrice = price;
+    trade.TradeProfitLoss = (price - averagePrice) * direction * quantity * config.PointValue;
+    trade.MaximumOpenPositionLoss = maxOpenLoss * share;
+    trade.MaximumOpenPositionProfit = maxOpenProfit * share;
+    trade.FlatToFlatMaximumOpenPositionProfit = maxOpenProfit;
+    trade.FlatToFlatMaximumOpenPositionLoss = maxOpenLoss;
+    trade.Commission = 2.0 * quantity * config.CommissionPerContract;
+    trade.IsTradeClosed = 1;
+    trades.push_back(trade);
+
+    closedProfitLoss += trade.TradeProfitLoss;
+    positionQuantity -= direction * quantity;
+    if (positionQuantity == 0)
+        averagePrice = 0.0;
+}
+
+void FillSimulator::CancelAll()
+{
+    workingOrderCount = 0;
+}
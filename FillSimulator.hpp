@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "ColumnarCache.hpp"
+#include "StrategyPluginAbi.h"
+#include <cstddef>
+#include <vector>
+
+// When a resting limit order fills once the market trades at its price
+enum class QueueModel
+{
+    TOUCH,         // On the first trade at the limit price
+    TRADE_THROUGH, // Only on a trade beyond the limit price
+    QUEUE          // After QueueVolume contracts traded at the limit price since the order was placed, or on a trade beyond it
+};
+
+struct FillConfig
+{
+    double TickSize = 0.25;
+    double PointValue = 1.0;            // Currency per 1.0 of price per contract
+    double SlippageTicks = 0.0;         // Against market and stop fills
+    double CommissionPerContract = 0.0; // Per contract on every fill, entry and exit
+    QueueModel LimitQueue = QueueModel::TOUCH;
+    double QueueVolume = 0.0; // Contracts ahead of a new limit order for QueueModel::QUEUE
+};
+
+// Fills order requests against the tick records of a .scid file the way Sierra Chart trade simulation does:
+// market orders at the ask or bid, stops when traded through, limits by the queue model. Positions net FIFO into
+// one average price, and every reduction of a position emits one closed trade in the s_ACSTrade layout.
+//
+// Records holding a single trade carry the ask in High and the bid in Low. Other records have no quotes, so they
+// fill at their close, and their high and low trigger orders.
+//
+// A simulator is reused across combinations with Reset, one per thread. Working orders live in a fixed array and
+// trades in a vector that keeps its capacity, so running orders does not allocate.
+class FillSimulator
+{
+public:
+    static const int MAX_WORKING_ORDERS = 32;
+
+    explicit FillSimulator(const FillConfig &config);
+
+    void Reset();
+
+    // Works the request from the next processed tick on. False when the request is invalid or the working orders are full.
+    bool Submit(const SoOrderRequest &request);
+
+    // Runs the working orders over tick records first to last - 1
+    void Process(const ColumnarCache &ticks, size_t first, size_t last);
+
+    int GetPositionQuantity() const { return positionQuantity; }
+    double GetAveragePrice() const { return averagePrice; }
+    double GetClosedProfitLoss() const { return closedProfitLoss; }
+    int GetWorkingOrderCount() const { return workingOrderCount; }
+    const std::vector<s_ACSTrade> &GetTrades() const { return trades; }
+
+    // Swaps the closed trades into out, the simulator keeps out's old buffer for the next combination
+    void TakeTrades(std::vector<s_ACSTrade> &out);
+
+private:
+    struct WorkingOrder
+    {
+        int Side; // 1 buy, -1 sell
+        int OrderType;
+        int Quantity; // 0 with Flatten, sized to the position when it fills
+        bool Flatten;
+        bool Placed; // False until the first tick after submission
+        double Price;
+        double QueueAhead;
+    };
+
+    bool TryFill(WorkingOrder &order, double bid, double ask, double high, double low, double volume, double &fillPrice);
+    void ApplyFill(int side, int quantity, double price, const SCDateTimeMS &dateTime);
+    void CloseQuantity(int quantity, double price, const SCDateTimeMS &dateTime);
+    void CancelAll();
+
+    FillConfig config;
+    WorkingOrder workingOrders[MAX_WORKING_ORDERS];
+    int workingOrderCount;
+
+    int positionQuantity; // Positive long, negative short
+    int maxOpenQuantity;
+    double averagePrice;
+    double closedProfitLoss;
+    SCDateTimeMS positionOpenDateTime;
+    double maxOpenProfit; // Open profit extremes of the position since it left flat, in currency
+    double maxOpenLoss;
+
+    std::vector<s_ACSTrade> trades;
+};
@@ -0,0 +1,299 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "GridNeighborhood.hpp"
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    struct Accumulator
+    {
+        int Count = 0;
+        double Sum = 0.0;
+        double SumSquares = 0.0;
+        double Min = HUGE_VAL;
+
+        void Add(double value)
+        {
+            Count++;
+            Sum += value;
+            SumSquares += value * value;
+            Min = (std::min)(Min, value);
+        }
+    };
+
+    // Number of lattice offsets in the ball, as a double so large dimension counts cannot overflow
+    double GetBallSize(size_t dimensions, int radius, NeighborhoodShape neighborhoodShape)
+    {
+        if (neighborhoodShape == NeighborhoodShape::CHEBYSHEV)
+        {
+            return std::pow(2.0 * radius + 1.0, (double)dimensions);
+        }
+
+        // Offsets with k non-zero coordinates: choose the axes, their signs, and split at most r steps among them
+        double total = 0.0;
+        double chooseDimensions = 1.0;
+        double chooseRadius = 1.0;
+        for (int k = 0; k <= radius && k <= (int)dimensions; ++k)
+        {
+            if (k > 0)
+            {
+                chooseDimensions *= (double)(dimensions - k + 1) / k;
+                chooseRadius *= (double)(radius - k + 1) / k;
+            }
+            total += std::pow(2.0, k) * chooseDimensions * chooseRadius;
+        }
+        return total;
+    }
+
+    void EnumerateOffsets(std::vector<int> &offset, size_t dimension, int budget, NeighborhoodShape neighborhoodShape, int radius, std::vector<std::vector<int>> &offsets)
+    {
+        if (dimension == offset.size())
+        {
+            if (std::any_of(offset.begin(), offset.end(), [](int o)
+                            { return o != 0; }))
+                offsets.push_back(offset);
+            return;
+        }
+
+        int limit = neighborhoodShape == NeighborhoodShape::MANHATTAN ? budget : radius;
+        for (int o = -limit; o <= limit; ++o)
+        {
+            offset[dimension] = o;
+            EnumerateOffsets(offset, dimension + 1, budget - std::abs(o), neighborhoodShape, radius, offsets);
+        }
+        offset[dimension] = 0;
+    }
+
+    // Below this many results a pairwise comparison is cheaper than building an index
+    const size_t PAIRWISE_MAX_COUNT = 512;
+
+    // Cost of probing one bucket in the hash index, in distance checks
+    const double BUCKET_PROBE_COST = 4.0;
+
+    bool IsWithinRadius(const int *a, const int *b, size_t dimensions, int radius, NeighborhoodShape neighborhoodShape)
+    {
+        int distance = 0;
+        for (size_t i = 0; i < dimensions; ++i)
+        {
+            int step = std::abs(a[i] - b[i]);
+            distance = neighborhoodShape == NeighborhoodShape::MANHATTAN ? distance + step : (std::max)(distance, step);
+            if (distance > radius)
+                return false;
+        }
+        return true;
+    }
+
+    void AddPairIfNeighbors(size_t i, size_t j, const std::vector<int> &coordinates, const std::vector<double> &values, size_t dimensions, int radius,
+                            NeighborhoodShape neighborhoodShape, std::vector<Accumulator> &accumulators)
+    {
+        if (IsWithinRadius(&coordinates[i * dimensions], &coordinates[j * dimensions], dimensions, radius, neighborhoodShape))
+        {
+            accumulators[i].Add(values[j]);
+            accumulators[j].Add(values[i]);
+        }
+    }
+
+    // Buckets the results by their coordinates divided by radius + 1 over the most selective dimensions. Neighbors
+    // differ by at most radius along every axis, so they lie in the same or an adjacent bucket on each bucketed axis.
+    void AddBucketedNeighbors(const std::vector<int> &coordinates, const std::vector<double> &values, const std::vector<int> &shape, int radius,
+                              NeighborhoodShape neighborhoodShape, std::vector<Accumulator> &accumulators)
+    {
+        size_t count = values.size();
+        size_t dimensions = shape.size();
+        int width = radius + 1;
+
+        // Axes with the most buckets first, each one only while the buckets it saves comparing outweigh the three
+        // times as many buckets every point then probes
+        std::vector<size_t> axes(dimensions);
+        for (size_t d = 0; d < dimensions; ++d)
+            axes[d] = d;
+        std::sort(axes.begin(), axes.end(), [&](size_t a, size_t b)
+                  { return shape[a] > shape[b]; });
+
+        std::vector<size_t> keyAxes;
+        std::vector<long long> keyRadix;
+        double probes = 1.0;
+        double candidates = (double)count;
+        for (size_t d : axes)
+        {
+            long long bucketCount = (shape[d] + width - 1) / width;
+            double narrowed = candidates * 3.0 / (double)bucketCount;
+            if (bucketCount <= 3 || probes * 3.0 * BUCKET_PROBE_COST + narrowed >= probes * BUCKET_PROBE_COST + candidates)
+                break;
+            keyAxes.push_back(d);
+            keyRadix.push_back(bucketCount);
+            probes *= 3.0;
+            candidates = narrowed;
+        }
+
+        std::vector<long long> keys(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            long long key = 0;
+            for (size_t k = 0; k < keyAxes.size(); ++k)
+                key = key * keyRadix[k] + coordinates[i * dimensions + keyAxes[k]] / width;
+            keys[i] = key;
+        }
+
+        // Results sorted by bucket, each bucket a range of them
+        std::vector<int> order(count);
+        for (size_t i = 0; i < count; ++i)
+            order[i] = (int)i;
+        std::sort(order.begin(), order.end(), [&](int a, int b)
+                  { return keys[a] < keys[b]; });
+        std::unordered_map<long long, std::pair<int, int>> ranges;
+        ranges.reserve(count);
+        for (size_t begin = 0; begin < count;)
+        {
+            size_t end = begin + 1;
+            while (end < count && keys[order[end]] == keys[order[begin]])
+                ++end;
+            ranges.emplace(keys[order[begin]], std::make_pair((int)begin, (int)end));
+            begin = end;
+        }
+
+        std::vector<int> bucketOffset(keyAxes.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Every combination of -1, 0 and +1 over the bucketed axes, each pair is counted from its lower index
+            std::fill(bucketOffset.begin(), bucketOffset.end(), -1);
+            while (true)
+            {
+                long long key = 0;
+                bool isInside = true;
+                for (size_t k = 0; k < keyAxes.size() && isInside; ++k)
+                {
+                    long long b = coordinates[i * dimensions + keyAxes[k]] / width + bucketOffset[k];
+                    isInside = b >= 0 && b < keyRadix[k];
+                    key = key * keyRadix[k] + b;
+                }
+
+                auto it = isInside ? ranges.find(key) : ranges.end();
+                if (it != ranges.end())
+                {
+                    for (int r = it->second.first; r < it->second.second; ++r)
+                    {
+                        if ((size_t)order[r] > i)
+                            AddPairIfNeighbors(i, order[r], coordinates, values, dimensions, radius, neighborhoodShape, accumulators);
+                    }
+                }
+
+                size_t k = 0;
+                while (k < bucketOffset.size() && bucketOffset[k] == 1)
+                    bucketOffset[k++] = -1;
+                if (k == bucketOffset.size())
+                    break;
+                bucketOffset[k]++;
+            }
+        }
+    }
+}
+
+namespace GridNeighborhood
+{
+    std::vector<int> DecodeCoordinates(long long globalIndex, const std::vector<int> &shape)
+    {
+        std::vector<int> coordinates(shape.size());
+        for (size_t i = shape.size(); i-- > 0;)
+        {
+            coordinates[i] = (int)(globalIndex % shape[i]);
+            globalIndex /= shape[i];
+        }
+        return coordinates;
+    }
+
+    std::vector<NeighborhoodStats> Compute(const std::vector<long long> &globalIndices, const std::vector<double> &values, const std::vector<int> &shape,
+                                           int radius, NeighborhoodShape neighborhoodShape, double penalty)
+    {
+        size_t count = globalIndices.size();
+        size_t dimensions = shape.size();
+
+        std::vector<int> coordinates(count * dimensions);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::vector<int> decoded = DecodeCoordinates(globalIndices[i], shape);
+            std::copy(decoded.begin(), decoded.end(), coordinates.begin() + i * dimensions);
+        }
+
+        std::vector<Accumulator> accumulators(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            accumulators[i].Add(values[i]);
+        }
+
+        if (GetBallSize(dimensions, radius, neighborhoodShape) * BUCKET_PROBE_COST <= (double)count)
+        {
+            // Dense enough that probing every offset of the ball in the hash index beats comparing results
+            std::vector<long long> strides(dimensions, 1);
+            for (size_t i = dimensions; i-- > 1;)
+            {
+                strides[i - 1] = strides[i] * shape[i];
+            }
+
+            std::unordered_map<long long, int> cells;
+            cells.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                cells.emplace(globalIndices[i], (int)i);
+            }
+
+            std::vector<std::vector<int>> offsets;
+            std::vector<int> offset(dimensions, 0);
+            EnumerateOffsets(offset, 0, radius, neighborhoodShape, radius, offsets);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const int *cell = &coordinates[i * dimensions];
+                for (const auto &o : offsets)
+                {
+                    long long neighbor = globalIndices[i];
+                    bool isInside = true;
+                    for (size_t d = 0; d < dimensions && isInside; ++d)
+                    {
+                        int c = cell[d] + o[d];
+                        isInside = c >= 0 && c < shape[d];
+                        neighbor += (long long)o[d] * strides[d];
+                    }
+                    if (!isInside)
+                        continue;
+
+                    auto it = cells.find(neighbor);
+                    if (it != cells.end())
+                        accumulators[i].Add(values[it->second]);
+                }
+            }
+        }
+        else if (count <= PAIRWISE_MAX_COUNT)
+        {
+            // Few results on a sparse grid, compare them pairwise
+            for (size_t i = 0; i < count; ++i)
+            {
+                for (size_t j = i + 1; j < count; ++j)
+                {
+                    AddPairIfNeighbors(i, j, coordinates, values, dimensions, radius, neighborhoodShape, accumulators);
+                }
+            }
+        }
+        else
+        {
+            // Sparse, high dimensional grids have fewer results than cells in one ball, only nearby buckets are compared
+            AddBucketedNeighbors(coordinates, values, shape, radius, neighborhoodShape, accumulators);
+        }
+
+        std::vector<NeighborhoodStats> stats(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Accumulator &a = accumulators[i];
+            stats[i].Count = a.Count;
+            stats[i].Mean = a.Sum / a.Count;
+            stats[i].Min = a.Min;
+            stats[i].Variance = (std::max)(0.0, a.SumSquares / a.Count - stats[i].Mean * stats[i].Mean);
+            stats[i].PlateauScore = stats[i].Mean - penalty * std::sqrt(stats[i].Variance);
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include <vector>
+
+// Statistics of an objective over the grid points within the radius of a point, the point included.
+struct NeighborhoodStats
+{
+    int Count = 0;
+    double Mean = 0.0;
+    double Min = 0.0;
+    double Variance = 0.0;
+    double PlateauScore = 0.0;
+};
+
+// Maps results back to their cell in the parameter lattice through their global combination index
+// (mixed radix, last parameter varying fastest) and looks neighbors up in a hash index of the cells that ran. Grids
+// too sparse to probe every offset of the ball compare only results in adjacent coarse buckets.
+namespace GridNeighborhood
+{
+    std::vector<int> DecodeCoordinates(long long globalIndex, const std::vector<int> &shape);
+
+    // Values are oriented so larger is better. PlateauScore is the neighborhood mean minus penalty standard deviations.
+    std::vector<NeighborhoodStats> Compute(const std::vector<long long> &globalIndices, const std::vector<double> &values, const std::vector<int> &shape,
+                                           int radius, NeighborhoodShape neighborhoodShape, double penalty);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "HeatmapCubes.hpp"
+#include <algorithm>
+
+namespace HeatmapCubes
+{
+    std::vector<HeatmapCube> Compute(const std::vector<std::vector<double>> &parameters, const std::vector<double> &values)
+    {
+        std::vector<HeatmapCube> cubes;
+        if (parameters.empty())
+        {
+            return cubes;
+        }
+
+        // Distinct values of each parameter, and the position of every result along each of them
+        size_t parameterCount = parameters.front().size();
+        std::vector<std::vector<double>> distinct(parameterCount);
+        for (size_t p = 0; p < parameterCount; ++p)
+        {
+            for (const auto &row : parameters)
+            {
+                distinct[p].push_back(row[p]);
+            }
+            std::sort(distinct[p].begin(), distinct[p].end());
+            distinct[p].erase(std::unique(distinct[p].begin(), distinct[p].end()), distinct[p].end());
+        }
+
+        std::vector<std::vector<int>> positions(parameters.size(), std::vector<int>(parameterCount));
+        for (size_t r = 0; r < parameters.size(); ++r)
+        {
+            for (size_t p = 0; p < parameterCount; ++p)
+            {
+                positions[r][p] = (int)(std::lower_bound(distinct[p].begin(), distinct[p].end(), parameters[r][p]) - distinct[p].begin());
+            }
+        }
+
+        std::vector<int> varying;
+        for (size_t p = 0; p < parameterCount; ++p)
+        {
+            if (distinct[p].size() > 1)
+                varying.push_back((int)p);
+        }
+
+        for (size_t a = 0; a < varying.size(); ++a)
+        {
+            for (size_t b = a + 1; b < varying.size(); ++b)
+            {
+                HeatmapCube cube;
+                cube.XParameter = varying[a];
+                cube.YParameter = varying[b];
+                cube.XValues = distinct[cube.XParameter];
+                cube.YValues = distinct[cube.YParameter];
+                size_t cells = cube.XValues.size() * cube.YValues.size();
+                cube.Count.assign(cells, 0);
+                cube.Mean.assign(cells, 0.0);
+                cube.Max.assign(cells, 0.0);
+
+                for (size_t r = 0; r < parameters.size(); ++r)
+                {
+                    size_t cell = (size_t)positions[r][cube.YParameter] * cube.XValues.size() + positions[r][cube.XParameter];
+                    cube.Max[cell] = cube.Count[cell] == 0 ? values[r] : (std::max)(cube.Max[cell], values[r]);
+                    cube.Mean[cell] += values[r];
+                    cube.Count[cell]++;
+                }
+
+                for (size_t cell = 0; cell < cells; ++cell)
+                {
+                    if (cube.Count[cell] > 0)
+                        cube.Mean[cell] /= cube.Count[cell];
+                }
+                cubes.push_back(cube);
+            }
+        }
+        return cubes;
+    }
+}
@@ -0,0 +1,27 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include <vector>
+
+// Count, mean and maximum of a metric for one pair of parameters, marginalized over every other parameter.
+// Cells are row-major with one row per Y value: cell = y * XValues.size() + x. Empty cells have a count of 0.
+struct HeatmapCube
+{
+    int XParameter = 0;
+    int YParameter = 0;
+    std::vector<double> XValues;
+    std::vector<double> YValues;
+    std::vector<int> Count;
+    std::vector<double> Mean;
+    std::vector<double> Max;
+};
+
+// Pre-aggregated heatmaps for every pair of varying parameters, so a viewer never pivots the full result set.
+// Each cube is one pass over the results, the cost is O(results * pairs) and the memory only that of the cells.
+namespace HeatmapCubes
+{
+    // parameters[r][p] is the value of parameter p in result r, values[r] its metric.
+    // Parameters with a single value are not varying and get no cube.
+    std::vector<HeatmapCube> Compute(const std::vector<std::vector<double>> &parameters, const std::vector<double> &values);
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "IndicatorCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Parameters are written bit for bit, so the key never depends on number formatting
+    std::string GetKeyString(const IndicatorKey &key)
+    {
+        std::string keyString = key.Kind;
+        keyString.push_back('\0');
+        size_t offset = keyString.size();
+        keyString.resize(offset + key.Parameters.size() * sizeof(double));
+        if (!key.Parameters.empty())
+            std::memcpy(&keyString[offset], key.Parameters.data(), key.Parameters.size() * sizeof(double));
+        keyString.push_back('\0');
+        keyString += key.SeriesId;
+        return keyString;
+    }
+
+    IndicatorSpan ToSpan(const std::shared_ptr<const std::vector<float>> &values)
+    {
+        IndicatorSpan span;
+        span.Values = {values->data(), values->size()};
+        span.Owner = values;
+        return span;
+    }
+}
+
+IndicatorCache::IndicatorCache(size_t capacityBytes)
+    : capacityBytes(capacityBytes),
+      usedBytes(0),
+      hitCount(0),
+      missCount(0),
+      evictionCount(0)
+{
+}
+
+IndicatorSpan IndicatorCache::Get(const IndicatorKey &key, const std::function<std::vector<float>()> &compute)
+{
+    std::string keyString = GetKeyString(key);
+    std::promise<std::shared_ptr<const std::vector<float>>> promise;
+    std::shared_future<std::shared_ptr<const std::vector<float>>> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = entries.find(keyString);
+        if (found != entries.end())
+        {
+            ++hitCount;
+            recentKeys.splice(recentKeys.begin(), recentKeys, found->second.RecentPosition);
+            cached = found->second.Values;
+        }
+        else
+        {
+            ++missCount;
+            Entry &entry = entries[keyString];
+            entry.Values = promise.get_future().share();
+            recentKeys.push_front(keyString);
+            entry.RecentPosition = recentKeys.begin();
+        }
+    }
+
+    // Waits outside the lock when another thread is still computing the series
+    if (cached.valid())
+        return ToSpan(cached.get());
+
+    // Computed outside the lock, other keys stay available meanwhile
+    std::shared_ptr<const std::vector<float>> values;
+    try
+    {
+        values = std::make_shared<const std::vector<float>>(compute());
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = entries.find(keyString);
+        if (found != entries.end())
+        {
+            recentKeys.erase(found->second.RecentPosition);
+            entries.erase(found);
+        }
+        throw;
+    }
+    promise.set_value(values);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = entries.find(keyString);
+        if (found != entries.end())
+        {
+            found->second.Bytes = (std::max)(values->size() * sizeof(float), (size_t)1);
+            usedBytes += found->second.Bytes;
+            Evict(keyString);
+        }
+    }
+    return ToSpan(values);
+}
+
+void IndicatorCache::Evict(const std::string &keep)
+{
+    // Least recently used first, skipping the series just stored and those still being computed
+    auto position = recentKeys.end();
+    while (usedBytes > capacityBytes && position != recentKeys.begin())
+    {
+        --position;
+        auto found = entries.find(*position);
+        if (*position == keep || found->second.Bytes == 0)
+            continue;
+
+        usedBytes -= found->second.Bytes;
+        ++evictionCount;
+        entries.erase(found);
+        position = recentKeys.erase(position);
+    }
+}
+
+void IndicatorCache::Clear()
+{
+    // Series being computed keep their entries, so their waiting callers still get them
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto position = recentKeys.begin(); position != recentKeys.end();)
+    {
+        auto found = entries.find(*position);
+        if (found->second.Bytes == 0)
+        {
+            ++position;
+            continue;
+        }
+        usedBytes -= found->second.Bytes;
+        entries.erase(found);
+        position = recentKeys.erase(position);
+    }
+}
+
+size_t IndicatorCache::GetHitCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+size_t IndicatorCache::GetMissCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
+
+size_t IndicatorCache::GetEvictionCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return evictionCount;
+}
+
+size_t IndicatorCache::GetUsedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ColumnarCache.hpp"
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Identity of a computed indicator: what it is, the parameters it depends on and the bars it ran over.
+// Only the parameters the indicator reads belong in the key, so combinations differing elsewhere share it.
+struct IndicatorKey
+{
+    std::string Kind;               // e.g. "SMA"
+    std::vector<double> Parameters; // e.g. {MA Length}
+    std::string SeriesId;           // Bar series the indicator ran over, e.g. <scid> + BarSpec::GetKey()
+};
+
+// Read-only values of a cached indicator, one per bar. The span keeps its values alive after the cache evicts them.
+struct IndicatorSpan
+{
+    ColumnSpan<float> Values;
+    std::shared_ptr<const std::vector<float>> Owner;
+};
+
+// Indicator series computed once per key and shared by every combination evaluated against the same bars.
+// Safe to call from the worker threads of a sweep: a key asked for while another thread computes it waits
+// for that result instead of computing it again.
+//
+// The cache holds at most capacityBytes of finished series and evicts the least recently used ones past that.
+// An evicted series stays readable through the spans already handed out.
+class IndicatorCache
+{
+public:
+    explicit IndicatorCache(size_t capacityBytes);
+    IndicatorCache(const IndicatorCache &) = delete;
+    IndicatorCache &operator=(const IndicatorCache &) = delete;
+
+    // The cached series of key, or the result of compute stored under key. An exception from compute reaches
+    // every caller waiting on the key, and the key is computed again on the next call.
+    IndicatorSpan Get(const IndicatorKey &key, const std::function<std::vector<float>()> &compute);
+
+    void Clear();
+
+    size_t GetHitCount() const;
+    size_t GetMissCount() const;
+    size_t GetEvictionCount() const;
+    size_t GetUsedBytes() const;
+
+private:
+    struct Entry
+    {
+        std::shared_future<std::shared_ptr<const std::vector<float>>> Values;
+        size_t Bytes = 0; // 0 while the series is being computed, which also keeps it from eviction
+        std::list<std::string>::iterator RecentPosition;
+    };
+
+    void Evict(const std::string &keep);
+
+    mutable std::mutex mutex;
+    size_t capacityBytes;
+    size_t usedBytes;
+    size_t hitCount;
+    size_t missCount;
+    size_t evictionCount;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> recentKeys; // Most recently used first
+};
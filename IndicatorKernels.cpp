@@ -0,0 +1,730 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "IndicatorKernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define INDICATOR_KERNELS_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles intrinsics of any level anywhere, GCC and Clang need the level on the function using them.
+// SSE2 is part of x64 itself. No kernel uses FMA, which would round differently from the scalar code.
+#if defined(INDICATOR_KERNELS_X64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace
+{
+    // Bars advanced before the lane states are written out series by series
+    const size_t LANE_BLOCK = 64;
+
+    SimdLevel DetectSimdLevel()
+    {
+#if defined(INDICATOR_KERNELS_X64)
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7)
+        {
+            // AVX registers must also be saved by the operating system
+            __cpuid(info, 1);
+            bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+            __cpuidex(info, 7, 0);
+            if (osSavesAvx && (info[1] & (1 << 5)) != 0)
+                return SimdLevel::Avx2;
+        }
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::Avx2;
+#endif
+        return SimdLevel::Sse2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    std::atomic<SimdLevel> &ActiveSimdLevel()
+    {
+        static std::atomic<SimdLevel> level(IndicatorKernels::GetSupportedSimdLevel());
+        return level;
+    }
+
+    void ValidateLengths(const std::vector<int> &lengths)
+    {
+        for (int length : lengths)
+        {
+            if (length < 1)
+                throw std::invalid_argument("Indicator length must be at least 1, got " + std::to_string(length) + ".");
+        }
+    }
+
+    // prefix[i] is the sum of the first i values less offset, squared when asked. The offset keeps the sums small.
+    std::vector<double> GetPrefixSums(ColumnSpan<float> values, double offset, bool squares)
+    {
+        std::vector<double> prefix(values.Size + 1, 0.0);
+        for (size_t i = 0; i < values.Size; ++i)
+        {
+            double value = values[i] - offset;
+            prefix[i + 1] = prefix[i] + (squares ? value * value : value);
+        }
+        return prefix;
+    }
+
+    // ---- Window mean: out[i] = mean of the length values ending at i, from the prefix sums ----
+
+    inline float WindowMeanAt(const double *prefix, size_t i, int length, double scale, double offset)
+    {
+        return (float)((prefix[i + 1] - prefix[i + 1 - length]) * scale + offset);
+    }
+
+    void WindowMeanScalar(const double *prefix, size_t count, int length, double offset, float *out)
+    {
+        double scale = 1.0 / length;
+        for (size_t i = length - 1; i < count; ++i)
+        {
+            out[i] = WindowMeanAt(prefix, i, length, scale, offset);
+        }
+    }
+
+    // ---- Window deviation: population standard deviation of the length values ending at i ----
+
+    inline float WindowDeviationAt(const double *prefix, const double *prefixSquares, size_t i, int length, double scale)
+    {
+        double sum = prefix[i + 1] - prefix[i + 1 - length];
+        double sumSquares = prefixSquares[i + 1] - prefixSquares[i + 1 - length];
+        return (float)std::sqrt((std::max)((sumSquares - sum * sum * scale) * scale, 0.0));
+    }
+
+    void WindowDeviationScalar(const double *prefix, const double *prefixSquares, size_t count, int length, float *out)
+    {
+        double scale = 1.0 / length;
+        for (size_t i = length - 1; i < count; ++i)
+        {
+            out[i] = WindowDeviationAt(prefix, prefixSquares, i, length, scale);
+        }
+    }
+
+    // ---- Smoothing lanes: state += alpha * (value - state), seeded with the first value, one lane per alpha ----
+
+    void SmoothLaneScalar(const float *values, size_t count, float alpha, float *out)
+    {
+        float state = values[0];
+        out[0] = state;
+        for (size_t i = 1; i < count; ++i)
+        {
+            state = state + alpha * (values[i] - state);
+            out[i] = state;
+        }
+    }
+
+    // ---- Weighted lanes: linearly weighted mean, one lane per length, from a running sum and numerator ----
+
+    void WmaLaneScalar(const float *values, size_t count, int length, float *out)
+    {
+        double weight = 2.0 / ((double)length * (length + 1));
+        double sum = 0.0;
+        double numerator = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            double value = values[i];
+            double dropped = i >= (size_t)length ? values[i - length] : 0.0;
+            numerator = numerator + (double)length * value - sum;
+            sum = sum + value - dropped;
+            out[i] = i + 1 >= (size_t)length ? (float)(numerator * weight) : 0.0f;
+        }
+    }
+
+    // ---- Pair extreme: out[j] = max or min of a[j] and b[j] ----
+
+    void PairExtremeScalar(const float *a, const float *b, size_t count, bool highest, float *out)
+    {
+        for (size_t j = 0; j < count; ++j)
+        {
+            out[j] = highest ? (std::max)(a[j], b[j]) : (std::min)(a[j], b[j]);
+        }
+    }
+
+#if defined(INDICATOR_KERNELS_X64)
+    void WindowMeanSse2(const double *prefix, size_t count, int length, double offset, float *out)
+    {
+        double scale = 1.0 / length;
+        __m128d scaleVector = _mm_set1_pd(scale);
+        __m128d offsetVector = _mm_set1_pd(offset);
+        size_t i = length - 1;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d window = _mm_sub_pd(_mm_loadu_pd(prefix + i + 1), _mm_loadu_pd(prefix + i + 1 - length));
+            __m128 mean = _mm_cvtpd_ps(_mm_add_pd(_mm_mul_pd(window, scaleVector), offsetVector));
+            _mm_storel_pi(reinterpret_cast<__m64 *>(out + i), mean);
+        }
+        for (; i < count; ++i)
+        {
+            out[i] = WindowMeanAt(prefix, i, length, scale, offset);
+        }
+    }
+
+    TARGET_AVX2 void WindowMeanAvx2(const double *prefix, size_t count, int length, double offset, float *out)
+    {
+        double scale = 1.0 / length;
+        __m256d scaleVector = _mm256_set1_pd(scale);
+        __m256d offsetVector = _mm256_set1_pd(offset);
+        size_t i = length - 1;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d window = _mm256_sub_pd(_mm256_loadu_pd(prefix + i + 1), _mm256_loadu_pd(prefix + i + 1 - length));
+            _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(window, scaleVector), offsetVector)));
+        }
+        for (; i < count; ++i)
+        {
+            out[i] = WindowMeanAt(prefix, i, length, scale, offset);
+        }
+    }
+
+    void WindowDeviationSse2(const double *prefix, const double *prefixSquares, size_t count, int length, float *out)
+    {
+        double scale = 1.0 / length;
+        __m128d scaleVector = _mm_set1_pd(scale);
+        size_t i = length - 1;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d sum = _mm_sub_pd(_mm_loadu_pd(prefix + i + 1), _mm_loadu_pd(prefix + i + 1 - length));
+            __m128d sumSquares = _mm_sub_pd(_mm_loadu_pd(prefixSquares + i + 1), _mm_loadu_pd(prefixSquares + i + 1 - length));
+            __m128d variance = _mm_mul_pd(_mm_sub_pd(sumSquares, _mm_mul_pd(_mm_mul_pd(sum, sum), scaleVector)), scaleVector);
+            __m128 deviation = _mm_cvtpd_ps(_mm_sqrt_pd(_mm_max_pd(variance, _mm_setzero_pd())));
+            _mm_storel_pi(reinterpret_cast<__m64 *>(out + i), deviation);
+        }
+        for (; i < count; ++i)
+        {
+            out[i] = WindowDeviationAt(prefix, prefixSquares, i, length, scale);
+        }
+    }
+
+    TARGET_AVX2 void WindowDeviationAvx2(const double *prefix, const double *prefixSquares, size_t count, int length, float *out)
+    {
+        double scale = 1.0 / length;
+        __m256d scaleVector = _mm256_set1_pd(scale);
+        size_t i = length - 1;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d sum = _mm256_sub_pd(_mm256_loadu_pd(prefix + i + 1), _mm256_loadu_pd(prefix + i + 1 - length));
+            __m256d sumSquares = _mm256_sub_pd(_mm256_loadu_pd(prefixSquares + i + 1), _mm256_loadu_pd(prefixSquares + i + 1 - length));
+            __m256d variance = _mm256_mul_pd(_mm256_sub_pd(sumSquares, _mm256_mul_pd(_mm256_mul_pd(sum, sum), scaleVector)), scaleVector);
+            _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_sqrt_pd(_mm256_max_pd(variance, _mm256_setzero_pd()))));
+        }
+        for (; i < count; ++i)
+        {
+            out[i] = WindowDeviationAt(prefix, prefixSquares, i, length, scale);
+        }
+    }
+
+    // Lanes first..first+3, written out every LANE_BLOCK bars so each series receives contiguous stores
+    void SmoothLanesSse2(const float *values, size_t count, const float *alphas, float *const *out)
+    {
+        alignas(16) float block[LANE_BLOCK][4];
+        __m128 alpha = _mm_loadu_ps(alphas);
+        __m128 state = _mm_set1_ps(values[0]);
+        for (size_t first = 0; first < count; first += LANE_BLOCK)
+        {
+            size_t blockSize = (std::min)(LANE_BLOCK, count - first);
+            for (size_t t = 0; t < blockSize; ++t)
+            {
+                size_t i = first + t;
+                if (i > 0)
+                    state = _mm_add_ps(state, _mm_mul_ps(alpha, _mm_sub_ps(_mm_set1_ps(values[i]), state)));
+                _mm_store_ps(block[t], state);
+            }
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                for (size_t t = 0; t < blockSize; ++t)
+                    out[lane][first + t] = block[t][lane];
+            }
+        }
+    }
+
+    TARGET_AVX2 void SmoothLanesAvx2(const float *values, size_t count, const float *alphas, float *const *out)
+    {
+        alignas(32) float block[LANE_BLOCK][8];
+        __m256 alpha = _mm256_loadu_ps(alphas);
+        __m256 state = _mm256_set1_ps(values[0]);
+        for (size_t first = 0; first < count; first += LANE_BLOCK)
+        {
+            size_t blockSize = (std::min)(LANE_BLOCK, count - first);
+            for (size_t t = 0; t < blockSize; ++t)
+            {
+                size_t i = first + t;
+                if (i > 0)
+                    state = _mm256_add_ps(state, _mm256_mul_ps(alpha, _mm256_sub_ps(_mm256_set1_ps(values[i]), state)));
+                _mm256_store_ps(block[t], state);
+            }
+            for (int lane = 0; lane < 8; ++lane)
+            {
+                for (size_t t = 0; t < blockSize; ++t)
+                    out[lane][first + t] = block[t][lane];
+            }
+        }
+    }
+
+    void WmaLanesSse2(const float *values, size_t count, const int *lengths, float *const *out)
+    {
+        alignas(16) float block[LANE_BLOCK][4];
+        __m128d length = _mm_set_pd(lengths[1], lengths[0]);
+        __m128d weight = _mm_set_pd(2.0 / ((double)lengths[1] * (lengths[1] + 1)), 2.0 / ((double)lengths[0] * (lengths[0] + 1)));
+        __m128d sum = _mm_setzero_pd();
+        __m128d numerator = _mm_setzero_pd();
+        for (size_t first = 0; first < count; first += LANE_BLOCK)
+        {
+            size_t blockSize = (std::min)(LANE_BLOCK, count - first);
+            for (size_t t = 0; t < blockSize; ++t)
+            {
+                size_t i = first + t;
+                __m128d value = _mm_set1_pd(values[i]);
+                __m128d dropped = _mm_set_pd(i >= (size_t)lengths[1] ? values[i - lengths[1]] : 0.0, i >= (size_t)lengths[0] ? values[i - lengths[0]] : 0.0);
+                numerator = _mm_sub_pd(_mm_add_pd(numerator, _mm_mul_pd(length, value)), sum);
+                sum = _mm_sub_pd(_mm_add_pd(sum, value), dropped);
+                __m128d warmingUp = _mm_cmplt_pd(_mm_set1_pd((double)(i + 1)), length);
+                _mm_store_ps(block[t], _mm_cvtpd_ps(_mm_andnot_pd(warmingUp, _mm_mul_pd(numerator, weight))));
+            }
+            for (int lane = 0; lane < 2; ++lane)
+            {
+                for (size_t t = 0; t < blockSize; ++t)
+                    out[lane][first + t] = block[t][lane];
+            }
+        }
+    }
+
+    TARGET_AVX2 void WmaLanesAvx2(const float *values, size_t count, const int *lengths, float *const *out)
+    {
+        alignas(16) float block[LANE_BLOCK][4];
+        __m256d length = _mm256_set_pd(lengths[3], lengths[2], lengths[1], lengths[0]);
+        __m256d weight = _mm256_div_pd(_mm256_set1_pd(2.0), _mm256_mul_pd(length, _mm256_add_pd(length, _mm256_set1_pd(1.0))));
+        __m256d sum = _mm256_setzero_pd();
+        __m256d numerator = _mm256_setzero_pd();
+        for (size_t first = 0; first < count; first += LANE_BLOCK)
+        {
+            size_t blockSize = (std::min)(LANE_BLOCK, count - first);
+            for (size_t t = 0; t < blockSize; ++t)
+            {
+                size_t i = first + t;
+                __m256d value = _mm256_set1_pd(values[i]);
+                __m256d dropped = _mm256_set_pd(i >= (size_t)lengths[3] ? values[i - lengths[3]] : 0.0, i >= (size_t)lengths[2] ? values[i - lengths[2]] : 0.0,
+                                                i >= (size_t)lengths[1] ? values[i - lengths[1]] : 0.0, i >= (size_t)lengths[0] ? values[i - lengths[0]] : 0.0);
+                numerator = _mm256_sub_pd(_mm256_add_pd(numerator, _mm256_mul_pd(length, value)), sum);
+                sum = _mm256_sub_pd(_mm256_add_pd(sum, value), dropped);
+                __m256d warmingUp = _mm256_cmp_pd(_mm256_set1_pd((double)(i + 1)), length, _CMP_LT_OQ);
+                _mm_store_ps(block[t], _mm256_cvtpd_ps(_mm256_andnot_pd(warmingUp, _mm256_mul_pd(numerator, weight))));
+            }
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                for (size_t t = 0; t < blockSize; ++t)
+                    out[lane][first + t] = block[t][lane];
+            }
+        }
+    }
+
+    void PairExtremeSse2(const float *a, const float *b, size_t count, bool highest, float *out)
+    {
+        size_t j = 0;
+        for (; j + 4 <= count; j += 4)
+        {
+            __m128 left = _mm_loadu_ps(a + j);
+            __m128 right = _mm_loadu_ps(b + j);
+            _mm_storeu_ps(out + j, highest ? _mm_max_ps(left, right) : _mm_min_ps(left, right));
+        }
+        PairExtremeScalar(a + j, b + j, count - j, highest, out + j);
+    }
+
+    TARGET_AVX2 void PairExtremeAvx2(const float *a, const float *b, size_t count, bool highest, float *out)
+    {
+        size_t j = 0;
+        for (; j + 8 <= count; j += 8)
+        {
+            __m256 left = _mm256_loadu_ps(a + j);
+            __m256 right = _mm256_loadu_ps(b + j);
+            _mm256_storeu_ps(out + j, highest ? _mm256_max_ps(left, right) : _mm256_min_ps(left, right));
+        }
+        PairExtremeScalar(a + j, b + j, count - j, highest, out + j);
+    }
+#endif
+
+    // ---- Dispatch ----
+
+    void WindowMean(const std::vector<double> &prefix, int length, double offset, std::vector<float> &out)
+    {
+        size_t count = out.size();
+        if ((size_t)length > count)
+            return;
+#if defined(INDICATOR_KERNELS_X64)
+        switch (IndicatorKernels::GetSimdLevel())
+        {
+        case SimdLevel::Avx2:
+            WindowMeanAvx2(prefix.data(), count, length, offset, out.data());
+            return;
+        case SimdLevel::Sse2:
+            WindowMeanSse2(prefix.data(), count, length, offset, out.data());
+            return;
+        default:
+            break;
+        }
+#endif
+        WindowMeanScalar(prefix.data(), count, length, offset, out.data());
+    }
+
+    void WindowDeviation(const std::vector<double> &prefix, const std::vector<double> &prefixSquares, int length, std::vector<float> &out)
+    {
+        size_t count = out.size();
+        if ((size_t)length > count)
+            return;
+#if defined(INDICATOR_KERNELS_X64)
+        switch (IndicatorKernels::GetSimdLevel())
+        {
+        case SimdLevel::Avx2:
+            WindowDeviationAvx2(prefix.data(), prefixSquares.data(), count, length, out.data());
+            return;
+        case SimdLevel::Sse2:
+            WindowDeviationSse2(prefix.data(), prefixSquares.data(), count, length, out.data());
+            return;
+        default:
+            break;
+        }
+#endif
+        WindowDeviationScalar(prefix.data(), prefixSquares.data(), count, length, out.data());
+    }
+
+    // One output series per alpha, each the size of values
+    std::vector<std::vector<float>> SmoothLanes(const float *values, size_t count, const std::vector<float> &alphas)
+    {
+        std::vector<std::vector<float>> results(alphas.size(), std::vector<float>(count, 0.0f));
+        if (count == 0)
+            return results;
+
+        std::vector<float *> out(alphas.size());
+        for (size_t lane = 0; lane < alphas.size(); ++lane)
+        {
+            out[lane] = results[lane].data();
+        }
+
+        size_t lane = 0;
+#if defined(INDICATOR_KERNELS_X64)
+        SimdLevel level = IndicatorKernels::GetSimdLevel();
+        for (; level == SimdLevel::Avx2 && lane + 8 <= alphas.size(); lane += 8)
+        {
+            SmoothLanesAvx2(values, count, alphas.data() + lane, out.data() + lane);
+        }
+        for (; level >= SimdLevel::Sse2 && lane + 4 <= alphas.size(); lane += 4)
+        {
+            SmoothLanesSse2(values, count, alphas.data() + lane, out.data() + lane);
+        }
+#endif
+        for (; lane < alphas.size(); ++lane)
+        {
+            SmoothLaneScalar(values, count, alphas[lane], out[lane]);
+        }
+        return results;
+    }
+
+    std::vector<float> GetSmoothing(const std::vector<int> &lengths, bool wilder)
+    {
+        std::vector<float> alphas;
+        for (int length : lengths)
+        {
+            alphas.push_back(wilder ? 1.0f / length : 2.0f / (length + 1));
+        }
+        return alphas;
+    }
+
+    void PairExtreme(const float *a, const float *b, size_t count, bool highest, float *out)
+    {
+#if defined(INDICATOR_KERNELS_X64)
+        switch (IndicatorKernels::GetSimdLevel())
+        {
+        case SimdLevel::Avx2:
+            PairExtremeAvx2(a, b, count, highest, out);
+            return;
+        case SimdLevel::Sse2:
+            PairExtremeSse2(a, b, count, highest, out);
+            return;
+        default:
+            break;
+        }
+#endif
+        PairExtremeScalar(a, b, count, highest, out);
+    }
+
+    // Sparse table: level k holds the extreme of the 2^k values ending at each bar, and a window of length L is the
+    // extreme of two overlapping level entries with 2^k <= L < 2^(k+1). Each level serves every length in its octave.
+    std::vector<std::vector<float>> RollingExtreme(ColumnSpan<float> values, const std::vector<int> &lengths, bool highest)
+    {
+        ValidateLengths(lengths);
+        size_t count = values.Size;
+        std::vector<std::vector<float>> results(lengths.size(), std::vector<float>(count, 0.0f));
+        if (lengths.empty() || count == 0)
+            return results;
+
+        int maxLength = *std::max_element(lengths.begin(), lengths.end());
+        std::vector<float> level(values.begin(), values.end());
+        std::vector<float> nextLevel(count);
+        for (int width = 1;; width *= 2)
+        {
+            for (size_t l = 0; l < lengths.size(); ++l)
+            {
+                int length = lengths[l];
+                if (length >= width && length < 2 * width && (size_t)length <= count)
+                    PairExtreme(level.data() + length - 1, level.data() + width - 1, count - length + 1, highest, results[l].data() + length - 1);
+            }
+            if (2 * width > maxLength || (size_t)width >= count)
+                break;
+
+            std::copy(level.begin(), level.begin() + width, nextLevel.begin());
+            PairExtreme(level.data() + width, level.data(), count - width, highest, nextLevel.data() + width);
+            level.swap(nextLevel);
+        }
+        return results;
+    }
+
+    std::vector<float> GetTypicalPrices(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close)
+    {
+        std::vector<float> typical(close.Size);
+        for (size_t i = 0; i < close.Size; ++i)
+        {
+            typical[i] = (high[i] + low[i] + close[i]) / 3.0f;
+        }
+        return typical;
+    }
+}
+
+namespace IndicatorKernels
+{
+    SimdLevel GetSupportedSimdLevel()
+    {
+        static const SimdLevel supported = DetectSimdLevel();
+        return supported;
+    }
+
+    SimdLevel GetSimdLevel()
+    {
+        return ActiveSimdLevel().load(std::memory_order_relaxed);
+    }
+
+    void SetSimdLevel(SimdLevel level)
+    {
+        ActiveSimdLevel().store((std::min)(level, GetSupportedSimdLevel()));
+    }
+
+    std::vector<std::vector<float>> Sma(ColumnSpan<float> values, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        std::vector<std::vector<float>> results(lengths.size(), std::vector<float>(values.Size, 0.0f));
+        if (values.IsEmpty())
+            return results;
+
+        double offset = values[0];
+        std::vector<double> prefix = GetPrefixSums(values, offset, false);
+        for (size_t l = 0; l < lengths.size(); ++l)
+        {
+            WindowMean(prefix, lengths[l], offset, results[l]);
+        }
+        return results;
+    }
+
+    std::vector<std::vector<float>> Ema(ColumnSpan<float> values, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        return SmoothLanes(values.Data, values.Size, GetSmoothing(lengths, false));
+    }
+
+    std::vector<std::vector<float>> Wma(ColumnSpan<float> values, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        std::vector<std::vector<float>> results(lengths.size(), std::vector<float>(values.Size, 0.0f));
+        std::vector<float *> out(lengths.size());
+        for (size_t l = 0; l < lengths.size(); ++l)
+        {
+            out[l] = results[l].data();
+        }
+
+        size_t lane = 0;
+#if defined(INDICATOR_KERNELS_X64)
+        SimdLevel level = GetSimdLevel();
+        for (; level == SimdLevel::Avx2 && lane + 4 <= lengths.size(); lane += 4)
+        {
+            WmaLanesAvx2(values.Data, values.Size, lengths.data() + lane, out.data() + lane);
+        }
+        for (; level >= SimdLevel::Sse2 && lane + 2 <= lengths.size(); lane += 2)
+        {
+            WmaLanesSse2(values.Data, values.Size, lengths.data() + lane, out.data() + lane);
+        }
+#endif
+        for (; lane < lengths.size(); ++lane)
+        {
+            WmaLaneScalar(values.Data, values.Size, lengths[lane], out[lane]);
+        }
+        return results;
+    }
+
+    std::vector<std::vector<float>> Atr(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        std::vector<float> trueRange(close.Size);
+        for (size_t i = 0; i < close.Size; ++i)
+        {
+            float previousClose = i > 0 ? close[i - 1] : close[i];
+            trueRange[i] = (std::max)(high[i], previousClose) - (std::min)(low[i], previousClose);
+        }
+        return SmoothLanes(trueRange.data(), trueRange.size(), GetSmoothing(lengths, true));
+    }
+
+    std::vector<std::vector<float>> Rsi(ColumnSpan<float> close, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        std::vector<float> gains(close.Size, 0.0f);
+        std::vector<float> losses(close.Size, 0.0f);
+        for (size_t i = 1; i < close.Size; ++i)
+        {
+            float change = close[i] - close[i - 1];
+            gains[i] = (std::max)(change, 0.0f);
+            losses[i] = (std::max)(-change, 0.0f);
+        }
+
+        std::vector<float> smoothing = GetSmoothing(lengths, true);
+        std::vector<std::vector<float>> results = SmoothLanes(gains.data(), gains.size(), smoothing);
+        std::vector<std::vector<float>> averageLosses = SmoothLanes(losses.data(), losses.size(), smoothing);
+        for (size_t l = 0; l < lengths.size(); ++l)
+        {
+            std::vector<float> &rsi = results[l];
+            for (size_t i = 0; i < rsi.size(); ++i)
+            {
+                float moves = rsi[i] + averageLosses[l][i];
+                rsi[i] = moves > 0.0f ? 100.0f * rsi[i] / moves : 50.0f;
+            }
+        }
+        return results;
+    }
+
+    std::vector<BollingerBands> Bollinger(ColumnSpan<float> values, const std::vector<int> &lengths, float multiplier)
+    {
+        ValidateLengths(lengths);
+        std::vector<BollingerBands> results(lengths.size());
+        double offset = values.IsEmpty() ? 0.0 : values[0];
+        std::vector<double> prefix = GetPrefixSums(values, offset, false);
+        std::vector<double> prefixSquares = GetPrefixSums(values, offset, true);
+        std::vector<float> deviation(values.Size);
+        for (size_t l = 0; l < lengths.size(); ++l)
+        {
+            BollingerBands &bands = results[l];
+            bands.Middle.assign(values.Size, 0.0f);
+            bands.Upper.assign(values.Size, 0.0f);
+            bands.Lower.assign(values.Size, 0.0f);
+            WindowMean(prefix, lengths[l], offset, bands.Middle);
+            WindowDeviation(prefix, prefixSquares, lengths[l], deviation);
+            for (size_t i = lengths[l] - 1; i < values.Size; ++i)
+            {
+                bands.Upper[i] = bands.Middle[i] + multiplier * deviation[i];
+                bands.Lower[i] = bands.Middle[i] - multiplier * deviation[i];
+            }
+        }
+        return results;
+    }
+
+    std::vector<std::vector<float>> Vwap(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close, ColumnSpan<uint32_t> volume, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        std::vector<float> typical = GetTypicalPrices(high, low, close);
+        std::vector<double> prefixValue(close.Size + 1, 0.0);
+        std::vector<double> prefixVolume(close.Size + 1, 0.0);
+        for (size_t i = 0; i < close.Size; ++i)
+        {
+            prefixValue[i + 1] = prefixValue[i] + (double)typical[i] * volume[i];
+            prefixVolume[i + 1] = prefixVolume[i] + volume[i];
+        }
+
+        std::vector<std::vector<float>> results(lengths.size(), std::vector<float>(close.Size, 0.0f));
+        for (size_t l = 0; l < lengths.size(); ++l)
+        {
+            int length = lengths[l];
+            std::vector<float> &vwap = results[l];
+            for (size_t i = length - 1; i < close.Size; ++i)
+            {
+                double windowVolume = prefixVolume[i + 1] - prefixVolume[i + 1 - length];
+                vwap[i] = windowVolume > 0.0 ? (float)((prefixValue[i + 1] - prefixValue[i + 1 - length]) / windowVolume) : typical[i];
+            }
+        }
+        return results;
+    }
+
+    std::vector<float> AnchoredVwap(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close, ColumnSpan<uint32_t> volume, const std::vector<size_t> &anchors)
+    {
+        std::vector<float> typical = GetTypicalPrices(high, low, close);
+        std::vector<float> vwap(close.Size, 0.0f);
+        std::vector<size_t> sortedAnchors = anchors;
+        std::sort(sortedAnchors.begin(), sortedAnchors.end());
+
+        size_t nextAnchor = 0;
+        bool anchored = false;
+        double value = 0.0;
+        double totalVolume = 0.0;
+        for (size_t i = 0; i < close.Size; ++i)
+        {
+            while (nextAnchor < sortedAnchors.size() && sortedAnchors[nextAnchor] <= i)
+            {
+                if (sortedAnchors[nextAnchor] == i)
+                {
+                    anchored = true;
+                    value = 0.0;
+                    totalVolume = 0.0;
+                }
+                ++nextAnchor;
+            }
+            if (!anchored)
+                continue;
+
+            value += (double)typical[i] * volume[i];
+            totalVolume += volume[i];
+            vwap[i] = totalVolume > 0.0 ? (float)(value / totalVolume) : typical[i];
+        }
+        return vwap;
+    }
+
+    std::vector<std::vector<float>> RollingHigh(ColumnSpan<float> values, const std::vector<int> &lengths)
+    {
+        return RollingExtreme(values, lengths, true);
+    }
+
+    std::vector<std::vector<float>> RollingLow(ColumnSpan<float> values, const std::vector<int> &lengths)
+    {
+        return RollingExtreme(values, lengths, false);
+    }
+
+    std::vector<std::vector<float>> ZScore(ColumnSpan<float> values, const std::vector<int> &lengths)
+    {
+        ValidateLengths(lengths);
+        std::vector<std::vector<float>> results(lengths.size(), std::vector<float>(values.Size, 0.0f));
+        double offset = values.IsEmpty() ? 0.0 : values[0];
+        std::vector<double> prefix = GetPrefixSums(values, offset, false);
+        std::vector<double> prefixSquares = GetPrefixSums(values, offset, true);
+        std::vector<float> mean(values.Size);
+        std::vector<float> deviation(values.Size);
+        for (size_t l = 0; l < lengths.size(); ++l)
+        {
+            WindowMean(prefix, lengths[l], offset, mean);
+            WindowDeviation(prefix, prefixSquares, lengths[l], deviation);
+            std::vector<float> &score = results[l];
+            for (size_t i = lengths[l] - 1; i < values.Size; ++i)
+            {
+                score[i] = deviation[i] > 0.0f ? (values[i] - mean[i]) / deviation[i] : 0.0f;
+            }
+        }
+        return results;
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ColumnarCache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class SimdLevel
+{
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+struct BollingerBands
+{
+    std::vector<float> Middle;
+    std::vector<float> Upper;
+    std::vector<float> Lower;
+};
+
+// Batch indicator kernels over the bar columns. Every function takes the lengths of a parameter sweep and returns one
+// series per length, each the size of the input, computed in one pass over the input:
+// - moving windows share a single prefix sum or extreme table, so each extra length only costs its output;
+// - recursive averages advance all lengths together, one SIMD lane per length.
+//
+// The instruction set is picked at run time. All levels round the same way, so they return identical values.
+// Windowed results are 0 until the first full window, as in Sierra Chart study arrays. Lengths below 1 throw std::invalid_argument.
+namespace IndicatorKernels
+{
+    // Best level this processor and operating system support
+    SimdLevel GetSupportedSimdLevel();
+    SimdLevel GetSimdLevel();
+
+    // Level used from now on, at most the supported one. Not meant to change while kernels are running.
+    void SetSimdLevel(SimdLevel level);
+
+    std::vector<std::vector<float>> Sma(ColumnSpan<float> values, const std::vector<int> &lengths);
+
+    // Seeded with the first value, smoothing 2 / (length + 1)
+    std::vector<std::vector<float>> Ema(ColumnSpan<float> values, const std::vector<int> &lengths);
+
+    // Linearly weighted, the newest value weighs length
+    std::vector<std::vector<float>> Wma(ColumnSpan<float> values, const std::vector<int> &lengths);
+
+    // Wilder's smoothing of the true range
+    std::vector<std::vector<float>> Atr(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close, const std::vector<int> &lengths);
+
+    // Wilder's RSI from 0 to 100, 50 while there has been no move
+    std::vector<std::vector<float>> Rsi(ColumnSpan<float> close, const std::vector<int> &lengths);
+
+    // Simple moving average plus and minus multiplier population standard deviations
+    std::vector<BollingerBands> Bollinger(ColumnSpan<float> values, const std::vector<int> &lengths, float multiplier);
+
+    // Volume weighted typical price over the last length bars, the typical price itself while the window has no volume
+    std::vector<std::vector<float>> Vwap(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close, ColumnSpan<uint32_t> volume, const std::vector<int> &lengths);
+
+    // Volume weighted typical price since the last anchor, e.g. the first bar of each session. Bars before the first anchor are 0.
+    std::vector<float> AnchoredVwap(ColumnSpan<float> high, ColumnSpan<float> low, ColumnSpan<float> close, ColumnSpan<uint32_t> volume, const std::vector<size_t> &anchors);
+
+    std::vector<std::vector<float>> RollingHigh(ColumnSpan<float> values, const std::vector<int> &lengths);
+    std::vector<std::vector<float>> RollingLow(ColumnSpan<float> values, const std::vector<int> &lengths);
+
+    // Distance from the simple moving average in population standard deviations, 0 on a flat window
+    std::vector<std::vector<float>> ZScore(ColumnSpan<float> values, const std::vector<int> &lengths);
+}
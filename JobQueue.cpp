@@ -0,0 +1,233 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "JobQueue.hpp"
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+using json = nlohmann::json;
+
+namespace fs = std::filesystem;
+
+JobQueue::JobQueue(const std::string &queuePath)
+    : queuePath(queuePath),
+      progressPath(fs::path(queuePath).replace_extension().string() + "-progress.json")
+{
+}
+
+bool JobQueue::Load(std::string &error)
+{
+    std::ifstream queueFile(queuePath);
+    if (!queueFile.is_open())
+    {
+        error = "Could not open job queue file: " + queuePath;
+        return false;
+    }
+
+    std::vector<QueuedJob> loaded;
+    try
+    {
+        json root = json::parse(queueFile);
+        if (!root.contains("jobs") || !root["jobs"].is_array())
+        {
+            error = "The job queue file needs a 'jobs' array.";
+            return false;
+        }
+
+        fs::path queueDir = fs::path(queuePath).parent_path();
+        for (const auto &entry : root["jobs"])
+        {
+            QueuedJob job;
+            job.ConfigPath = entry.value("configPath", "");
+            if (job.ConfigPath.empty())
+            {
+                error = "Every job in the queue needs a 'configPath'.";
+                return false;
+            }
+
+            // Relative to the queue file, so a queue and its configs can be moved together
+            fs::path configPath(job.ConfigPath);
+            if (configPath.is_relative())
+                job.ConfigPath = (queueDir / configPath).string();
+            job.Name = entry.value("name", job.ConfigPath);
+            job.Priority = entry.value("priority", 0);
+
+            for (const QueuedJob &other : loaded)
+            {
+                if (other.Name == job.Name)
+                {
+                    error = "Job names must be unique, '" + job.Name + "' is used twice. Jobs without a name are named by their config path.";
+                    return false;
+                }
+            }
+            loaded.push_back(job);
+        }
+    }
+    catch (const json::exception &e)
+    {
+        error = std::string("Could not parse job queue file: ") + e.what();
+        return false;
+    }
+
+    // Progress is matched by name, a job the queue file no longer lists keeps its entry
+    removedJobs = json::array();
+    std::ifstream progressFile(progressPath);
+    if (progressFile.is_open())
+    {
+        try
+        {
+            json progress = json::parse(progressFile);
+            for (const auto &entry : progress.value("jobs", json::array()))
+            {
+                std::string name = entry.value("name", "");
+                QueuedJob *job = nullptr;
+                for (QueuedJob &candidate : loaded)
+                {
+                    if (candidate.Name == name)
+                        job = &candidate;
+                }
+                if (job == nullptr)
+                {
+                    removedJobs.push_back(entry);
+                    continue;
+                }
+                job->Status = entry.value("status", "pending");
+                job->ResultsDir = entry.value("resultsDir", "");
+                job->StartedAt = entry.value("startedAt", "");
+                job->FinishedAt = entry.value("finishedAt", "");
+                job->Message = entry.value("message", "");
+            }
+        }
+        catch (const json::exception &e)
+        {
+            error = std::string("Could not parse job queue progress file: ") + e.what();
+            return false;
+        }
+    }
+
+    jobs = std::move(loaded);
+    return true;
+}
+
+int JobQueue::GetNextJob() const
+{
+    // A job left running by a restart resumes before anything new starts
+    for (int i = 0; i < (int)jobs.size(); ++i)
+    {
+        if (jobs[i].Status == "running" && jobs[i].Name != runningName)
+            return i;
+    }
+
+    int next = -1;
+    for (int i = 0; i < (int)jobs.size(); ++i)
+    {
+        if (jobs[i].Status == "pending" && (next < 0 || jobs[i].Priority > jobs[next].Priority))
+            next = i;
+    }
+    return next;
+}
+
+int JobQueue::CountJobs(const std::string &status) const
+{
+    int count = 0;
+    for (const QueuedJob &job : jobs)
+    {
+        count += job.Status == status ? 1 : 0;
+    }
+    return count;
+}
+
+QueuedJob *JobQueue::FindJob(const std::string &name)
+{
+    for (QueuedJob &job : jobs)
+    {
+        if (job.Name == name)
+            return &job;
+    }
+    return nullptr;
+}
+
+bool JobQueue::MarkRunning(const std::string &name, const std::string &resultsDir, const std::string &startedAt, std::string &error)
+{
+    QueuedJob *job = FindJob(name);
+    if (job == nullptr)
+    {
+        error = "Job '" + name + "' is no longer in the queue.";
+        return false;
+    }
+
+    // A resumed job keeps the start of its first attempt
+    if (job->Status != "running" || job->StartedAt.empty())
+        job->StartedAt = startedAt;
+    job->Status = "running";
+    job->ResultsDir = resultsDir;
+    job->Message.clear();
+    runningName = name;
+    return SaveProgress(error);
+}
+
+bool JobQueue::MarkFinished(const std::string &name, bool completed, const std::string &resultsDir, const std::string &message, const std::string &finishedAt, std::string &error)
+{
+    if (runningName == name)
+        runningName.clear();
+
+    QueuedJob *job = FindJob(name);
+    if (job == nullptr)
+    {
+        error = "Job '" + name + "' is no longer in the queue.";
+        return false;
+    }
+
+    job->Status = completed ? "completed" : "failed";
+    if (!resultsDir.empty())
+        job->ResultsDir = resultsDir;
+    if (job->StartedAt.empty())
+        job->StartedAt = finishedAt;
+    job->FinishedAt = finishedAt;
+    job->Message = message;
+    return SaveProgress(error);
+}
+
+bool JobQueue::SaveProgress(std::string &error) const
+{
+    json progress;
+    progress["queuePath"] = queuePath;
+    progress["jobs"] = json::array();
+    for (const QueuedJob &job : jobs)
+    {
+        progress["jobs"].push_back({{"name", job.Name},
+                                    {"configPath", job.ConfigPath},
+                                    {"priority", job.Priority},
+                                    {"status", job.Status},
+                                    {"resultsDir", job.ResultsDir},
+                                    {"startedAt", job.StartedAt},
+                                    {"finishedAt", job.FinishedAt},
+                                    {"message", job.Message}});
+    }
+    for (const auto &entry : removedJobs)
+    {
+        progress["jobs"].push_back(entry);
+    }
+
+    // Written aside and renamed over the old file, a crash mid write leaves the previous progress intact
+    std::string pendingPath = progressPath + ".tmp";
+    {
+        std::ofstream o(pendingPath, std::ios::trunc);
+        if (!o.is_open())
+        {
+            error = "Could not write job queue progress file: " + pendingPath;
+            return false;
+        }
+        o << progress.dump(4);
+    }
+
+    std::error_code ec;
+    fs::rename(pendingPath, progressPath, ec);
+    if (ec)
+    {
+        error = "Could not replace job queue progress file: " + ec.message();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include "nlohmann/json.hpp"
+#include <future>
+#include <string>
+#include <vector>
+
+struct QueuedJob
+{
+    std::string Name;
+    std::string ConfigPath;
+    int Priority = 0;
+    std::string Status = "pending"; // pending, running, completed or failed
+    std::string ResultsDir;
+    std::string StartedAt;
+    std::string FinishedAt;
+    std::string Message;
+};
+
+struct GeneratedCombinations
+{
+    std::vector<std::vector<double>> Combinations;
+    std::vector<int> GlobalComboIndices; // Empty when not sharded
+};
+
+// The next job's config, loaded and validated while the last replays of the current job run. Its combinations are
+// generated on a worker thread.
+struct PrefetchedJob
+{
+    bool Attempted = false;
+    std::string Name; // Job whose config was loaded, empty when no job was left
+    bool Loaded = false;
+    StrategyOptimizerConfig Config;
+    std::future<GeneratedCombinations> Combinations;
+};
+
+// Configs run back to back from one Start. The queue file lists the jobs, the progress file next to it records
+// the state and results folder of each, so a restarted queue skips finished jobs and resumes the interrupted one.
+//
+// Queue file:
+//   { "jobs": [ { "name": "ES trend 2024", "configPath": "es-trend.json", "priority": 10 }, ... ] }
+// Progress file <queue>-progress.json:
+//   { "jobs": [ { "name", "configPath", "status", "resultsDir", "startedAt", "finishedAt", "message" }, ... ] }
+class JobQueue
+{
+public:
+    explicit JobQueue(const std::string &queuePath);
+
+    // Reads the queue file again, so jobs can be added or reprioritized while the queue runs
+    bool Load(std::string &error);
+
+    // Interrupted jobs first, then pending jobs by priority and queue order, -1 when none is left
+    int GetNextJob() const;
+    const QueuedJob &GetJob(int job) const { return jobs[job]; }
+    int CountJobs(const std::string &status) const;
+    const std::string &GetRunningJob() const { return runningName; }
+
+    bool MarkRunning(const std::string &name, const std::string &resultsDir, const std::string &startedAt, std::string &error);
+    bool MarkFinished(const std::string &name, bool completed, const std::string &resultsDir, const std::string &message, const std::string &finishedAt, std::string &error);
+
+    const std::string &GetProgressPath() const { return progressPath; }
+
+    PrefetchedJob Prefetch;
+
+private:
+    QueuedJob *FindJob(const std::string &name);
+    bool SaveProgress(std::string &error) const;
+
+    std::string queuePath;
+    std::string progressPath;
+    std::vector<QueuedJob> jobs;
+    std::string runningName;       // Job started by this queue, not an interrupted one
+    nlohmann::json removedJobs;    // Progress of jobs no longer in the queue file, written back unchanged
+};
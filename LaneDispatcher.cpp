@@ -0,0 +1,217 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "LaneDispatcher.hpp"
+#include <algorithm>
+
+namespace
+{
+    std::vector<SweepRun *> &GetRunRegistry()
+    {
+        static std::vector<SweepRun *> runs;
+        return runs;
+    }
+}
+
+namespace LaneDispatcher
+{
+    void RegisterRun(SweepRun *run)
+    {
+        auto &runs = GetRunRegistry();
+        if (std::find(runs.begin(), runs.end(), run) == runs.end())
+        {
+            runs.push_back(run);
+        }
+    }
+
+    void UnregisterRun(SweepRun *run)
+    {
+        auto &runs = GetRunRegistry();
+        runs.erase(std::remove(runs.begin(), runs.end(), run), runs.end());
+    }
+
+    SweepRun *FindRunForChart(int chartNumber)
+    {
+        for (SweepRun *run : GetRunRegistry())
+        {
+            if (FindLane(*run, chartNumber) != nullptr)
+            {
+                return run;
+            }
+        }
+        return nullptr;
+    }
+
+    LaneState *FindLane(SweepRun &run, int chartNumber)
+    {
+        for (auto &lane : run.Lanes)
+        {
+            if (lane.ChartNumber == chartNumber)
+            {
+                return &lane;
+            }
+        }
+        return nullptr;
+    }
+
+    int GetComboIndex(const SweepRun &run, int workItem)
+    {
+        if (run.WalkForward != nullptr)
+        {
+            return WalkForward::GetComboIndex(*run.WalkForward, workItem);
+        }
+        return workItem;
+    }
+
+    int GetGlobalComboIndex(const SweepRun &run, int workItem)
+    {
+        int comboIndex = GetComboIndex(run, workItem);
+        if (run.GlobalComboIndices.empty())
+        {
+            return comboIndex;
+        }
+        return run.GlobalComboIndices[comboIndex];
+    }
+
+    int GetWorkItemCount(const SweepRun &run)
+    {
+        if (run.WalkForward != nullptr)
+        {
+            return WalkForward::GetWorkItemCount(*run.WalkForward);
+        }
+        return run.Combinations != nullptr ? (int)run.Combinations->size() : 0;
+    }
+
+    ReplayConfig GetReplayConfig(const SweepRun &run, int workItem)
+    {
+        if (run.WalkForward != nullptr)
+        {
+            return WalkForward::GetReplayConfig(*run.WalkForward, run.Config->ReplayConfig, workItem);
+        }
+        return run.Config->ReplayConfig;
+    }
+
+    bool ClaimNextCombination(SweepRun &run, LaneState &lane)
+    {
+        bool chartPortfolio = run.Portfolio != nullptr && !run.Portfolio->IsNative();
+        if (chartPortfolio && run.Portfolio->BatchComboIndex >= 0)
+        {
+            // Every symbol chart of a portfolio batch replays the combination the first lane claimed
+            lane.ComboIndex = run.Portfolio->BatchComboIndex;
+            lane.RetryCount = 0;
+            return true;
+        }
+
+        if (run.Coordinator != nullptr && run.NextComboIndex < run.EndComboIndex && !run.Coordinator->HoldsCombination(run.NextComboIndex))
+        {
+            // A peer reclaimed the chunk after this worker's lease expired, the rest of it is the peer's
+            run.NextComboIndex = run.EndComboIndex;
+        }
+
+        if (!run.RequeuedComboIndices.empty())
+        {
+            lane.ComboIndex = run.RequeuedComboIndices.back();
+            run.RequeuedComboIndices.pop_back();
+        }
+        else if (run.NextComboIndex < run.EndComboIndex)
+        {
+            lane.ComboIndex = run.ComboOrder.empty() ? run.NextComboIndex : run.ComboOrder[run.NextComboIndex];
+            run.NextComboIndex++;
+        }
+        else if (run.Coordinator != nullptr && run.Coordinator->ClaimChunk(run.NextComboIndex, run.EndComboIndex))
+        {
+            lane.ComboIndex = run.NextComboIndex++;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (chartPortfolio)
+        {
+            run.Portfolio->BatchComboIndex = lane.ComboIndex;
+        }
+        lane.RetryCount = 0;
+        return true;
+    }
+
+    void CompleteLane(SweepRun &run, LaneState &lane)
+    {
+        if (run.Coordinator != nullptr)
+        {
+            run.Coordinator->CompleteCombination(lane.ComboIndex);
+        }
+        lane.State = ReplayState::Idle;
+        lane.ComboIndex = -1;
+        lane.RetryCount = 0;
+
+        // A portfolio combination is complete once the last of its symbols is
+        if (run.Portfolio == nullptr || AreAllLanesIdle(run))
+        {
+            run.CompletedCount++;
+        }
+    }
+
+    void ReleaseLane(SweepRun &run, LaneState &lane)
+    {
+        // The combination in flight on a lane that goes away is handed to the next idle lane. A portfolio symbol
+        // cannot be replayed on another chart, its batch finishes without it.
+        if (run.Portfolio == nullptr && lane.State != ReplayState::Idle && lane.ComboIndex >= 0)
+        {
+            run.RequeuedComboIndices.push_back(lane.ComboIndex);
+        }
+        lane.State = ReplayState::Idle;
+        lane.ComboIndex = -1;
+        lane.RetryCount = 0;
+        lane.Attached = false;
+    }
+
+    bool IsFinished(const SweepRun &run)
+    {
+        if (run.Coordinator != nullptr)
+        {
+            return run.Coordinator->AreAllChunksDone();
+        }
+        return run.Combinations != nullptr && run.CompletedCount + run.SkippedCount >= GetWorkItemCount(run);
+    }
+
+    bool HasWorkLeft(const SweepRun &run)
+    {
+        return !run.RequeuedComboIndices.empty() || run.NextComboIndex < run.EndComboIndex || (run.Coordinator != nullptr && run.Coordinator->HasClaimableChunk());
+    }
+
+    bool AreAllLanesIdle(const SweepRun &run)
+    {
+        for (const auto &lane : run.Lanes)
+        {
+            if (lane.State != ReplayState::Idle)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsBatchReady(const SweepRun &run)
+    {
+        if (!run.LinkedReplay || !run.BatchOpen)
+        {
+            return false;
+        }
+
+        // Wait until every attached lane has its inputs set, or there is nothing left for it to claim
+        bool anyReady = false;
+        for (const auto &lane : run.Lanes)
+        {
+            if (!lane.Attached)
+                continue;
+
+            // An idle symbol chart of a portfolio has yet to join the batch even when nothing is left to claim
+            if (lane.State == ReplayState::ReadyForReplay)
+                anyReady = true;
+            else if (lane.State != ReplayState::Idle || HasWorkLeft(run) || (run.Portfolio != nullptr && run.Portfolio->BatchComboIndex >= 0))
+                return false;
+        }
+        return anyReady;
+    }
+}
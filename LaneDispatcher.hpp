@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "Enum.hpp"
+#include "ConfigManager.hpp"
+#include "LeaseCoordinator.hpp"
+#include "WalkForward.hpp"
+#include "SurrogateModel.hpp"
+#include "Portfolio.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Replay state of one chart taking part in a sweep. Single chart mode is a run with one lane.
+struct LaneState
+{
+    int ChartNumber = 0;
+    ReplayState State = ReplayState::Idle;
+    int ComboIndex = -1; // Work item of the run, the combination itself unless the run is a walk-forward
+    int RetryCount = 0;
+    std::chrono::steady_clock::time_point StateChangedTime; // Wall clock, for the watchdog and the replay time of reports
+    bool Attached = false;
+};
+
+// A sweep started from the Start button. Owned by the study instance that started it (the dispatcher),
+// and shared with the Strategy Optimizer instances on the other lane charts through the run registry.
+struct SweepRun
+{
+    int DispatcherChartNumber = 0;
+    const StrategyOptimizerConfig *Config = nullptr;
+    const std::vector<std::vector<double>> *Combinations = nullptr;
+    std::string ResultsDir;
+    std::string SummaryPath;
+    std::vector<LaneState> Lanes;
+    int NextComboIndex = 0;
+    int EndComboIndex = 0;
+    std::vector<int> RequeuedComboIndices;
+    int CompletedCount = 0;
+
+    // Linked replay: every lane is prepared with its own combination, then one replay drives all linked charts
+    bool LinkedReplay = false;
+    bool BatchOpen = true;
+
+    // Distributed sweep: combinations come from chunks leased in a shared directory, owned by the run
+    LeaseCoordinator *Coordinator = nullptr;
+
+    // Sharded sweep: position of each local combination in the full combination space, empty when not sharded
+    std::vector<int> GlobalComboIndices;
+
+    // Walk-forward: work items are in-sample and out-of-sample replays of rolling windows, owned by the run
+    WalkForwardPlan *WalkForward = nullptr;
+
+    // Surrogate search: queue position to combination, reordered by the model as results come in. Positions from
+    // EndComboIndex on are past the budget and skipped. The state is owned by the run.
+    std::vector<int> ComboOrder;
+    int SkippedCount = 0;
+    SurrogateState *Surrogate = nullptr;
+
+    // Portfolio: each combination is evaluated on every symbol and counted once, for the merged portfolio. Owned by the run.
+    PortfolioState *Portfolio = nullptr;
+};
+
+// All study instances of the DLL are called on the Sierra Chart main thread, so the registry needs no locking.
+namespace LaneDispatcher
+{
+    void RegisterRun(SweepRun *run);
+    void UnregisterRun(SweepRun *run);
+    SweepRun *FindRunForChart(int chartNumber);
+    LaneState *FindLane(SweepRun &run, int chartNumber);
+
+    int GetComboIndex(const SweepRun &run, int workItem);
+    int GetGlobalComboIndex(const SweepRun &run, int workItem);
+    int GetWorkItemCount(const SweepRun &run);
+    ReplayConfig GetReplayConfig(const SweepRun &run, int workItem);
+    bool ClaimNextCombination(SweepRun &run, LaneState &lane);
+    void CompleteLane(SweepRun &run, LaneState &lane);
+    void ReleaseLane(SweepRun &run, LaneState &lane);
+    bool IsFinished(const SweepRun &run);
+    bool HasWorkLeft(const SweepRun &run);
+    bool AreAllLanesIdle(const SweepRun &run);
+    bool IsBatchReady(const SweepRun &run);
+}
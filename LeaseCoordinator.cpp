@@ -0,0 +1,331 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "LeaseCoordinator.hpp"
+#include "nlohmann/json.hpp"
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <system_error>
+#include <windows.h>
+
+using json = nlohmann::json;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // CREATE_NEW fails when the file already exists, which makes it the lock primitive for leases
+    bool CreateFileExclusive(const std::string &path, const std::string &contents)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        DWORD written = 0;
+        WriteFile(file, contents.data(), (DWORD)contents.size(), &written, NULL);
+        CloseHandle(file);
+        return true;
+    }
+}
+
+const std::chrono::seconds LeaseCoordinator::RESCAN_INTERVAL(5);
+
+LeaseCoordinator::LeaseCoordinator(const std::string &directory, const std::string &workerId, int combinationCount, int chunkSize, int leaseTimeoutSeconds, int heartbeatSeconds)
+    : directory(directory),
+      workerId(workerId),
+      combinationCount(combinationCount),
+      chunkSize(chunkSize > 0 ? chunkSize : 1),
+      leaseTimeout(leaseTimeoutSeconds),
+      heartbeatInterval(heartbeatSeconds)
+{
+    chunkCount = (combinationCount + this->chunkSize - 1) / this->chunkSize;
+}
+
+std::string LeaseCoordinator::GetDefaultWorkerId()
+{
+    char computerName[MAX_COMPUTERNAME_LENGTH + 1] = {};
+    DWORD size = sizeof(computerName);
+    GetComputerNameA(computerName, &size);
+
+    std::stringstream ss;
+    ss << computerName << "-" << GetCurrentProcessId();
+    return ss.str();
+}
+
+bool LeaseCoordinator::Initialize(std::string &resultsDir, std::string &error)
+{
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec)
+    {
+        error = "Could not create lease directory: " + ec.message();
+        return false;
+    }
+
+    // The first worker publishes the manifest, everyone else adopts its results folder.
+    // MoveFileA does not replace an existing file, so readers never see a half written manifest.
+    std::string manifestPath = (fs::path(directory) / "sweep.json").string();
+    std::string pendingPath = manifestPath + "." + workerId + ".tmp";
+    json manifest;
+    manifest["combinationCount"] = combinationCount;
+    manifest["chunkSize"] = chunkSize;
+    manifest["resultsDir"] = resultsDir;
+    manifest["createdBy"] = workerId;
+    {
+        std::ofstream o(pendingPath);
+        o << manifest.dump(4);
+    }
+    if (!MoveFileA(pendingPath.c_str(), manifestPath.c_str()))
+    {
+        fs::remove(pendingPath, ec);
+    }
+
+    try
+    {
+        std::ifstream ifs(manifestPath);
+        json existing;
+        ifs >> existing;
+
+        if (existing.value("combinationCount", -1) != combinationCount || existing.value("chunkSize", -1) != chunkSize)
+        {
+            error = "Lease directory belongs to a sweep with a different combination count or chunk size.";
+            return false;
+        }
+        resultsDir = existing.value("resultsDir", resultsDir);
+    }
+    catch (const std::exception &e)
+    {
+        error = std::string("Could not read sweep manifest: ") + e.what();
+        return false;
+    }
+
+    lastHeartbeat = std::chrono::steady_clock::now();
+    return true;
+}
+
+std::string LeaseCoordinator::GetChunkPath(int chunkIndex, const char *extension) const
+{
+    std::stringstream ss;
+    ss << "chunk-" << std::setw(6) << std::setfill('0') << chunkIndex << extension;
+    return (fs::path(directory) / ss.str()).string();
+}
+
+bool LeaseCoordinator::IsLeaseExpired(const std::string &leasePath) const
+{
+    std::error_code ec;
+    auto lastWrite = fs::last_write_time(leasePath, ec);
+    if (ec)
+    {
+        return false;
+    }
+    return fs::file_time_type::clock::now() - lastWrite > leaseTimeout;
+}
+
+bool LeaseCoordinator::IsLeaseOwned(int chunkIndex) const
+{
+    // A peer that reclaimed the chunk after this worker's lease expired has written its own id into the lease
+    std::ifstream lease(GetChunkPath(chunkIndex, ".lease"));
+    std::string owner;
+    std::getline(lease, owner);
+    return lease.is_open() && owner == workerId;
+}
+
+bool LeaseCoordinator::IsChunkDone(int chunkIndex)
+{
+    if (doneChunks.count(chunkIndex) != 0)
+    {
+        return true;
+    }
+    if (!fs::exists(GetChunkPath(chunkIndex, ".done")))
+    {
+        return false;
+    }
+    doneChunks.insert(chunkIndex);
+    return true;
+}
+
+bool LeaseCoordinator::TryCreateLease(int chunkIndex)
+{
+    if (!CreateFileExclusive(GetChunkPath(chunkIndex, ".lease"), workerId))
+    {
+        return false;
+    }
+
+    int begin = chunkIndex * chunkSize;
+    int end = (std::min)(begin + chunkSize, combinationCount);
+    heldChunks[chunkIndex] = end - begin;
+    return true;
+}
+
+bool LeaseCoordinator::TryReclaimLease(int chunkIndex)
+{
+    std::string leasePath = GetChunkPath(chunkIndex, ".lease");
+    if (!IsLeaseExpired(leasePath))
+    {
+        return false;
+    }
+
+    // Renaming is atomic, so only one of the peers racing for an expired lease gets to remove it
+    std::string stalePath = leasePath + ".expired-" + workerId;
+    std::error_code ec;
+    fs::rename(leasePath, stalePath, ec);
+    if (ec)
+    {
+        return false;
+    }
+    fs::remove(stalePath, ec);
+
+    return TryCreateLease(chunkIndex);
+}
+
+bool LeaseCoordinator::ClaimChunk(int &beginIndex, int &endIndex)
+{
+    // Leases only expire after the lease timeout, an empty scan is not worth repeating on the next poll
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextClaimScan)
+    {
+        return false;
+    }
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        if (heldChunks.count(chunkIndex) != 0 || IsChunkDone(chunkIndex))
+            continue;
+
+        if (TryCreateLease(chunkIndex) || TryReclaimLease(chunkIndex))
+        {
+            beginIndex = chunkIndex * chunkSize;
+            endIndex = (std::min)(beginIndex + chunkSize, combinationCount);
+            return true;
+        }
+    }
+    nextClaimScan = now + RESCAN_INTERVAL;
+    return false;
+}
+
+void LeaseCoordinator::Heartbeat()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastHeartbeat < heartbeatInterval)
+    {
+        return;
+    }
+    lastHeartbeat = now;
+
+    std::error_code ec;
+    for (auto it = heldChunks.begin(); it != heldChunks.end();)
+    {
+        if (!IsLeaseOwned(it->first))
+        {
+            it = heldChunks.erase(it);
+            continue;
+        }
+        fs::last_write_time(GetChunkPath(it->first, ".lease"), fs::file_time_type::clock::now(), ec);
+        ++it;
+    }
+}
+
+void LeaseCoordinator::CompleteCombination(int comboIndex)
+{
+    int chunkIndex = comboIndex / chunkSize;
+    auto it = heldChunks.find(chunkIndex);
+    if (it == heldChunks.end())
+    {
+        return;
+    }
+
+    if (!IsLeaseOwned(chunkIndex))
+    {
+        // The chunk is the peer's now, its lease and .done are the peer's to write
+        heldChunks.erase(it);
+        return;
+    }
+
+    if (--it->second > 0)
+    {
+        return;
+    }
+
+    CreateFileExclusive(GetChunkPath(chunkIndex, ".done"), workerId);
+    doneChunks.insert(chunkIndex);
+    std::error_code ec;
+    fs::remove(GetChunkPath(chunkIndex, ".lease"), ec);
+    heldChunks.erase(it);
+}
+
+void LeaseCoordinator::ReleaseAll()
+{
+    // Unfinished chunks are handed back immediately instead of waiting for the lease to expire
+    std::error_code ec;
+    for (const auto &chunk : heldChunks)
+    {
+        if (IsLeaseOwned(chunk.first))
+            fs::remove(GetChunkPath(chunk.first, ".lease"), ec);
+    }
+    heldChunks.clear();
+}
+
+bool LeaseCoordinator::HoldsCombination(int comboIndex) const
+{
+    return heldChunks.count(comboIndex / chunkSize) != 0;
+}
+
+bool LeaseCoordinator::HasClaimableChunk()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextClaimableScan)
+    {
+        return hasClaimableChunk;
+    }
+    nextClaimableScan = now + RESCAN_INTERVAL;
+
+    hasClaimableChunk = false;
+    for (int chunkIndex = 0; chunkIndex < chunkCount && !hasClaimableChunk; ++chunkIndex)
+    {
+        if (heldChunks.count(chunkIndex) != 0 || IsChunkDone(chunkIndex))
+            continue;
+
+        std::string leasePath = GetChunkPath(chunkIndex, ".lease");
+        hasClaimableChunk = !fs::exists(leasePath) || IsLeaseExpired(leasePath);
+    }
+    return hasClaimableChunk;
+}
+
+bool LeaseCoordinator::AreAllChunksDone()
+{
+    // Chunks this worker completes count at once, the ones peers complete are picked up by the next scan
+    if ((int)doneChunks.size() == chunkCount)
+    {
+        return true;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextDoneScan)
+    {
+        return false;
+    }
+    nextDoneScan = now + RESCAN_INTERVAL;
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        if (!IsChunkDone(chunkIndex))
+            return false;
+    }
+    return true;
+}
+
+bool LeaseCoordinator::TryAcquireSummary()
+{
+    return CreateFileExclusive((fs::path(directory) / "summary.lock").string(), workerId);
+}
+
+void LeaseCoordinator::ReleaseSummary()
+{
+    // A later run in the same lease directory writes its own summary
+    std::error_code ec;
+    fs::remove(fs::path(directory) / "summary.lock", ec);
+}
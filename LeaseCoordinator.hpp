@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+
+// Splits the combination space into chunks recorded in a shared directory so that several Sierra Chart
+// processes can sweep one config together. A chunk is owned through a lease file created with CREATE_NEW,
+// kept alive by touching it, and reclaimed by a peer once its last write is older than the lease timeout.
+// A worker only touches or removes a lease that still names it, a chunk reclaimed from it is dropped.
+//
+// Directory layout:
+//   sweep.json            combination count, chunk size and the shared results folder
+//   chunk-<n>.lease       held by the worker id written inside
+//   chunk-<n>.done        written once every combination of the chunk has a report
+//   summary.lock          held by the worker writing the summary, removed once it is written
+//
+// Done chunks are remembered, and a scan that found nothing to claim is not repeated for RESCAN_INTERVAL, so idle
+// polls on every chart update do not list the directory each time.
+class LeaseCoordinator
+{
+public:
+    LeaseCoordinator(const std::string &directory, const std::string &workerId, int combinationCount, int chunkSize, int leaseTimeoutSeconds, int heartbeatSeconds);
+
+    bool Initialize(std::string &resultsDir, std::string &error);
+    bool ClaimChunk(int &beginIndex, int &endIndex);
+    void Heartbeat();
+    void CompleteCombination(int comboIndex);
+    void ReleaseAll();
+
+    bool HoldsCombination(int comboIndex) const;
+    bool HasClaimableChunk();
+    bool AreAllChunksDone();
+    bool TryAcquireSummary();
+    void ReleaseSummary();
+
+    int GetChunkCount() const { return chunkCount; }
+    const std::string &GetWorkerId() const { return workerId; }
+
+    static std::string GetDefaultWorkerId();
+
+private:
+    std::string GetChunkPath(int chunkIndex, const char *extension) const;
+    bool IsLeaseExpired(const std::string &leasePath) const;
+    bool IsLeaseOwned(int chunkIndex) const;
+    bool IsChunkDone(int chunkIndex);
+    bool TryCreateLease(int chunkIndex);
+    bool TryReclaimLease(int chunkIndex);
+
+    std::string directory;
+    std::string workerId;
+    int combinationCount;
+    int chunkSize;
+    int chunkCount;
+    std::chrono::seconds leaseTimeout;
+    std::chrono::seconds heartbeatInterval;
+    std::chrono::steady_clock::time_point lastHeartbeat;
+
+    // Chunk index -> combinations of the chunk that have not been reported yet
+    std::map<int, int> heldChunks;
+
+    static const std::chrono::seconds RESCAN_INTERVAL;
+    std::set<int> doneChunks; // A .done file is never removed, so a chunk seen done is not checked again
+    std::chrono::steady_clock::time_point nextClaimScan;
+    std::chrono::steady_clock::time_point nextClaimableScan;
+    std::chrono::steady_clock::time_point nextDoneScan;
+    bool hasClaimableChunk = true;
+};
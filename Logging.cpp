@@ -1,6 +1,7 @@
 #include "Logging.hpp"
 #include "InputParameter.hpp"
 #include "ReportGenerator.hpp"
+#include "TradeMetrics.hpp"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
@@ -10,21 +11,32 @@ using json = nlohmann::json;
 
 Logging::Logging(SCStudyInterfaceRef sc) : sc(sc) {}
 
-void Logging::LogMetrics(SCStudyInterfaceRef sc, const std::string &strategyName, const std::string &reportPath, const std::vector<std::pair<std::string, double>> &params, int studyId)
+void Logging::LogMetrics(SCStudyInterfaceRef sc, const std::string &strategyName, const std::string &reportPath, const std::vector<std::pair<std::string, double>> &params, int studyId, int comboIndex, double replaySeconds)
 {
     std::filesystem::create_directories(std::filesystem::path(reportPath).parent_path());
 
-    std::ofstream log(reportPath, std::ios::app);
+    // Overwrites the report of an earlier attempt, a resumed run, a rerun shard or a reclaimed chunk replays into the same path
+    std::ofstream log(reportPath, std::ios::trunc);
     if (!log.is_open())
         return;
 
     json result;
+    result["status"] = "completed";
+    result["combinationIndex"] = comboIndex;
+    result["replaySeconds"] = replaySeconds; // Wall time of the replay, the baseline of the parity harness
     result["customStudyInformation"] = InputParameter::GetCustomStudyInformation(sc, studyId);
     result["combination"] = ReportGenerator::GetCombination(params);
     result["studyParameters"] = InputParameter::GetStudyParameters(sc, studyId);
     result["tradesData"] = ReportGenerator::GetTradesData(sc);
     result["tradeStatistics"] = ReportGenerator::GetTradeStatistics(sc);
 
+    TradeSeries series = TradeMetricsCalculator::GetTradeSeries(sc);
+    result["performanceMetrics"] = TradeMetricsCalculator::GetPerformanceMetrics(series);
+    result["dailyProfitLoss"] = TradeMetricsCalculator::GetDailyProfitLoss(series);
+
+    // RTH is the chart's day session
+    result["timeBuckets"] = TradeMetricsCalculator::GetTimeBuckets(series, sc.StartTime1, sc.EndTime1);
+
     log << result.dump(4);
 
     // csv
@@ -32,7 +44,7 @@ void Logging::LogMetrics(SCStudyInterfaceRef sc, const std::string &strategyName
     fileNameStream
         << reportPath << ".csv";
 
-    std::ofstream csvLog(fileNameStream.str(), std::ios::app);
+    std::ofstream csvLog(fileNameStream.str(), std::ios::trunc);
     if (!csvLog.is_open())
         return;
 
@@ -41,3 +53,23 @@ void Logging::LogMetrics(SCStudyInterfaceRef sc, const std::string &strategyName
     ReportGenerator::WriteTradeStatisticsV2(sc, csvLog);
     // csv
 }
+
+void Logging::LogFailure(SCStudyInterfaceRef sc, const std::string &reportPath, const std::vector<std::pair<std::string, double>> &params, int studyId, int comboIndex, const std::string &failureReason, int retries)
+{
+    std::filesystem::create_directories(std::filesystem::path(reportPath).parent_path());
+
+    std::ofstream log(reportPath, std::ios::trunc);
+    if (!log.is_open())
+        return;
+
+    json result;
+    result["status"] = "failed";
+    result["failureReason"] = failureReason;
+    result["retries"] = retries;
+    result["combinationIndex"] = comboIndex;
+    result["customStudyInformation"] = InputParameter::GetCustomStudyInformation(sc, studyId);
+    result["combination"] = ReportGenerator::GetCombination(params);
+    result["studyParameters"] = InputParameter::GetStudyParameters(sc, studyId);
+
+    log << result.dump(4);
+}
@@ -7,7 +7,8 @@
 class Logging {
 public:
     Logging(SCStudyInterfaceRef sc);
-    void LogMetrics(SCStudyInterfaceRef sc, const std::string& strategyName, const std::string& reportPath, const std::vector<std::pair<std::string, double>>& params, int studyId);
+    void LogMetrics(SCStudyInterfaceRef sc, const std::string& strategyName, const std::string& reportPath, const std::vector<std::pair<std::string, double>>& params, int studyId, int comboIndex, double replaySeconds);
+    void LogFailure(SCStudyInterfaceRef sc, const std::string& reportPath, const std::vector<std::pair<std::string, double>>& params, int studyId, int comboIndex, const std::string& failureReason, int retries);
 
 private:
     SCStudyInterfaceRef sc;
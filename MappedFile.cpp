@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "MappedFile.hpp"
+#include <windows.h>
+
+MappedFile::MappedFile()
+    : file(INVALID_HANDLE_VALUE),
+      mapping(NULL),
+      view(NULL),
+      size(0),
+      isOpen(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string &path, std::string &error)
+{
+    Close();
+
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        error = "Cannot open '" + path + "'.";
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        error = "Cannot read the size of '" + path + "'.";
+        Close();
+        return false;
+    }
+
+    // Windows cannot map an empty file
+    size = (size_t)fileSize.QuadPart;
+    if (size > 0)
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        view = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+        if (view == NULL)
+        {
+            error = "Cannot map '" + path + "'.";
+            Close();
+            return false;
+        }
+    }
+    isOpen = true;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (view != NULL)
+        UnmapViewOfFile(view);
+    if (mapping != NULL)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+    view = NULL;
+    size = 0;
+    isOpen = false;
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only mapping of a whole file. The file is shared for writing, so a writer may keep appending to it,
+// and the mapping covers the size it had when it was opened. The mapping is page aligned, an empty file has no data.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool Open(const std::string &path, std::string &error);
+    void Close();
+
+    const void *GetData() const { return view; }
+    size_t GetSize() const { return size; }
+    bool IsOpen() const { return isOpen; }
+
+private:
+    // Windows handles, kept opaque so windows.h stays out of the header
+    void *file;
+    void *mapping;
+    const void *view;
+    size_t size;
+    bool isOpen;
+};
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "MonteCarloResampler.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    const double PERCENTILES[] = {5.0, 25.0, 50.0, 75.0, 95.0};
+
+    // SplitMix64 finalizer, a bijective mix with full avalanche
+    uint64_t Mix(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    size_t DrawIndex(uint64_t draw, size_t count)
+    {
+        // Top 53 bits as a double in [0, 1)
+        return (std::min)((size_t)((double)(draw >> 11) * (1.0 / 9007199254740992.0) * (double)count), count - 1);
+    }
+
+    double GetPercentile(const std::vector<double> &sorted, double percentile)
+    {
+        size_t rank = (size_t)(percentile / 100.0 * (double)(sorted.size() - 1) + 0.5);
+        return sorted[(std::min)(rank, sorted.size() - 1)];
+    }
+
+    void RunResample(const std::vector<double> &profitLoss, const MonteCarloConfig &config, uint64_t stream, int r, std::vector<double> &sequence,
+                     std::vector<double> &maxDrawdowns, std::vector<double> &terminalProfitLosses, std::vector<char> &ruined)
+    {
+        size_t count = profitLoss.size();
+
+        if (config.Method == ResampleMethod::BOOTSTRAP)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                sequence[i] = profitLoss[DrawIndex(MonteCarloResampler::Draw(config.Seed, stream, r, i), count)];
+            }
+        }
+        else
+        {
+            // Fisher-Yates with the same counter-based draws
+            std::copy(profitLoss.begin(), profitLoss.end(), sequence.begin());
+            for (size_t i = count; i-- > 1;)
+            {
+                std::swap(sequence[i], sequence[DrawIndex(MonteCarloResampler::Draw(config.Seed, stream, r, i), i + 1)]);
+            }
+        }
+
+        double equity = 0.0;
+        double peak = 0.0;
+        double maxDrawdown = 0.0;
+        bool isRuined = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            equity += sequence[i];
+            peak = (std::max)(peak, equity);
+            maxDrawdown = (std::max)(maxDrawdown, peak - equity);
+            isRuined = isRuined || equity <= -config.RuinCapital;
+        }
+
+        maxDrawdowns[r] = maxDrawdown;
+        terminalProfitLosses[r] = equity;
+        ruined[r] = isRuined ? 1 : 0;
+    }
+}
+
+namespace MonteCarloResampler
+{
+    uint64_t Draw(uint64_t seed, uint64_t stream, uint64_t resample, uint64_t counter)
+    {
+        uint64_t key = Mix(seed ^ Mix(stream ^ Mix(resample)));
+        return Mix(key + counter * 0xD1B54A32D192ED03ULL);
+    }
+
+    MonteCarloResult Run(const std::vector<double> &profitLoss, const MonteCarloConfig &config, uint64_t stream)
+    {
+        MonteCarloResult result;
+        if (profitLoss.empty())
+        {
+            return result;
+        }
+        result.Percentiles.assign(std::begin(PERCENTILES), std::end(PERCENTILES));
+
+        std::vector<double> maxDrawdowns(config.Resamples);
+        std::vector<double> terminalProfitLosses(config.Resamples);
+        std::vector<char> ruined(config.Resamples);
+
+        // Each resample writes its own slot and each thread shuffles in its own buffer, so the threads share nothing
+        int threadCount = Parallel::GetThreadCount(config.Threads);
+        std::vector<std::vector<double>> sequences(threadCount, std::vector<double>(profitLoss.size()));
+        Parallel::ForEach(threadCount, config.Resamples, [&](int thread, int r)
+                          { RunResample(profitLoss, config, stream, r, sequences[thread], maxDrawdowns, terminalProfitLosses, ruined); });
+
+        result.Resamples = config.Resamples;
+        result.MeanMaxDrawdown = std::accumulate(maxDrawdowns.begin(), maxDrawdowns.end(), 0.0) / config.Resamples;
+        result.MeanTerminalProfitLoss = std::accumulate(terminalProfitLosses.begin(), terminalProfitLosses.end(), 0.0) / config.Resamples;
+        result.RiskOfRuin = (double)std::count(ruined.begin(), ruined.end(), 1) / config.Resamples;
+
+        std::sort(maxDrawdowns.begin(), maxDrawdowns.end());
+        std::sort(terminalProfitLosses.begin(), terminalProfitLosses.end());
+        for (double percentile : result.Percentiles)
+        {
+            result.MaxDrawdownPercentiles.push_back(GetPercentile(maxDrawdowns, percentile));
+            result.TerminalProfitLossPercentiles.push_back(GetPercentile(terminalProfitLosses, percentile));
+        }
+        return result;
+    }
+
+    json ToJson(const MonteCarloResult &result, const MonteCarloConfig &config)
+    {
+        json maxDrawdown = {{"Mean", result.MeanMaxDrawdown}};
+        json terminalProfitLoss = {{"Mean", result.MeanTerminalProfitLoss}};
+        for (size_t i = 0; i < result.Percentiles.size(); ++i)
+        {
+            std::string key = "P" + std::to_string((int)result.Percentiles[i]);
+            maxDrawdown[key] = result.MaxDrawdownPercentiles[i];
+            terminalProfitLoss[key] = result.TerminalProfitLossPercentiles[i];
+        }
+
+        return {
+            {"Method", config.Method == ResampleMethod::BOOTSTRAP ? "bootstrap" : "permutation"},
+            {"Resamples", result.Resamples},
+            {"Seed", config.Seed},
+            {"RuinCapital", config.RuinCapital},
+            {"RiskOfRuin", result.RiskOfRuin},
+            {"MaxDrawdown", maxDrawdown},
+            {"TerminalProfitLoss", terminalProfitLoss}};
+    }
+}
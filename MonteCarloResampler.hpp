@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include "nlohmann/json.hpp"
+#include <vector>
+#include <cstdint>
+
+using json = nlohmann::json;
+
+struct MonteCarloResult
+{
+    int Resamples = 0;
+    std::vector<double> Percentiles;
+    std::vector<double> MaxDrawdownPercentiles;
+    std::vector<double> TerminalProfitLossPercentiles;
+    double MeanMaxDrawdown = 0.0;
+    double MeanTerminalProfitLoss = 0.0;
+    double RiskOfRuin = 0.0;
+};
+
+// Resamples the trade sequence of one combination. Every draw comes from a counter-based generator keyed by
+// (seed, stream, resample, draw), so the outcome does not depend on the thread count or on scheduling.
+namespace MonteCarloResampler
+{
+    uint64_t Draw(uint64_t seed, uint64_t stream, uint64_t resample, uint64_t counter);
+    MonteCarloResult Run(const std::vector<double> &profitLoss, const MonteCarloConfig &config, uint64_t stream);
+    json ToJson(const MonteCarloResult &result, const MonteCarloConfig &config);
+}
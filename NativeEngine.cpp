@@ -0,0 +1,258 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "NativeEngine.hpp"
+#include "IndicatorKernels.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // Spans a plug-in state was handed, kept alive until the state is destroyed
+    struct IndicatorHost
+    {
+        const NativeEngine *Engine;
+        std::vector<IndicatorSpan> Spans;
+    };
+
+    // What each kind reads, only that goes into its cache key
+    struct IndicatorKind
+    {
+        int Kind;
+        const char *Name;
+        bool UsesSource;
+        bool UsesLength;
+        bool UsesParameter;
+    };
+
+    const IndicatorKind INDICATOR_KINDS[] = {
+        {SO_INDICATOR_SMA, "SMA", true, true, false},
+        {SO_INDICATOR_EMA, "EMA", true, true, false},
+        {SO_INDICATOR_WMA, "WMA", true, true, false},
+        {SO_INDICATOR_ATR, "ATR", false, true, false},
+        {SO_INDICATOR_RSI, "RSI", true, true, false},
+        {SO_INDICATOR_BOLLINGER_UPPER, "BollingerUpper", true, true, true},
+        {SO_INDICATOR_BOLLINGER_LOWER, "BollingerLower", true, true, true},
+        {SO_INDICATOR_VWAP, "VWAP", false, true, false},
+        {SO_INDICATOR_SESSION_VWAP, "SessionVWAP", false, false, false},
+        {SO_INDICATOR_HIGHEST, "Highest", true, true, false},
+        {SO_INDICATOR_LOWEST, "Lowest", true, true, false},
+        {SO_INDICATOR_ZSCORE, "ZScore", true, true, false},
+    };
+
+    const IndicatorKind *FindIndicatorKind(int kind)
+    {
+        for (const IndicatorKind &indicatorKind : INDICATOR_KINDS)
+        {
+            if (indicatorKind.Kind == kind)
+                return &indicatorKind;
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    ColumnSpan<T> ToSpan(const std::vector<T> &values)
+    {
+        return {values.data(), values.size()};
+    }
+
+    ColumnSpan<float> GetSource(const BarSeries &bars, int source)
+    {
+        switch (source)
+        {
+        case SO_SOURCE_CLOSE:
+            return ToSpan(bars.Close);
+        case SO_SOURCE_OPEN:
+            return ToSpan(bars.Open);
+        case SO_SOURCE_HIGH:
+            return ToSpan(bars.High);
+        case SO_SOURCE_LOW:
+            return ToSpan(bars.Low);
+        default:
+            throw std::invalid_argument("Unknown indicator source " + std::to_string(source) + ".");
+        }
+    }
+
+    // Called by the plug-in, so nothing may throw across it
+    const float *GetHostIndicator(void *host, int32_t kind, int32_t source, int32_t length, double parameter)
+    {
+        IndicatorHost &indicatorHost = *static_cast<IndicatorHost *>(host);
+        try
+        {
+            if (length < 1)
+                return nullptr;
+            IndicatorSpan span = indicatorHost.Engine->GetIndicator(kind, source, length, parameter);
+            for (const IndicatorSpan &held : indicatorHost.Spans)
+            {
+                if (held.Values.Data == span.Values.Data)
+                    return held.Values.Data;
+            }
+            indicatorHost.Spans.push_back(span);
+            return span.Values.Data;
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+bool NativeEngine::Open(const NativeConfig &nativeConfig, std::string &error)
+{
+    config = nativeConfig;
+    if (!ColumnarCache::Update(config.ScidPath, error) || !ticks.Open(config.ScidPath, error))
+        return false;
+
+    std::vector<BarSeries> series;
+    if (!BarAggregator::Load(config.ScidPath, {config.Bars}, config.Session, series, error))
+        return false;
+    bars = std::move(series.front());
+
+    if (!plugin.Load(config.PluginPath, error))
+        return false;
+
+    seriesId = config.ScidPath + "-" + config.Bars.GetKey() + "-" + std::to_string(config.Session.StartSeconds) + "-" + std::to_string(config.Session.EndSeconds);
+    indicators.reset(new IndicatorCache((size_t)config.IndicatorCacheMegabytes * 1024 * 1024));
+
+    // Bars with the same start, which volume and range bars can have, get the ticks of that date time with the later bar
+    barDateTimes.resize(bars.GetSize());
+    barFirstTicks.resize(bars.GetSize());
+    barEndTicks.resize(bars.GetSize());
+    for (size_t i = 0; i < bars.GetSize(); ++i)
+    {
+        barDateTimes[i] = bars.DateTime[i].GetAsDouble();
+        barFirstTicks[i] = ticks.LowerBound(bars.DateTime[i]);
+    }
+
+    // A bar ends where the next one starts, or at the end of its session, so ticks the chart leaves out between
+    // sessions never work orders
+    size_t sessionEndTick = 0;
+    sessionFirstBars.clear();
+    for (size_t i = 0; i < bars.GetSize(); ++i)
+    {
+        if (i == 0 || barFirstTicks[i] >= sessionEndTick)
+        {
+            sessionEndTick = ticks.LowerBound(config.Session.GetSessionEnd(bars.DateTime[i]));
+            sessionFirstBars.push_back(i);
+        }
+        size_t nextBarTick = i + 1 < bars.GetSize() ? barFirstTicks[i + 1] : ticks.GetRecordCount();
+        barEndTicks[i] = (std::max)(barFirstTicks[i], (std::min)(nextBarTick, sessionEndTick));
+    }
+    return true;
+}
+
+IndicatorSpan NativeEngine::GetIndicator(int kind, int source, int length, double parameter) const
+{
+    const IndicatorKind *indicatorKind = FindIndicatorKind(kind);
+    if (indicatorKind == nullptr)
+        throw std::invalid_argument("Unknown indicator kind " + std::to_string(kind) + ".");
+
+    // Parameters the kind does not read are left out of the key, so requests differing only there share the series
+    IndicatorKey key;
+    key.Kind = indicatorKind->Name;
+    if (indicatorKind->UsesSource)
+        key.Parameters.push_back(source);
+    if (indicatorKind->UsesLength)
+        key.Parameters.push_back(length);
+    if (indicatorKind->UsesParameter)
+        key.Parameters.push_back(parameter);
+    key.SeriesId = seriesId;
+    return indicators->Get(key, [&]()
+                           { return ComputeIndicator(kind, source, length, parameter); });
+}
+
+std::vector<float> NativeEngine::ComputeIndicator(int kind, int source, int length, double parameter) const
+{
+    ColumnSpan<float> high = ToSpan(bars.High);
+    ColumnSpan<float> low = ToSpan(bars.Low);
+    ColumnSpan<float> close = ToSpan(bars.Close);
+    ColumnSpan<uint32_t> volume = ToSpan(bars.Volume);
+    std::vector<int> lengths = {length};
+    switch (kind)
+    {
+    case SO_INDICATOR_SMA:
+        return std::move(IndicatorKernels::Sma(GetSource(bars, source), lengths).front());
+    case SO_INDICATOR_EMA:
+        return std::move(IndicatorKernels::Ema(GetSource(bars, source), lengths).front());
+    case SO_INDICATOR_WMA:
+        return std::move(IndicatorKernels::Wma(GetSource(bars, source), lengths).front());
+    case SO_INDICATOR_ATR:
+        return std::move(IndicatorKernels::Atr(high, low, close, lengths).front());
+    case SO_INDICATOR_RSI:
+        return std::move(IndicatorKernels::Rsi(GetSource(bars, source), lengths).front());
+    case SO_INDICATOR_BOLLINGER_UPPER:
+        return std::move(IndicatorKernels::Bollinger(GetSource(bars, source), lengths, (float)parameter).front().Upper);
+    case SO_INDICATOR_BOLLINGER_LOWER:
+        return std::move(IndicatorKernels::Bollinger(GetSource(bars, source), lengths, (float)parameter).front().Lower);
+    case SO_INDICATOR_VWAP:
+        return std::move(IndicatorKernels::Vwap(high, low, close, volume, lengths).front());
+    case SO_INDICATOR_SESSION_VWAP:
+        return IndicatorKernels::AnchoredVwap(high, low, close, volume, sessionFirstBars);
+    case SO_INDICATOR_HIGHEST:
+        return std::move(IndicatorKernels::RollingHigh(GetSource(bars, source), lengths).front());
+    case SO_INDICATOR_LOWEST:
+        return std::move(IndicatorKernels::RollingLow(GetSource(bars, source), lengths).front());
+    case SO_INDICATOR_ZSCORE:
+        return std::move(IndicatorKernels::ZScore(GetSource(bars, source), lengths).front());
+    default:
+        throw std::invalid_argument("Unknown indicator kind " + std::to_string(kind) + ".");
+    }
+}
+
+bool NativeEngine::Run(const std::vector<InputConfig> &inputs, const std::vector<double> &combination, const SCDateTimeMS &startDateTime, const SCDateTimeMS &endDateTime,
+                       FillSimulator &simulator, std::vector<s_ACSTrade> &trades, std::string &error) const
+{
+    // Declared before the state, so the spans outlive it
+    IndicatorHost indicatorHost = {this, {}};
+    StrategyInstance instance;
+    if (!instance.Create(plugin, inputs, combination, error))
+        return false;
+
+    bool toEnd = endDateTime.GetAsDouble() == 0.0;
+    size_t firstTradingBar = std::lower_bound(barDateTimes.begin(), barDateTimes.end(), startDateTime.GetAsDouble()) - barDateTimes.begin();
+    size_t endBar = toEnd ? barDateTimes.size() : std::lower_bound(barDateTimes.begin(), barDateTimes.end(), endDateTime.GetAsDouble()) - barDateTimes.begin();
+    size_t endTick = toEnd ? ticks.GetRecordCount() : ticks.LowerBound(endDateTime);
+
+    SoBarContext context = {};
+    context.DateTime = barDateTimes.data();
+    context.Open = bars.Open.data();
+    context.High = bars.High.data();
+    context.Low = bars.Low.data();
+    context.Close = bars.Close.data();
+    context.NumTrades = bars.NumTrades.data();
+    context.Volume = bars.Volume.data();
+    context.BidVolume = bars.BidVolume.data();
+    context.AskVolume = bars.AskVolume.data();
+    context.Host = &indicatorHost;
+    context.GetIndicator = GetHostIndicator;
+
+    simulator.Reset();
+    std::vector<SoOrderRequest> orders;
+    orders.reserve(StrategyInstance::MAX_ORDERS_PER_BAR);
+    for (size_t i = 0; i < endBar; ++i)
+    {
+        // The bar closes once its ticks have worked the orders of the previous bar
+        if (i >= firstTradingBar)
+            simulator.Process(ticks, barFirstTicks[i], (std::min)(barEndTicks[i], endTick));
+
+        context.BarCount = i + 1;
+        context.PositionQuantity = simulator.GetPositionQuantity();
+        context.WorkingOrderCount = simulator.GetWorkingOrderCount();
+        context.AveragePrice = simulator.GetAveragePrice();
+        context.ClosedProfitLoss = simulator.GetClosedProfitLoss() / config.Fill.PointValue; // The simulator counts currency
+        if (!instance.OnBar(context, orders))
+            break;
+
+        if (i < firstTradingBar)
+            continue;
+
+        // A rejected request is dropped, as Sierra Chart drops an order it cannot accept
+        for (const SoOrderRequest &order : orders)
+        {
+            simulator.Submit(order);
+        }
+    }
+
+    simulator.TakeTrades(trades);
+    return true;
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "ConfigManager.hpp"
+#include "ColumnarCache.hpp"
+#include "BarAggregator.hpp"
+#include "FillSimulator.hpp"
+#include "StrategyPlugin.hpp"
+#include "IndicatorCache.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Evaluates combinations of a strategy plug-in on the bars of one .scid file, in place of a chart replay.
+//
+// The strategy sees every bar from the start of the data, so its indicators are warmed up as on the chart, but orders
+// are only taken from bars that start inside the replay range. Orders of a bar work from the first tick of the next bar.
+// Positions still open at the end of the range are left open, like a replay that stops, so they have no trade.
+//
+// Open loads the data once. Run only reads it, so combinations may run on different threads at once, each thread
+// with its own simulator built from GetFillConfig. Indicators a plug-in asks for through SoBarContext.GetIndicator are
+// computed once per kind and parameters and shared by every combination run on this engine's bars.
+class NativeEngine
+{
+public:
+    NativeEngine() = default;
+    NativeEngine(const NativeEngine &) = delete;
+    NativeEngine &operator=(const NativeEngine &) = delete;
+
+    bool Open(const NativeConfig &config, std::string &error);
+
+    // Closed trades of one combination over startDateTime <= DateTime < endDateTime, a zero end runs to the end of the data.
+    // The simulator is reset first, so one simulator serves every combination a thread runs.
+    bool Run(const std::vector<InputConfig> &inputs, const std::vector<double> &combination, const SCDateTimeMS &startDateTime, const SCDateTimeMS &endDateTime,
+             FillSimulator &simulator, std::vector<s_ACSTrade> &trades, std::string &error) const;
+
+    size_t GetBarCount() const { return bars.GetSize(); }
+    const FillConfig &GetFillConfig() const { return config.Fill; }
+
+    // Values of an SO_INDICATOR_* kind over every bar, from the cache or computed by IndicatorKernels into it.
+    // Throws std::invalid_argument for an unknown kind or source.
+    IndicatorSpan GetIndicator(int kind, int source, int length, double parameter) const;
+
+private:
+    std::vector<float> ComputeIndicator(int kind, int source, int length, double parameter) const;
+
+    NativeConfig config;
+    StrategyPlugin plugin;
+    ColumnarCache ticks;
+    BarSeries bars;
+    std::vector<double> barDateTimes; // SoBarContext takes date times as plain days
+    std::vector<size_t> barFirstTicks; // Tick of each bar's start
+    std::vector<size_t> barEndTicks;   // One past each bar's last tick, ticks outside the chart's session are in no bar
+    std::vector<size_t> sessionFirstBars; // Anchors of the session VWAP
+    std::string seriesId;              // The bars indicators are keyed on, data file, bar spec and session
+    std::unique_ptr<IndicatorCache> indicators;
+};
@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Static striping of independent work items over plain threads, for the analysis stages that run after a sweep.
+namespace Parallel
+{
+    // A configured count of 0 means every core
+    inline int GetThreadCount(int configured)
+    {
+        return configured > 0 ? configured : (int)(std::max)(1u, std::thread::hardware_concurrency());
+    }
+
+    // Calls fn(thread, item) for every item, item i always runs on thread i % threadCount
+    template <typename Fn>
+    void ForEach(int threadCount, int count, Fn fn)
+    {
+        threadCount = (std::min)(threadCount, count);
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threadCount; ++t)
+        {
+            workers.emplace_back([&fn, t, threadCount, count]()
+                                 {
+                                     for (int i = t; i < count; i += threadCount)
+                                         fn(t, i); });
+        }
+        for (int i = 0; i < count; i += (std::max)(threadCount, 1))
+        {
+            fn(0, i);
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "ParetoFront.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    // Only called with a point that sorts after 'a', so weak dominance is enough
+    bool Dominates(const std::vector<double> &a, const std::vector<double> &b)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i] < b[i])
+                return false;
+        }
+        return true;
+    }
+
+    bool IsDominatedByFront(const std::vector<std::vector<double>> &points, const std::vector<int> &front, const std::vector<double> &point)
+    {
+        // Within a two objective front the second objective rises along the sort order, the last member is the strongest
+        if (point.size() == 2)
+        {
+            return points[front.back()][1] >= point[1];
+        }
+
+        for (auto it = front.rbegin(); it != front.rend(); ++it)
+        {
+            if (Dominates(points[*it], point))
+                return true;
+        }
+        return false;
+    }
+}
+
+namespace ParetoFront
+{
+    std::vector<int> RankFronts(const std::vector<std::vector<double>> &points, int maxFronts)
+    {
+        std::vector<int> ranks(points.size(), 0);
+        if (points.empty())
+        {
+            return ranks;
+        }
+
+        // Descending lexicographic order, a point can only be dominated by points before it
+        std::vector<int> order(points.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&points](int a, int b)
+                  { return points[a] > points[b]; });
+
+        std::vector<std::vector<int>> fronts;
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            int index = order[i];
+
+            // Identical objective vectors do not dominate each other and share a front
+            if (i > 0 && points[index] == points[order[i - 1]])
+            {
+                ranks[index] = ranks[order[i - 1]];
+                if (ranks[index] > 0)
+                    fronts[ranks[index] - 1].push_back(index);
+                continue;
+            }
+
+            // If a front dominates the point, every earlier front does too
+            size_t low = 0;
+            size_t high = fronts.size();
+            while (low < high)
+            {
+                size_t mid = (low + high) / 2;
+                if (IsDominatedByFront(points, fronts[mid], points[index]))
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+
+            // Points past the last requested front cannot change the fronts before it
+            if (maxFronts > 0 && (int)low >= maxFronts)
+                continue;
+
+            if (low == fronts.size())
+                fronts.emplace_back();
+            fronts[low].push_back(index);
+            ranks[index] = (int)low + 1;
+        }
+
+        return ranks;
+    }
+}
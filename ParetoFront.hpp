@@ -0,0 +1,15 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include <vector>
+
+// Non-dominated sorting of points where every objective is maximized.
+// Points are sorted lexicographically once, then each point is placed with a binary search over the fronts
+// found so far. With two objectives a front is checked against its last member only, which is O(n log n).
+// With more objectives each probe scans the front, which stays close to O(n log n) for typical result sets.
+namespace ParetoFront
+{
+    // Returns the 1-based front of every point, or 0 for points beyond maxFronts (0 ranks every front).
+    std::vector<int> RankFronts(const std::vector<std::vector<double>> &points, int maxFronts);
+}
@@ -0,0 +1,323 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "ParityHarness.hpp"
+#include "NativeEngine.hpp"
+#include "CombinationGenerator.hpp"
+#include "TradeMetrics.hpp"
+#include "OnChartLogging.hpp"
+#include "Enum.hpp"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct Mismatch
+    {
+        int Trade; // -1 for the trade count and the metrics
+        std::string Field;
+        double Reference;
+        double Native;
+    };
+
+    struct ParityRow
+    {
+        int ComboIndex = -1;
+        std::string SourceFile;
+        std::string Status;
+        int ReferenceTrades = 0;
+        int NativeTrades = 0;
+        int MismatchedTrades = 0;
+        int MismatchedMetrics = 0;
+        double ReferenceProfitLoss = 0.0;
+        double NativeProfitLoss = 0.0;
+        double ReplaySeconds = 0.0;
+        double NativeSeconds = 0.0;
+        std::vector<Mismatch> Mismatches;
+    };
+
+    // Report date times are written with FLAG_DT_COMPLETE_DATETIME, a date and a time separated by a space
+    double ParseReportDateTime(SCStudyInterfaceRef sc, const std::string &text)
+    {
+        size_t separator = text.find(' ');
+        SCDateTime date = sc.DateStringToSCDateTime(text.substr(0, separator).c_str());
+        if (separator == std::string::npos)
+            return date.GetAsDouble();
+        SCDateTime time = sc.TimeStringToSCDateTime(text.substr(separator + 1).c_str());
+        return date.GetAsDouble() + time.GetAsDouble();
+    }
+
+    void AddMismatch(ParityRow &row, int maxMismatches, int trade, const char *field, double reference, double native)
+    {
+        if ((int)row.Mismatches.size() < maxMismatches)
+            row.Mismatches.push_back({trade, field, reference, native});
+    }
+
+    // Trades are compared in list order, a missing or extra trade shifts everything after it, which the count mismatch shows
+    void CompareTrades(SCStudyInterfaceRef sc, const json &referenceTrades, const std::vector<s_ACSTrade> &nativeTrades, const StrategyOptimizerConfig &config, ParityRow &row)
+    {
+        const ParityConfig &parity = config.ParityConfig;
+        double timeTolerance = parity.TimeToleranceSeconds / SECONDS_PER_DAY;
+        double priceTolerance = parity.PriceToleranceTicks * config.NativeConfig.Fill.TickSize + 1e-9;
+
+        std::vector<const s_ACSTrade *> closedTrades;
+        for (const s_ACSTrade &trade : nativeTrades)
+        {
+            if (trade.IsTradeClosed)
+                closedTrades.push_back(&trade);
+        }
+        row.ReferenceTrades = (int)referenceTrades.size();
+        row.NativeTrades = (int)closedTrades.size();
+        if (row.ReferenceTrades != row.NativeTrades)
+        {
+            AddMismatch(row, parity.MaxMismatchesPerCombination, -1, "TradeCount", row.ReferenceTrades, row.NativeTrades);
+        }
+
+        int common = (std::min)(row.ReferenceTrades, row.NativeTrades);
+        for (int i = 0; i < common; ++i)
+        {
+            const json &reference = referenceTrades[i];
+            const s_ACSTrade &native = *closedTrades[i];
+            bool mismatched = false;
+            auto check = [&](const char *field, double referenceValue, double nativeValue, double tolerance)
+            {
+                if (std::fabs(referenceValue - nativeValue) > tolerance)
+                {
+                    mismatched = true;
+                    AddMismatch(row, parity.MaxMismatchesPerCombination, i, field, referenceValue, nativeValue);
+                }
+            };
+
+            check("TradeType", reference.value("TradeType", 0), native.TradeType, 0.0);
+            check("TradeQuantity", reference.value("TradeQuantity", 0), native.TradeQuantity, 0.0);
+            check("OpenDateTime", ParseReportDateTime(sc, reference.value("OpenDateTime", "")), native.OpenDateTime.GetAsDouble(), timeTolerance);
+            check("CloseDateTime", ParseReportDateTime(sc, reference.value("CloseDateTime", "")), native.CloseDateTime.GetAsDouble(), timeTolerance);
+            check("EntryPrice", reference.value("EntryPrice", 0.0), native.EntryPrice, priceTolerance);
+            check("ExitPrice", reference.value("ExitPrice", 0.0), native.ExitPrice, priceTolerance);
+            check("TradeProfitLoss", reference.value("TradeProfitLoss", 0.0), native.TradeProfitLoss, parity.ProfitLossTolerance);
+            row.MismatchedTrades += mismatched ? 1 : 0;
+        }
+        row.MismatchedTrades += std::abs(row.ReferenceTrades - row.NativeTrades);
+    }
+
+    // The report holds the metrics of the replay's trades computed by the same code, so equal trades give equal metrics
+    void CompareMetrics(const json &report, const TradeMetrics &nativeMetrics, const ParityConfig &parity, ParityRow &row)
+    {
+        if (!report.contains("performanceMetrics") || !report["performanceMetrics"].contains("Combined"))
+            return;
+
+        const json &reference = report["performanceMetrics"]["Combined"];
+        json native = TradeMetricsCalculator::ToJson(nativeMetrics);
+        for (auto it = native.begin(); it != native.end(); ++it)
+        {
+            if (!reference.contains(it.key()) || !reference[it.key()].is_number())
+                continue;
+
+            double referenceValue = reference[it.key()].get<double>();
+            double nativeValue = it.value().get<double>();
+            double scale = (std::max)(1.0, (std::max)(std::fabs(referenceValue), std::fabs(nativeValue)));
+            if (std::fabs(referenceValue - nativeValue) > parity.MetricTolerance * scale)
+            {
+                row.MismatchedMetrics++;
+                AddMismatch(row, parity.MaxMismatchesPerCombination, -1, it.key().c_str(), referenceValue, nativeValue);
+            }
+        }
+    }
+
+    // Values of every input for the reference combination, the varying ones found by the input names the report was
+    // written with
+    bool GetReferenceCombination(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config, const json &report, std::vector<double> &combination, std::string &error)
+    {
+        unsigned int studyId = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+        const json &values = report.contains("combination") ? report["combination"] : json::object();
+        std::vector<double> varying;
+        for (const InputConfig &input : config.ParamConfigs)
+        {
+            if (std::fabs(input.Increment) <= 1e-9)
+                continue;
+
+            SCString inputName;
+            sc.GetStudyInputName(sc.ChartNumber, studyId, input.Index, inputName);
+            if (!values.contains(inputName.GetChars()) || !values[inputName.GetChars()].is_number())
+            {
+                error = std::string("the report has no value for input '") + inputName.GetChars() + "'";
+                return false;
+            }
+            varying.push_back(values[inputName.GetChars()].get<double>());
+        }
+        combination = CombinationGenerator::ExpandCombination(config.ParamConfigs, varying);
+        return true;
+    }
+
+    void WriteParityReport(const std::vector<ParityRow> &rows, const std::string &parityPath, const std::string &mismatchesPath)
+    {
+        std::ofstream parityFile(parityPath, std::ios::trunc);
+        parityFile << "Combination Index,Status,Reference Trades,Native Trades,Mismatched Trades,Mismatched Metrics,Reference P/L,Native P/L,Replay Seconds,Native Seconds,Speedup,Source File\n";
+        parityFile << std::fixed << std::setprecision(4);
+        for (const ParityRow &row : rows)
+        {
+            parityFile << row.ComboIndex << "," << row.Status << "," << row.ReferenceTrades << "," << row.NativeTrades << ","
+                       << row.MismatchedTrades << "," << row.MismatchedMetrics << "," << row.ReferenceProfitLoss << "," << row.NativeProfitLoss << ","
+                       << row.ReplaySeconds << "," << row.NativeSeconds << ",";
+            if (row.ReplaySeconds > 0.0 && row.NativeSeconds > 0.0)
+                parityFile << row.ReplaySeconds / row.NativeSeconds;
+            parityFile << ",\"" << row.SourceFile << "\"\n";
+        }
+
+        std::ofstream mismatchesFile(mismatchesPath, std::ios::trunc);
+        mismatchesFile << "Combination Index,Trade,Field,Reference,Native\n";
+        mismatchesFile << std::setprecision(10);
+        for (const ParityRow &row : rows)
+        {
+            for (const Mismatch &mismatch : row.Mismatches)
+            {
+                mismatchesFile << row.ComboIndex << "," << mismatch.Trade << "," << mismatch.Field << "," << mismatch.Reference << "," << mismatch.Native << "\n";
+            }
+        }
+    }
+}
+
+namespace ParityHarness
+{
+    bool Run(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config)
+    {
+        SCString msg;
+        const ParityConfig &parity = config.ParityConfig;
+
+        NativeEngine engine;
+        std::string error;
+        if (!engine.Open(config.NativeConfig, error))
+        {
+            msg.Format("Parity: the native engine could not be opened: %s", error.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            return false;
+        }
+        msg.Format("Parity: native engine opened on %d bars, comparing against '%s'.", (int)engine.GetBarCount(), parity.ReferenceDirectory.c_str());
+        OnChartLogging::AddLog(sc, msg);
+
+        std::vector<fs::path> reportPaths;
+        for (const auto &entry : fs::directory_iterator(parity.ReferenceDirectory))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".json")
+                reportPaths.push_back(entry.path());
+        }
+        std::sort(reportPaths.begin(), reportPaths.end());
+
+        // Combinations run one after another, so the native time of each is not shared with the others
+        std::vector<ParityRow> rows;
+        FillSimulator simulator(engine.GetFillConfig());
+        std::vector<s_ACSTrade> trades;
+        for (const fs::path &reportPath : reportPaths)
+        {
+            ParityRow row;
+            row.SourceFile = reportPath.string();
+
+            json report;
+            try
+            {
+                std::ifstream reportFile(reportPath);
+                reportFile >> report;
+            }
+            catch (const std::exception &e)
+            {
+                msg.Format("Parity: skipped '%s', it is not a readable report: %s", row.SourceFile.c_str(), e.what());
+                OnChartLogging::AddLog(sc, msg);
+                continue;
+            }
+            if (report.value("status", "") != "completed" || !report.contains("tradesData"))
+                continue;
+
+            row.ComboIndex = report.value("combinationIndex", -1);
+            row.ReplaySeconds = report.value("replaySeconds", 0.0);
+            for (const json &trade : report["tradesData"])
+            {
+                row.ReferenceProfitLoss += trade.value("TradeProfitLoss", 0.0);
+            }
+
+            std::vector<double> combination;
+            if (!GetReferenceCombination(sc, config, report, combination, error))
+            {
+                row.Status = "skipped";
+                msg.Format("Parity: combination %d skipped, %s.", row.ComboIndex, error.c_str());
+                OnChartLogging::AddLog(sc, msg);
+                rows.push_back(row);
+                continue;
+            }
+
+            auto started = std::chrono::steady_clock::now();
+            bool ran = engine.Run(config.ParamConfigs, combination, config.ReplayConfig.StartDateTime, config.ReplayConfig.EndDateTime, simulator, trades, error);
+            row.NativeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            if (!ran)
+            {
+                row.Status = "failed";
+                msg.Format("Parity: combination %d failed natively: %s", row.ComboIndex, error.c_str());
+                OnChartLogging::AddLog(sc, msg);
+                rows.push_back(row);
+                continue;
+            }
+
+            TradeSeries series = TradeMetricsCalculator::GetTradeSeries(trades);
+            TradeMetrics nativeMetrics = TradeMetricsCalculator::Calculate(series);
+            row.NativeProfitLoss = nativeMetrics.TotalProfitLoss;
+            CompareTrades(sc, report["tradesData"], trades, config, row);
+            CompareMetrics(report, nativeMetrics, parity, row);
+            row.Status = row.MismatchedTrades == 0 && row.MismatchedMetrics == 0 ? "match" : "mismatch";
+            rows.push_back(row);
+        }
+
+        if (rows.empty())
+        {
+            msg.Format("Parity: no completed reports found in '%s'.", parity.ReferenceDirectory.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            return false;
+        }
+
+        std::sort(rows.begin(), rows.end(), [](const ParityRow &a, const ParityRow &b)
+                  { return a.ComboIndex < b.ComboIndex; });
+
+        unsigned int studyId = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+        n_ACSIL::s_CustomStudyInformation customStudyInfo;
+        sc.GetCustomStudyInformation(sc.ChartNumber, studyId, customStudyInfo);
+        std::string prefix = (fs::path(parity.ReferenceDirectory) / customStudyInfo.DLLFileName.GetChars()).string();
+        WriteParityReport(rows, prefix + "-parity.csv", prefix + "-parity-mismatches.csv");
+
+        int matched = 0;
+        int compared = 0;
+        std::vector<double> speedups;
+        for (const ParityRow &row : rows)
+        {
+            if (row.Status != "match" && row.Status != "mismatch")
+                continue;
+            compared++;
+            matched += row.Status == "match" ? 1 : 0;
+            if (row.ReplaySeconds > 0.0 && row.NativeSeconds > 0.0)
+                speedups.push_back(row.ReplaySeconds / row.NativeSeconds);
+        }
+
+        if (speedups.empty())
+        {
+            msg.Format("Parity: %d of %d combinations match, the reports have no replay times to measure the speedup against.", matched, compared);
+        }
+        else
+        {
+            std::nth_element(speedups.begin(), speedups.begin() + speedups.size() / 2, speedups.end());
+            msg.Format("Parity: %d of %d combinations match, median speedup %.1fx over %d timed replays.", matched, compared, speedups[speedups.size() / 2], (int)speedups.size());
+        }
+        OnChartLogging::AddLog(sc, msg);
+        msg.Format("Parity report generated at: %s-parity.csv", prefix.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return compared > 0;
+    }
+}
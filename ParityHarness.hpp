@@ -0,0 +1,18 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "ConfigManager.hpp"
+
+// Checks the native engine against real replays. Every completed report in the reference folder is re-run natively with the
+// same combination, its closed trades are compared one by one (times, prices, quantity, P/L) and its performance metrics
+// key by key, within the tolerances of parityConfig. The replay time of the report over the native time is the speedup.
+//
+// Results go next to the reference reports: <dll>-parity.csv with one row per combination, and
+// <dll>-parity-mismatches.csv with the first mismatches of each combination.
+namespace ParityHarness
+{
+    // False when the engine could not be opened or no report could be compared
+    bool Run(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config);
+}
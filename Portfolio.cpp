@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "Portfolio.hpp"
+#include "InputParameter.hpp"
+#include "ReportGenerator.hpp"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+using json = nlohmann::json;
+
+namespace
+{
+    // The statistics the analyzer reads from Sierra Chart's trade statistics, computed for the merged trades
+    json GetPortfolioStatistics(const std::vector<s_ACSTrade> &trades, const TradeMetrics &metrics)
+    {
+        double grossProfit = 0.0;
+        double grossLoss = 0.0;
+        int profitable = 0;
+        for (const s_ACSTrade &trade : trades)
+        {
+            grossProfit += trade.TradeProfitLoss > 0.0 ? trade.TradeProfitLoss : 0.0;
+            grossLoss += trade.TradeProfitLoss < 0.0 ? trade.TradeProfitLoss : 0.0;
+            profitable += trade.TradeProfitLoss > 0.0 ? 1 : 0;
+        }
+
+        return {
+            {"ClosedTradesProfitLoss", metrics.TotalProfitLoss},
+            {"ProfitFactor", grossLoss < 0.0 ? grossProfit / -grossLoss : 0.0},
+            {"TotalTrades", (int)trades.size()},
+            {"PercentProfitable", trades.empty() ? 0.0 : (double)profitable / trades.size()},
+            {"MaximumDrawdown", metrics.MaximumDrawdown}};
+    }
+}
+
+namespace Portfolio
+{
+    std::string GetSymbolFileName(const std::string &symbol)
+    {
+        std::string fileName = symbol;
+        for (char &c : fileName)
+        {
+            if (c == '.' || c == '/' || c == '\\' || c == ':' || c == '*' || c == '?' || c == '"' || c == '<' || c == '>' || c == '|' || c == ' ')
+                c = '-';
+        }
+        return fileName;
+    }
+
+    std::vector<s_ACSTrade> MergeTrades(const std::vector<PortfolioSymbol> &symbols, std::vector<int> &symbolOfTrade)
+    {
+        std::vector<s_ACSTrade> trades;
+        symbolOfTrade.clear();
+        for (int symbol = 0; symbol < (int)symbols.size(); ++symbol)
+        {
+            for (const s_ACSTrade &trade : symbols[symbol].Trades)
+            {
+                if (!trade.IsTradeClosed)
+                    continue;
+                trades.push_back(trade);
+                symbolOfTrade.push_back(symbol);
+            }
+        }
+
+        // Trades arrive symbol by symbol, a stable sort keeps the symbol order among equal close times
+        std::vector<int> order(trades.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&trades](int a, int b)
+                         { return trades[a].CloseDateTime.GetAsDouble() < trades[b].CloseDateTime.GetAsDouble(); });
+
+        std::vector<s_ACSTrade> merged;
+        std::vector<int> mergedSymbols;
+        merged.reserve(trades.size());
+        mergedSymbols.reserve(trades.size());
+        for (int i : order)
+        {
+            merged.push_back(trades[i]);
+            mergedSymbols.push_back(symbolOfTrade[i]);
+        }
+        symbolOfTrade = std::move(mergedSymbols);
+        return merged;
+    }
+
+    std::string GetFailureReason(const std::vector<PortfolioSymbol> &symbols)
+    {
+        for (const PortfolioSymbol &symbol : symbols)
+        {
+            if (!symbol.Done)
+                return "Symbol '" + symbol.Name + "' did not report a result.";
+            if (!symbol.FailureReason.empty())
+                return "Symbol '" + symbol.Name + "' failed: " + symbol.FailureReason;
+        }
+        return "";
+    }
+
+    void LogMetrics(SCStudyInterfaceRef sc, const std::string &reportPath, const std::vector<PortfolioSymbol> &symbols,
+                    const std::vector<std::pair<std::string, double>> &params, int studyId, int comboIndex, double seconds)
+    {
+        std::filesystem::create_directories(std::filesystem::path(reportPath).parent_path());
+
+        std::ofstream log(reportPath, std::ios::trunc);
+        if (!log.is_open())
+            return;
+
+        std::vector<int> symbolOfTrade;
+        std::vector<s_ACSTrade> trades = MergeTrades(symbols, symbolOfTrade);
+        TradeSeries series = TradeMetricsCalculator::GetTradeSeries(trades);
+        TradeMetrics metrics = TradeMetricsCalculator::Calculate(series);
+
+        json tradesData = json::array();
+        json equityCurve = {{"CloseDateTime", json::array()}, {"Equity", json::array()}};
+        double equity = 0.0;
+        for (size_t i = 0; i < trades.size(); ++i)
+        {
+            const s_ACSTrade &trade = trades[i];
+            tradesData.push_back({{"Symbol", symbols[symbolOfTrade[i]].Name},
+                                  {"OpenDateTime", sc.DateTimeToString(trade.OpenDateTime, FLAG_DT_COMPLETE_DATETIME).GetChars()},
+                                  {"CloseDateTime", sc.DateTimeToString(trade.CloseDateTime, FLAG_DT_COMPLETE_DATETIME).GetChars()},
+                                  {"TradeType", trade.TradeType},
+                                  {"TradeQuantity", trade.TradeQuantity},
+                                  {"EntryPrice", trade.EntryPrice},
+                                  {"ExitPrice", trade.ExitPrice},
+                                  {"TradeProfitLoss", trade.TradeProfitLoss},
+                                  {"Commission", trade.Commission},
+                                  {"IsTradeClosed", trade.IsTradeClosed}});
+            equity += trade.TradeProfitLoss;
+            equityCurve["CloseDateTime"].push_back(trade.CloseDateTime.GetAsDouble());
+            equityCurve["Equity"].push_back(equity);
+        }
+
+        json symbolNames = json::array();
+        json symbolProfitLoss = json::array();
+        json symbolTrades = json::array();
+        for (const PortfolioSymbol &symbol : symbols)
+        {
+            TradeMetrics symbolMetrics = TradeMetricsCalculator::Calculate(TradeMetricsCalculator::GetTradeSeries(symbol.Trades));
+            symbolNames.push_back(symbol.Name);
+            symbolProfitLoss.push_back(symbolMetrics.TotalProfitLoss);
+            symbolTrades.push_back(symbolMetrics.NumberOfTrades);
+        }
+
+        json result;
+        result["status"] = "completed";
+        result["combinationIndex"] = comboIndex;
+        result["replaySeconds"] = seconds;
+        result["customStudyInformation"] = InputParameter::GetCustomStudyInformation(sc, studyId);
+        result["combination"] = ReportGenerator::GetCombination(params);
+        result["portfolio"] = {{"Symbols", symbolNames}, {"ProfitLoss", symbolProfitLoss}, {"Trades", symbolTrades}, {"EquityCurve", equityCurve}};
+        result["tradesData"] = tradesData;
+        result["tradeStatistics"] = {{"All Trades", GetPortfolioStatistics(trades, metrics)}};
+        result["performanceMetrics"] = TradeMetricsCalculator::GetPerformanceMetrics(series);
+        result["dailyProfitLoss"] = TradeMetricsCalculator::GetDailyProfitLoss(series);
+        result["timeBuckets"] = TradeMetricsCalculator::GetTimeBuckets(series, sc.StartTime1, sc.EndTime1);
+
+        log << result.dump(4);
+    }
+
+    void ResetSymbols(PortfolioState &portfolio)
+    {
+        for (PortfolioSymbol &symbol : portfolio.Symbols)
+        {
+            symbol.Trades.clear();
+            symbol.Done = false;
+            symbol.FailureReason.clear();
+        }
+    }
+}
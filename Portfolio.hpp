@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "NativeEngine.hpp"
+#include "TradeMetrics.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct PortfolioSymbol
+{
+    std::string Name;
+    std::vector<s_ACSTrade> Trades;
+    bool Done = false;         // The symbol's replay or native run of the current combination has finished
+    std::string FailureReason; // Set when it finished without trades to count
+};
+
+// Symbols of a portfolio run, owned by the run. With charts every lane is one symbol and replays the combination
+// the first lane of the linked replay claimed. Natively every .scid file has its own engine.
+struct PortfolioState
+{
+    std::vector<PortfolioSymbol> Symbols; // Lane order, or .scid file order
+    std::vector<std::unique_ptr<NativeEngine>> Engines;
+
+    // Kept across native batches so their capacity is reused, a simulator and a trade buffer per thread and a result
+    // per combination and symbol of the batch
+    std::vector<FillSimulator> Simulators;
+    std::vector<std::vector<s_ACSTrade>> ThreadTrades;
+    std::vector<PortfolioSymbol> BatchResults;
+
+    int BatchComboIndex = -1; // Work item of the current linked replay, -1 until a lane claims one
+
+    bool IsNative() const { return !Engines.empty(); }
+};
+
+// One parameter set over several symbols. The closed trades of every symbol are merged by close time into one
+// portfolio, and the report of the combination carries the portfolio's statistics, so the analyzer ranks portfolios.
+namespace Portfolio
+{
+    // Chart symbol as a file name, e.g. "ESZ5-CME" for "ESZ5.CME"
+    std::string GetSymbolFileName(const std::string &symbol);
+
+    // Closed trades of all symbols by close time, ties in symbol order. symbolOfTrade gets the symbol of each trade.
+    std::vector<s_ACSTrade> MergeTrades(const std::vector<PortfolioSymbol> &symbols, std::vector<int> &symbolOfTrade);
+
+    // Empty when every symbol finished, otherwise why the portfolio cannot be counted
+    std::string GetFailureReason(const std::vector<PortfolioSymbol> &symbols);
+
+    // Writes the report of one combination in the layout of Logging::LogMetrics, with the merged trades
+    void LogMetrics(SCStudyInterfaceRef sc, const std::string &reportPath, const std::vector<PortfolioSymbol> &symbols,
+                    const std::vector<std::pair<std::string, double>> &params, int studyId, int comboIndex, double seconds);
+
+    // Clears the symbols for the next combination
+    void ResetSymbols(PortfolioState &portfolio);
+}
@@ -70,30 +70,69 @@ namespace ReplayManager
         }
     }
 
-    void StartReplayForCombination(
+    bool PrepareCombination(
         SCStudyInterfaceRef sc,
         const StrategyOptimizerConfig &config,
-        const std::vector<std::vector<double>> &combinations,
-        int comboIndex,
-        ReplayState &replayState)
+        const SweepRun &run,
+        LaneState &lane)
     {
         SCString msg;
-        msg.Format("--- Starting Combination %d/%d ---", comboIndex + 1, (int)combinations.size());
+        msg.Format("--- Starting Combination %d/%d on chart %d ---", lane.ComboIndex + 1, LaneDispatcher::GetWorkItemCount(run), sc.ChartNumber);
         OnChartLogging::AddLog(sc, msg);
 
-        const auto &currentCombo = combinations[comboIndex];
+        const auto &currentCombo = (*run.Combinations)[LaneDispatcher::GetComboIndex(run, lane.ComboIndex)];
         unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
         if (studyID == 0)
         {
             msg.Format("Error: Failed to find study with id=%d", studyID);
             OnChartLogging::AddLog(sc, msg);
-            return;
+            return false;
         }
 
         SetStudyInputsInternal(sc, studyID, currentCombo, config.ParamConfigs);
-        InitiateReplay(sc, config.ReplayConfig);
 
-        replayState = ReplayState::WaitingForReplayToStart;
+        lane.State = ReplayState::ReadyForReplay;
+        lane.StateChangedTime = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool StartReplayForCombination(
+        SCStudyInterfaceRef sc,
+        const StrategyOptimizerConfig &config,
+        const SweepRun &run,
+        LaneState &lane)
+    {
+        if (!PrepareCombination(sc, config, run, lane))
+        {
+            return false;
+        }
+
+        InitiateReplay(sc, LaneDispatcher::GetReplayConfig(run, lane.ComboIndex));
+
+        lane.State = ReplayState::WaitingForReplayToStart;
+        lane.StateChangedTime = std::chrono::steady_clock::now();
+        OnChartLogging::AddLog(sc, "State changed: Waiting for replay data to load.");
+        return true;
+    }
+
+    void StartLinkedReplay(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config, SweepRun &run)
+    {
+        SCString msg;
+        int batchSize = 0;
+        for (auto &lane : run.Lanes)
+        {
+            if (lane.State == ReplayState::ReadyForReplay)
+            {
+                lane.State = ReplayState::WaitingForReplayToStart;
+                lane.StateChangedTime = std::chrono::steady_clock::now();
+                batchSize++;
+            }
+        }
+        run.BatchOpen = false;
+
+        msg.Format("Starting linked replay for a batch of %d combinations.", batchSize);
+        OnChartLogging::AddLog(sc, msg);
+        InitiateReplay(sc, config.ReplayConfig);
         OnChartLogging::AddLog(sc, "State changed: Waiting for replay data to load.");
     }
 
@@ -6,6 +6,7 @@
 
 #include "../sierrachart.h"
 #include "StrategyOptimizer.hpp"
+#include "LaneDispatcher.hpp"
 #include <vector>
 #include <string>
 
@@ -13,14 +14,23 @@ namespace ReplayManager
 {
     void ResetButton(SCStudyInterfaceRef sc, SCInputRef input);
 
-    void StartReplayForCombination(
+    // False when the inputs could not be set, the lane keeps its combination for the caller to record
+    bool PrepareCombination(
         SCStudyInterfaceRef sc,
         const StrategyOptimizerConfig &config,
-        const std::vector<std::vector<double>> &combinations,
-        int comboIndex,
-        ReplayState &replayState
+        const SweepRun &run,
+        LaneState &lane
     );
 
+    bool StartReplayForCombination(
+        SCStudyInterfaceRef sc,
+        const StrategyOptimizerConfig &config,
+        const SweepRun &run,
+        LaneState &lane
+    );
+
+    void StartLinkedReplay(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config, SweepRun &run);
+
     void SetStudyInputs(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config, const std::vector<double> &combinations);
 }
 
@@ -4,18 +4,26 @@
 #include "ResultAnalyzer.hpp"
 #include "OnChartLogging.hpp"
 #include "Enum.hpp"
+#include "ParetoFront.hpp"
+#include "GridNeighborhood.hpp"
+#include "CombinationGenerator.hpp"
+#include "MonteCarloResampler.hpp"
+#include "SweepStatistics.hpp"
+#include "EquityClustering.hpp"
+#include "HeatmapCubes.hpp"
 #include "nlohmann/json.hpp"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
 #include <iomanip>
+#include <cmath>
 
 using json = nlohmann::json;
 
 namespace fs = std::filesystem;
 
-void ResultAnalyzer::AnalyzeResults(SCStudyInterfaceRef sc, const std::string &resultsDir, const std::string &reportFileName)
+std::vector<CombinationResult> ResultAnalyzer::AnalyzeResults(SCStudyInterfaceRef sc, const std::string &resultsDir, const std::string &reportFileName, const StrategyOptimizerConfig &config)
 {
     SCString msg;
     std::vector<CombinationResult> results;
@@ -30,11 +38,22 @@ void ResultAnalyzer::AnalyzeResults(SCStudyInterfaceRef sc, const std::string &r
     if (results.empty())
     {
         OnChartLogging::AddLog(sc, "No JSON files found to analyze.");
-        return;
+        return results;
     }
 
+    // Failed combinations carry no statistics, keep them below every completed run
     std::sort(results.begin(), results.end(), [](const CombinationResult &a, const CombinationResult &b)
-              { return a.totalProfitLoss > b.totalProfitLoss; });
+              {
+                  bool aCompleted = a.status == "completed";
+                  bool bCompleted = b.status == "completed";
+                  if (aCompleted != bCompleted)
+                      return aCompleted;
+                  return a.totalProfitLoss > b.totalProfitLoss; });
+
+    if (config.AnalysisConfig.MonteCarlo.TopK > 0)
+    {
+        RunMonteCarlo(sc, results, config.AnalysisConfig.MonteCarlo);
+    }
 
     std::ofstream csvFile(reportFileName);
 
@@ -42,7 +61,7 @@ void ResultAnalyzer::AnalyzeResults(SCStudyInterfaceRef sc, const std::string &r
     {
         msg.Format("Failed to create summary report file at: %s", reportFileName.c_str());
         OnChartLogging::AddLog(sc, msg);
-        return;
+        return results;
     }
 
     csvFile << CombinationResult::GetCsvHeader();
@@ -53,6 +72,494 @@ void ResultAnalyzer::AnalyzeResults(SCStudyInterfaceRef sc, const std::string &r
 
     msg.Format("Summary report generated at: %s", reportFileName.c_str());
     OnChartLogging::AddLog(sc, msg);
+
+    if (!config.AnalysisConfig.Objectives.empty())
+    {
+        WriteParetoFronts(sc, results, config.AnalysisConfig, reportFileName);
+    }
+
+    if (config.AnalysisConfig.NeighborhoodRadius > 0)
+    {
+        WriteRobustnessScores(sc, results, config, reportFileName);
+    }
+
+    if (config.AnalysisConfig.Statistics.Enabled)
+    {
+        WriteSweepStatistics(sc, results, config.AnalysisConfig.Statistics, reportFileName);
+    }
+
+    if (config.AnalysisConfig.Clustering.Enabled)
+    {
+        WriteEquityClusters(sc, results, config.AnalysisConfig.Clustering, reportFileName);
+    }
+
+    if (config.AnalysisConfig.Heatmaps.Enabled)
+    {
+        WriteHeatmapCubes(sc, results, config.AnalysisConfig.Heatmaps, reportFileName);
+    }
+
+    if (config.PortfolioConfig.Enabled)
+    {
+        WritePortfolioBreakdown(sc, results, reportFileName);
+    }
+    return results;
+}
+
+void ResultAnalyzer::WriteHeatmapCubes(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const HeatmapConfig &heatmapConfig, const std::string &reportFileName)
+{
+    // Every report of a sweep names the same inputs in the same order, anything else is left out
+    std::vector<int> candidates;
+    std::vector<std::vector<double>> parameters;
+    for (int i = 0; i < (int)results.size(); ++i)
+    {
+        const auto &combination = results[i].combination;
+        if (results[i].status != "completed" || combination.empty())
+            continue;
+
+        if (!candidates.empty())
+        {
+            const auto &first = results[candidates.front()].combination;
+            bool sameInputs = combination.size() == first.size();
+            for (size_t p = 0; sameInputs && p < combination.size(); ++p)
+            {
+                sameInputs = combination[p].first == first[p].first;
+            }
+            if (!sameInputs)
+                continue;
+        }
+
+        std::vector<double> row;
+        for (const auto &input : combination)
+        {
+            row.push_back(input.second);
+        }
+        candidates.push_back(i);
+        parameters.push_back(row);
+    }
+
+    SCString msg;
+    if (candidates.empty())
+    {
+        OnChartLogging::AddLog(sc, "No completed combinations, heatmaps skipped.");
+        return;
+    }
+
+    std::string heatmapsFileName = fs::path(reportFileName).replace_extension().string() + "-heatmaps.csv";
+    std::ofstream csvFile(heatmapsFileName);
+    if (!csvFile.is_open())
+    {
+        msg.Format("Failed to create heatmaps file at: %s", heatmapsFileName.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    csvFile << "Metric,X Parameter,Y Parameter,X Value,Y Value,Count,Mean,Max\n";
+    csvFile << std::setprecision(10);
+
+    const auto &names = results[candidates.front()].combination;
+    int cubeCount = 0;
+    for (size_t m = 0; m < heatmapConfig.Metrics.size(); ++m)
+    {
+        std::vector<double> values;
+        for (int i : candidates)
+        {
+            values.push_back(results[i].GetMetric(heatmapConfig.Metrics[m]));
+        }
+
+        std::vector<HeatmapCube> cubes = HeatmapCubes::Compute(parameters, values);
+        for (const auto &cube : cubes)
+        {
+            for (size_t y = 0; y < cube.YValues.size(); ++y)
+            {
+                for (size_t x = 0; x < cube.XValues.size(); ++x)
+                {
+                    size_t cell = y * cube.XValues.size() + x;
+                    if (cube.Count[cell] == 0)
+                        continue;
+
+                    csvFile << heatmapConfig.MetricNames[m] << ","
+                            << "\"" << names[cube.XParameter].first << "\","
+                            << "\"" << names[cube.YParameter].first << "\","
+                            << cube.XValues[x] << ","
+                            << cube.YValues[y] << ","
+                            << cube.Count[cell] << ","
+                            << cube.Mean[cell] << ","
+                            << cube.Max[cell] << "\n";
+                }
+            }
+        }
+        cubeCount += (int)cubes.size();
+    }
+
+    msg.Format("Heatmaps: %d parameter pair tables from %d combinations. Saved to: %s", cubeCount, (int)candidates.size(), heatmapsFileName.c_str());
+    OnChartLogging::AddLog(sc, msg);
+}
+
+void ResultAnalyzer::WriteEquityClusters(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const ClusteringConfig &clusteringConfig, const std::string &reportFileName)
+{
+    std::vector<int> candidates;
+    std::vector<std::vector<std::pair<int, double>>> dailyProfitLoss;
+    for (int i = 0; i < (int)results.size(); ++i)
+    {
+        if (results[i].status != "completed" || results[i].dailyProfitLoss.empty())
+            continue;
+
+        candidates.push_back(i);
+        dailyProfitLoss.push_back(results[i].dailyProfitLoss);
+    }
+
+    SCString msg;
+    if (candidates.size() < 2)
+    {
+        OnChartLogging::AddLog(sc, "Equity clustering skipped, it needs at least 2 combinations with daily P/L.");
+        return;
+    }
+
+    EquityClusters clusters = EquityClustering::Compute(dailyProfitLoss, clusteringConfig);
+
+    // Best member and size of every cluster, in the oriented objective so that higher is always better
+    const ObjectiveConfig &objective = clusteringConfig.Objective;
+    double sign = objective.Maximize ? 1.0 : -1.0;
+    std::vector<int> best(clusters.ClusterCount, -1);
+    std::vector<int> sizes(clusters.ClusterCount, 0);
+    for (int i = 0; i < (int)candidates.size(); ++i)
+    {
+        int label = clusters.Labels[i];
+        sizes[label]++;
+        if (best[label] < 0 || sign * results[candidates[i]].GetMetric(objective.Metric) > sign * results[candidates[best[label]]].GetMetric(objective.Metric))
+        {
+            best[label] = i;
+        }
+    }
+
+    std::vector<int> order(clusters.ClusterCount);
+    for (int i = 0; i < (int)order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                     { return sign * results[candidates[best[a]]].GetMetric(objective.Metric) > sign * results[candidates[best[b]]].GetMetric(objective.Metric); });
+
+    std::string clustersFileName = fs::path(reportFileName).replace_extension().string() + "-clusters.csv";
+    std::ofstream csvFile(clustersFileName);
+    if (!csvFile.is_open())
+    {
+        msg.Format("Failed to create equity clusters file at: %s", clustersFileName.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    csvFile << "Cluster,Cluster Size," << objective.Name << ",";
+    csvFile << CombinationResult::GetCsvHeader();
+
+    csvFile << std::fixed << std::setprecision(4);
+    for (int cluster : order)
+    {
+        const CombinationResult &result = results[candidates[best[cluster]]];
+        csvFile << cluster << ","
+                << sizes[cluster] << ","
+                << result.GetMetric(objective.Metric) << ","
+                << result.ToCsvRow();
+    }
+
+    msg.Format("Equity clustering: %d combinations in %d distinct clusters over %d grid points. Saved to: %s", (int)candidates.size(), clusters.ClusterCount, clusters.GridPoints, clustersFileName.c_str());
+    OnChartLogging::AddLog(sc, msg);
+}
+
+void ResultAnalyzer::WriteSweepStatistics(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const SweepStatisticsConfig &statisticsConfig, const std::string &reportFileName)
+{
+    std::vector<int> candidates;
+    std::vector<std::vector<std::pair<int, double>>> dailyProfitLoss;
+    for (int i = 0; i < (int)results.size(); ++i)
+    {
+        if (results[i].status != "completed")
+            continue;
+
+        candidates.push_back(i);
+        dailyProfitLoss.push_back(results[i].dailyProfitLoss);
+    }
+
+    SCString msg;
+    SweepStatisticsResult statistics = SweepStatistics::Compute(dailyProfitLoss, statisticsConfig);
+    if (statistics.BestIndex < 0)
+    {
+        msg.Format("Sweep statistics skipped, they need at least 2 combinations and 3 trading days (%d combinations, %d days).", statistics.Combinations, statistics.Periods);
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    std::string statisticsFileName = fs::path(reportFileName).replace_extension().string() + "-statistics.csv";
+    std::ofstream csvFile(statisticsFileName);
+    if (!csvFile.is_open())
+    {
+        msg.Format("Failed to create sweep statistics file at: %s", statisticsFileName.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    csvFile << std::fixed << std::setprecision(6);
+    csvFile << "Statistic,Value\n"
+            << "Combinations," << statistics.Combinations << "\n"
+            << "Trading Days," << statistics.Periods << "\n"
+            << "Best Combination,\"" << results[candidates[statistics.BestIndex]].sourceFile << "\"\n"
+            << "Best Daily Sharpe," << statistics.BestSharpe << "\n"
+            << "Expected Max Daily Sharpe," << statistics.ExpectedMaxSharpe << "\n"
+            << "Deflated Sharpe Ratio," << statistics.DeflatedSharpe << "\n"
+            << "Reality Check p-value," << statistics.RealityCheckPValue << "\n"
+            << "SPA p-value," << statistics.SpaPValue << "\n"
+            << "Bootstrap Resamples," << statisticsConfig.Resamples << "\n"
+            << "Probability of Backtest Overfitting," << statistics.Pbo << "\n"
+            << "CSCV Splits," << statistics.CscvSplits << "\n";
+
+    msg.Format("Sweep statistics: deflated Sharpe %.3f, Reality Check p %.3f, SPA p %.3f, PBO %.3f. Saved to: %s", statistics.DeflatedSharpe, statistics.RealityCheckPValue, statistics.SpaPValue, statistics.Pbo, statisticsFileName.c_str());
+    OnChartLogging::AddLog(sc, msg);
+}
+
+void ResultAnalyzer::WriteRobustnessScores(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const StrategyOptimizerConfig &config, const std::string &reportFileName)
+{
+    const AnalysisConfig &analysisConfig = config.AnalysisConfig;
+    std::vector<int> shape = CombinationGenerator::GetGridShape(config.ParamConfigs);
+    long long cellCount = 1;
+    for (int size : shape)
+    {
+        cellCount *= size;
+    }
+
+    // Neighborhoods are taken in the oriented objective so that a higher plateau score is always better
+    double sign = analysisConfig.RobustnessObjective.Maximize ? 1.0 : -1.0;
+    std::vector<int> candidates;
+    std::vector<long long> globalIndices;
+    std::vector<double> values;
+    for (int i = 0; i < (int)results.size(); ++i)
+    {
+        if (results[i].status != "completed" || results[i].comboIndex < 0 || results[i].comboIndex >= cellCount)
+            continue;
+
+        candidates.push_back(i);
+        globalIndices.push_back(results[i].comboIndex);
+        values.push_back(sign * results[i].GetMetric(analysisConfig.RobustnessObjective.Metric));
+    }
+
+    SCString msg;
+    if (candidates.empty())
+    {
+        OnChartLogging::AddLog(sc, "No results with a combination index, robustness scores skipped.");
+        return;
+    }
+
+    std::vector<NeighborhoodStats> stats = GridNeighborhood::Compute(globalIndices, values, shape, analysisConfig.NeighborhoodRadius, analysisConfig.Neighborhood, analysisConfig.PlateauPenalty);
+
+    std::vector<int> order(candidates.size());
+    for (int i = 0; i < (int)order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&stats](int a, int b)
+                     { return stats[a].PlateauScore > stats[b].PlateauScore; });
+
+    std::string robustnessFileName = fs::path(reportFileName).replace_extension().string() + "-robustness.csv";
+    std::ofstream csvFile(robustnessFileName);
+    if (!csvFile.is_open())
+    {
+        msg.Format("Failed to create robustness file at: %s", robustnessFileName.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    csvFile << "Plateau Score,Neighbors,Neighborhood Mean,Neighborhood Worst,Neighborhood Variance,Grid Coordinates,";
+    csvFile << CombinationResult::GetCsvHeader();
+
+    csvFile << std::fixed << std::setprecision(4);
+    for (int i : order)
+    {
+        const NeighborhoodStats &s = stats[i];
+        std::vector<int> coordinates = GridNeighborhood::DecodeCoordinates(globalIndices[i], shape);
+        std::stringstream coordinatesStream;
+        for (size_t d = 0; d < coordinates.size(); ++d)
+        {
+            coordinatesStream << (d > 0 ? " " : "") << coordinates[d];
+        }
+
+        csvFile << sign * s.PlateauScore << ","
+                << s.Count - 1 << ","
+                << sign * s.Mean << ","
+                << sign * s.Min << ","
+                << s.Variance << ","
+                << "\"" << coordinatesStream.str() << "\","
+                << results[candidates[i]].ToCsvRow();
+    }
+
+    msg.Format("Robustness scores generated at: %s", robustnessFileName.c_str());
+    OnChartLogging::AddLog(sc, msg);
+}
+
+void ResultAnalyzer::RunMonteCarlo(SCStudyInterfaceRef sc, std::vector<CombinationResult> &results, const MonteCarloConfig &monteCarloConfig)
+{
+    // Results are sorted completed first by total P/L, so the top K are at the front
+    int resampled = 0;
+    for (auto &result : results)
+    {
+        if (resampled >= monteCarloConfig.TopK || result.status != "completed")
+            break;
+
+        json j = GetJsonFromFile(result.sourceFile, sc);
+        if (!j.contains("tradesData"))
+            continue;
+
+        std::vector<double> profitLoss;
+        for (const auto &trade : j["tradesData"])
+        {
+            profitLoss.push_back(trade.value("TradeProfitLoss", 0.0));
+        }
+
+        // The combination index keys the random streams, so every re-analysis reproduces the same numbers
+        MonteCarloResult monteCarlo = MonteCarloResampler::Run(profitLoss, monteCarloConfig, (uint64_t)(result.comboIndex >= 0 ? result.comboIndex : resampled));
+        if (monteCarlo.Resamples == 0)
+            continue;
+
+        j["monteCarlo"] = MonteCarloResampler::ToJson(monteCarlo, monteCarloConfig);
+        std::ofstream reportFile(result.sourceFile, std::ios::trunc);
+        if (reportFile.is_open())
+        {
+            reportFile << j.dump(4);
+        }
+
+        result.hasMonteCarlo = true;
+        result.monteCarloMaxDrawdownP95 = monteCarlo.MaxDrawdownPercentiles.back();
+        result.monteCarloRiskOfRuin = monteCarlo.RiskOfRuin;
+        resampled++;
+    }
+
+    SCString msg;
+    msg.Format("Monte Carlo resampling done for %d combinations (%d resamples each).", resampled, monteCarloConfig.Resamples);
+    OnChartLogging::AddLog(sc, msg);
+}
+
+void ResultAnalyzer::WriteParetoFronts(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const AnalysisConfig &analysisConfig, const std::string &reportFileName)
+{
+    // Minimized objectives are negated so the ranking only has to maximize
+    std::vector<int> candidates;
+    std::vector<std::vector<double>> points;
+    for (int i = 0; i < (int)results.size(); ++i)
+    {
+        if (results[i].status != "completed")
+            continue;
+
+        std::vector<double> point;
+        for (const auto &objective : analysisConfig.Objectives)
+        {
+            double value = results[i].GetMetric(objective.Metric);
+            point.push_back(objective.Maximize ? value : -value);
+        }
+        candidates.push_back(i);
+        points.push_back(point);
+    }
+
+    std::vector<int> ranks = ParetoFront::RankFronts(points, analysisConfig.ParetoFronts);
+
+    std::vector<int> ranked;
+    for (int i = 0; i < (int)candidates.size(); ++i)
+    {
+        if (ranks[i] > 0)
+            ranked.push_back(i);
+    }
+    // Within a front keep the summary order, which is by total P/L
+    std::stable_sort(ranked.begin(), ranked.end(), [&ranks](int a, int b)
+                     { return ranks[a] < ranks[b]; });
+
+    std::string paretoFileName = fs::path(reportFileName).replace_extension().string() + "-pareto.csv";
+    std::ofstream csvFile(paretoFileName);
+    SCString msg;
+    if (!csvFile.is_open())
+    {
+        msg.Format("Failed to create Pareto front file at: %s", paretoFileName.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    csvFile << "Front,";
+    for (const auto &objective : analysisConfig.Objectives)
+    {
+        csvFile << objective.Name << " (" << (objective.Maximize ? "max" : "min") << "),";
+    }
+    csvFile << CombinationResult::GetCsvHeader();
+
+    csvFile << std::fixed << std::setprecision(4);
+    int frontCount = 0;
+    for (int i : ranked)
+    {
+        const CombinationResult &result = results[candidates[i]];
+        csvFile << ranks[i] << ",";
+        for (const auto &objective : analysisConfig.Objectives)
+        {
+            csvFile << result.GetMetric(objective.Metric) << ",";
+        }
+        csvFile << result.ToCsvRow();
+        frontCount = (std::max)(frontCount, ranks[i]);
+    }
+
+    msg.Format("Pareto fronts generated at: %s (%d combinations in %d fronts).", paretoFileName.c_str(), (int)ranked.size(), frontCount);
+    OnChartLogging::AddLog(sc, msg);
+}
+
+void ResultAnalyzer::WritePortfolioBreakdown(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const std::string &reportFileName)
+{
+    // Every portfolio report lists the same symbols in the same order, the first one names the columns
+    const CombinationResult *first = nullptr;
+    for (const auto &result : results)
+    {
+        if (result.status == "completed" && !result.symbolProfitLoss.empty())
+        {
+            first = &result;
+            break;
+        }
+    }
+
+    SCString msg;
+    if (first == nullptr)
+    {
+        OnChartLogging::AddLog(sc, "Portfolio breakdown skipped, no completed portfolio report.");
+        return;
+    }
+
+    std::string portfolioFileName = fs::path(reportFileName).replace_extension().string() + "-portfolio.csv";
+    std::ofstream csvFile(portfolioFileName);
+    if (!csvFile.is_open())
+    {
+        msg.Format("Failed to create portfolio breakdown file at: %s", portfolioFileName.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        return;
+    }
+
+    csvFile << "Combination Index,Portfolio Profit/Loss,Portfolio Max Drawdown,Profitable Symbols,";
+    for (const auto &symbol : first->symbolProfitLoss)
+    {
+        csvFile << "\"" << symbol.first << " Profit/Loss\",";
+    }
+    csvFile << CombinationResult::GetCsvHeader();
+
+    // Summary order, which ranks by the portfolio's total P/L
+    csvFile << std::fixed << std::setprecision(4);
+    for (const auto &result : results)
+    {
+        if (result.status != "completed" || result.symbolProfitLoss.size() != first->symbolProfitLoss.size())
+            continue;
+
+        int profitableSymbols = 0;
+        for (const auto &symbol : result.symbolProfitLoss)
+        {
+            profitableSymbols += symbol.second > 0.0 ? 1 : 0;
+        }
+        csvFile << result.comboIndex << "," << result.totalProfitLoss << "," << result.maxDrawdown << "," << profitableSymbols << ",";
+        for (const auto &symbol : result.symbolProfitLoss)
+        {
+            csvFile << symbol.second << ",";
+        }
+        csvFile << result.ToCsvRow();
+    }
+
+    msg.Format("Portfolio breakdown over %d symbols saved to: %s", (int)first->symbolProfitLoss.size(), portfolioFileName.c_str());
+    OnChartLogging::AddLog(sc, msg);
 }
 
 CombinationResult ResultAnalyzer::ParseJsonResult(const std::string &filePath, SCStudyInterfaceRef sc)
@@ -63,6 +570,40 @@ CombinationResult ResultAnalyzer::ParseJsonResult(const std::string &filePath, S
     {
         json j = GetJsonFromFile(filePath, sc);
 
+        bool hasStatus = j.contains("status") && j["status"].is_string();
+        if (hasStatus)
+            result.status = j["status"];
+        result.comboIndex = j.value("combinationIndex", -1);
+
+        if (j.contains("dailyProfitLoss"))
+        {
+            const auto &days = j["dailyProfitLoss"]["Days"];
+            const auto &profitLoss = j["dailyProfitLoss"]["ProfitLoss"];
+            for (size_t i = 0; i < days.size() && i < profitLoss.size(); ++i)
+            {
+                result.dailyProfitLoss.push_back({days[i].get<int>(), profitLoss[i].get<double>()});
+            }
+        }
+
+        if (j.contains("portfolio"))
+        {
+            const auto &symbols = j["portfolio"]["Symbols"];
+            const auto &profitLoss = j["portfolio"]["ProfitLoss"];
+            for (size_t i = 0; i < symbols.size() && i < profitLoss.size(); ++i)
+            {
+                result.symbolProfitLoss.push_back({symbols[i].get<std::string>(), profitLoss[i].get<double>()});
+            }
+        }
+
+        if (j.contains("combination") && j["combination"].is_object())
+        {
+            for (auto it = j["combination"].begin(); it != j["combination"].end(); ++it)
+            {
+                if (it.value().is_number())
+                    result.combination.push_back({it.key(), it.value().get<double>()});
+            }
+        }
+
         if (j.contains("customStudyInformation"))
         {
             const auto &header = j["customStudyInformation"];
@@ -95,16 +636,32 @@ CombinationResult ResultAnalyzer::ParseJsonResult(const std::string &filePath, S
                 result.winningTradesPercentage = stats["PercentProfitable"];
             if (stats.contains("MaximumDrawdown"))
                 result.maxDrawdown = stats["MaximumDrawdown"];
+
+            // Reports written before the status field existed were only written for completed runs
+            if (!hasStatus)
+                result.status = "completed";
+        }
+
+        if (j.contains("performanceMetrics") && j["performanceMetrics"].contains("Combined"))
+        {
+            const auto &metrics = j["performanceMetrics"]["Combined"];
+            result.sharpeRatio = metrics.value("SharpeRatio", 0.0);
+            result.sortinoRatio = metrics.value("SortinoRatio", 0.0);
+            result.calmarRatio = metrics.value("CalmarRatio", 0.0);
+            result.expectancy = metrics.value("Expectancy", 0.0);
+            result.ulcerIndex = metrics.value("UlcerIndex", 0.0);
         }
     }
     catch (const std::exception &e)
     {
+        result.status = "invalid";
         SCString msg;
         msg.Format("Error parsing JSON file %s: %s", filePath.c_str(), e.what());
         OnChartLogging::AddLog(sc, msg);
     }
     catch (...)
     {
+        result.status = "invalid";
         SCString msg;
         msg.Format("An unknown error occurred while parsing JSON file: %s", filePath.c_str());
         OnChartLogging::AddLog(sc, msg);
@@ -148,7 +705,7 @@ json ResultAnalyzer::GetJsonFromFile(const std::string &filePath, SCStudyInterfa
 
 std::string CombinationResult::GetCsvHeader()
 {
-    return "Strategy,DLL Name,Parameters,Total P/L,Profit Factor,Total Trades,Win Rate (%),Max Drawdown,Source File\n";
+    return "Strategy,DLL Name,Parameters,Total P/L,Profit Factor,Total Trades,Win Rate (%),Max Drawdown,MC Max Drawdown P95,MC Risk of Ruin (%),Status,Source File\n";
 }
 
 std::string CombinationResult::ToCsvRow() const
@@ -172,8 +729,47 @@ std::string CombinationResult::ToCsvRow() const
        << profitFactor << ","
        << totalTrades << ","
        << winningTradesPercentage * 100 << ","
-       << maxDrawdown << ","
+       << maxDrawdown << ",";
+    if (hasMonteCarlo)
+    {
+        ss << monteCarloMaxDrawdownP95 << ","
+           << monteCarloRiskOfRuin * 100 << ",";
+    }
+    else
+    {
+        ss << ",,";
+    }
+    ss << status << ","
        << "\"" << sourceFile << "\"\n";
 
     return ss.str();
+}
+
+double CombinationResult::GetMetric(ResultMetric metric) const
+{
+    switch (metric)
+    {
+    case ResultMetric::TOTAL_PROFIT_LOSS:
+        return totalProfitLoss;
+    case ResultMetric::PROFIT_FACTOR:
+        return profitFactor;
+    case ResultMetric::TOTAL_TRADES:
+        return totalTrades;
+    case ResultMetric::WIN_RATE:
+        return winningTradesPercentage;
+    case ResultMetric::MAX_DRAWDOWN:
+        // Compared by size, whatever sign the statistics use
+        return std::fabs(maxDrawdown);
+    case ResultMetric::SHARPE_RATIO:
+        return sharpeRatio;
+    case ResultMetric::SORTINO_RATIO:
+        return sortinoRatio;
+    case ResultMetric::CALMAR_RATIO:
+        return calmarRatio;
+    case ResultMetric::EXPECTANCY:
+        return expectancy;
+    case ResultMetric::ULCER_INDEX:
+        return ulcerIndex;
+    }
+    return 0.0;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include "nlohmann/json.hpp"
+#include "ConfigManager.hpp"
 using json = nlohmann::json;
 
 struct CombinationResult
@@ -18,18 +19,40 @@ struct CombinationResult
     int totalTrades = 0;
     double winningTradesPercentage = 0.0;
     double maxDrawdown = 0.0;
+    double sharpeRatio = 0.0;
+    double sortinoRatio = 0.0;
+    double calmarRatio = 0.0;
+    double expectancy = 0.0;
+    double ulcerIndex = 0.0;
+    bool hasMonteCarlo = false;
+    double monteCarloMaxDrawdownP95 = 0.0;
+    double monteCarloRiskOfRuin = 0.0;
+    int comboIndex = -1;
+    std::vector<std::pair<int, double>> dailyProfitLoss;
+    std::vector<std::pair<std::string, double>> symbolProfitLoss; // Portfolio reports only, in symbol order
+    std::vector<std::pair<std::string, double>> combination;
+    std::string status = "invalid"; // completed or failed as the report says, completed when an older report without one has statistics, invalid when it cannot be read
     std::string sourceFile;
 
     static std::string GetCsvHeader();
     std::string ToCsvRow() const;
+    double GetMetric(ResultMetric metric) const;
 };
 
 class ResultAnalyzer
 {
 public:
-    static void AnalyzeResults(SCStudyInterfaceRef sc, const std::string &resultsDir, const std::string &reportFileName);
+    // Returns the parsed results, completed combinations first by total P/L
+    static std::vector<CombinationResult> AnalyzeResults(SCStudyInterfaceRef sc, const std::string &resultsDir, const std::string &reportFileName, const StrategyOptimizerConfig &config);
+    static CombinationResult ParseJsonResult(const std::string &filePath, SCStudyInterfaceRef sc);
 
 private:
-    static CombinationResult ParseJsonResult(const std::string &filePath, SCStudyInterfaceRef sc);
+    static void RunMonteCarlo(SCStudyInterfaceRef sc, std::vector<CombinationResult> &results, const MonteCarloConfig &monteCarloConfig);
+    static void WriteHeatmapCubes(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const HeatmapConfig &heatmapConfig, const std::string &reportFileName);
+    static void WriteEquityClusters(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const ClusteringConfig &clusteringConfig, const std::string &reportFileName);
+    static void WriteSweepStatistics(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const SweepStatisticsConfig &statisticsConfig, const std::string &reportFileName);
+    static void WriteRobustnessScores(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const StrategyOptimizerConfig &config, const std::string &reportFileName);
+    static void WriteParetoFronts(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const AnalysisConfig &analysisConfig, const std::string &reportFileName);
+    static void WritePortfolioBreakdown(SCStudyInterfaceRef sc, const std::vector<CombinationResult> &results, const std::string &reportFileName);
     static json GetJsonFromFile(const std::string &filePath, SCStudyInterfaceRef sc);
 };
\ No newline at end of file
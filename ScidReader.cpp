@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "ScidReader.hpp"
+#include "DateTimeIndex.hpp"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const uint32_t INDEX_VERSION = 1;
+    const char INDEX_MAGIC[4] = {'S', 'I', 'D', 'X'};
+
+    struct IndexFileHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t Stride;
+        uint32_t RecordSize;
+        uint64_t RecordCount; // Records of the data file when the index was written
+    };
+}
+
+ScidReader::ScidReader()
+    : records(nullptr),
+      recordCount(0)
+{
+}
+
+bool ScidReader::Open(const std::string &path, std::string &error)
+{
+    Close();
+
+    // Sierra Chart keeps appending to the file, the mapping holds what is there now
+    if (!dataFile.Open(path, error))
+        return false;
+
+    const s_IntradayFileHeader *header = static_cast<const s_IntradayFileHeader *>(dataFile.GetData());
+    if (dataFile.GetSize() < sizeof(s_IntradayFileHeader) || header->FileTypeUniqueHeaderID != s_IntradayFileHeader::UNIQUE_HEADER_ID ||
+        header->RecordSize != sizeof(s_IntradayRecord) || header->HeaderSize < sizeof(s_IntradayFileHeader) || header->HeaderSize > dataFile.GetSize())
+    {
+        error = "'" + path + "' is not an intraday data file of this Sierra Chart version.";
+        Close();
+        return false;
+    }
+
+    // A record still being written at the end of the file is left out
+    records = reinterpret_cast<const s_IntradayRecord *>(static_cast<const char *>(dataFile.GetData()) + header->HeaderSize);
+    recordCount = (dataFile.GetSize() - header->HeaderSize) / sizeof(s_IntradayRecord);
+
+    indexPath = path + ".idx";
+    size_t cachedEntries = LoadIndex() ? indexDateTimes.size() : 0;
+    DateTimeIndex::Extend(indexDateTimes, recordCount, [this](size_t i)
+                          { return records[i].DateTime; });
+    if (indexDateTimes.size() != cachedEntries)
+    {
+        SaveIndex();
+    }
+    return true;
+}
+
+void ScidReader::Close()
+{
+    dataFile.Close();
+    records = nullptr;
+    recordCount = 0;
+    indexDateTimes.clear();
+}
+
+IntradayRecordSpan ScidReader::GetRecords() const
+{
+    return {records, recordCount};
+}
+
+size_t ScidReader::LowerBound(const SCDateTimeMS &dateTime) const
+{
+    return DateTimeIndex::LowerBound(indexDateTimes, recordCount, dateTime, [this](size_t i)
+                                     { return records[i].DateTime; });
+}
+
+IntradayRecordSpan ScidReader::GetRange(const SCDateTimeMS &startDateTime, const SCDateTimeMS &endDateTime) const
+{
+    size_t first = LowerBound(startDateTime);
+    size_t last = endDateTime.GetAsDouble() == 0.0 ? recordCount : (std::max)(first, LowerBound(endDateTime));
+    return {records + first, last - first};
+}
+
+bool ScidReader::LoadIndex()
+{
+    indexDateTimes.clear();
+    std::ifstream indexFile(indexPath, std::ios::binary);
+    if (!indexFile.is_open())
+        return false;
+
+    IndexFileHeader header;
+    if (!indexFile.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.Magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header.Version != INDEX_VERSION ||
+        header.Stride != DateTimeIndex::STRIDE || header.RecordSize != sizeof(s_IntradayRecord) || header.RecordCount > recordCount)
+        return false;
+
+    size_t entries = (size_t)((header.RecordCount + DateTimeIndex::STRIDE - 1) / DateTimeIndex::STRIDE);
+    indexDateTimes.resize(entries);
+    if (entries > 0 && !indexFile.read(reinterpret_cast<char *>(indexDateTimes.data()), entries * sizeof(SCDateTimeMS)))
+    {
+        indexDateTimes.clear();
+        return false;
+    }
+
+    // A data file that was rewritten rather than appended to no longer matches its index
+    for (size_t entry : {(size_t)0, entries - 1})
+    {
+        if (entries > 0 && !(records[entry * DateTimeIndex::STRIDE].DateTime == indexDateTimes[entry]))
+        {
+            indexDateTimes.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void ScidReader::SaveIndex() const
+{
+    // Written aside and renamed, so another reader never loads half an index. A read-only data folder only costs the cache.
+    std::string pendingPath = indexPath + ".tmp";
+    {
+        std::ofstream indexFile(pendingPath, std::ios::binary | std::ios::trunc);
+        if (!indexFile.is_open())
+            return;
+
+        IndexFileHeader header;
+        std::memcpy(header.Magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        header.Version = INDEX_VERSION;
+        header.Stride = (uint32_t)DateTimeIndex::STRIDE;
+        header.RecordSize = sizeof(s_IntradayRecord);
+        header.RecordCount = recordCount;
+        indexFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        indexFile.write(reinterpret_cast<const char *>(indexDateTimes.data()), indexDateTimes.size() * sizeof(SCDateTimeMS));
+        if (!indexFile)
+            return;
+    }
+
+    std::error_code ec;
+    fs::rename(pendingPath, indexPath, ec);
+    if (ec)
+        fs::remove(pendingPath, ec);
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Read-only view of consecutive records inside the mapped file, valid while the reader stays open
+struct IntradayRecordSpan
+{
+    const s_IntradayRecord *Data = nullptr;
+    size_t Size = 0;
+
+    const s_IntradayRecord *begin() const { return Data; }
+    const s_IntradayRecord *end() const { return Data + Size; }
+    bool IsEmpty() const { return Size == 0; }
+};
+
+// Memory-mapped Sierra Chart intraday data file (.scid). Records are used in place, in the s_IntradayRecord layout.
+// Seeks go through a DateTimeIndex, which is cached next to the data file as <file>.idx and extended, not rebuilt,
+// when the data file has grown since it was written.
+//
+// Records are assumed to be in date time order, as Sierra Chart writes them.
+class ScidReader
+{
+public:
+    ScidReader();
+    ScidReader(const ScidReader &) = delete;
+    ScidReader &operator=(const ScidReader &) = delete;
+
+    bool Open(const std::string &path, std::string &error);
+    void Close();
+
+    size_t GetRecordCount() const { return recordCount; }
+    IntradayRecordSpan GetRecords() const;
+
+    // Position of the first record at or after dateTime, GetRecordCount() when there is none
+    size_t LowerBound(const SCDateTimeMS &dateTime) const;
+
+    // Records with startDateTime <= DateTime < endDateTime. A zero end date time runs to the end of the file.
+    IntradayRecordSpan GetRange(const SCDateTimeMS &startDateTime, const SCDateTimeMS &endDateTime) const;
+
+private:
+    bool LoadIndex();
+    void SaveIndex() const;
+
+    std::string indexPath;
+    MappedFile dataFile;
+    const s_IntradayRecord *records;
+    size_t recordCount;
+
+    // Date time of record i * DateTimeIndex::STRIDE
+    std::vector<SCDateTimeMS> indexDateTimes;
+};
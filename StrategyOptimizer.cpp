@@ -9,12 +9,20 @@
 #include "OnChartLogging.hpp"
 #include "Enum.hpp"
 #include "ResultAnalyzer.hpp"
+#include "LaneDispatcher.hpp"
+#include "TradeMetrics.hpp"
+#include "Parallel.hpp"
+#include "JobQueue.hpp"
+#include "CombinationGenerator.hpp"
 #include <string>
 #include <vector>
 #include <utility>
 #include <sstream>
+#include <fstream>
 #include <filesystem>
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <windows.h>
 
 void InitializePersistentPointers(SCStudyInterfaceRef sc);
@@ -22,7 +30,22 @@ void HandleSetDefaults(SCStudyInterfaceRef sc);
 void HandleFullRecalculation(SCStudyInterfaceRef sc);
 bool HandleReplayLogic(SCStudyInterfaceRef sc);
 void HandleMenuEvents(SCStudyInterfaceRef sc);
-void HandleReplayCompletion(SCStudyInterfaceRef sc);
+void HandleReplayCompletion(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane);
+void HandleReplayTimeout(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane, const char *reason);
+void ProceedToNextCombination(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane);
+bool CompleteCombination(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane);
+void HandlePrepareFailure(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane);
+void FinishRun(SCStudyInterfaceRef sc, SweepRun &run);
+void RecordPortfolioSymbol(SCStudyInterfaceRef sc, SweepRun &run, const LaneState &lane, const std::string &failureReason);
+void LogPortfolio(SCStudyInterfaceRef sc, SweepRun &run, int workItem, double seconds);
+void RunNativeBatch(SCStudyInterfaceRef sc, SweepRun &run);
+void CompleteWalkForwardItem(SCStudyInterfaceRef sc, SweepRun &run, int workItem);
+void UpdateSurrogate(SCStudyInterfaceRef sc, SweepRun &run);
+bool HasReachedReplayEnd(SCStudyInterfaceRef sc, const SweepRun &run, const LaneState &lane);
+double GetSecondsInCurrentState(const LaneState &lane);
+std::vector<std::pair<std::string, double>> GetCombinationParams(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config, const std::vector<double> &combo, unsigned int studyID);
+std::string GetReportPath(SCStudyInterfaceRef sc, const SweepRun &run, int comboIndex, n_ACSIL::s_CustomStudyInformation &customStudyInfo);
+int MarkShardDone(const SweepRun &run);
 
 SCDLLName("scsf_StrategyOptimizer");
 
@@ -30,15 +53,13 @@ SCSFExport scsf_StrategyOptimizer(SCStudyInterfaceRef sc)
 {
     InitializePersistentPointers(sc);
 
-    ReplayState &replayState = reinterpret_cast<ReplayState &>(sc.GetPersistentIntFast(PersistentVars::ReplayStateEnum));
-    int &comboIndex = sc.GetPersistentIntFast(PersistentVars::ComboIndex);
     auto *config = reinterpret_cast<StrategyOptimizerConfig *>(sc.GetPersistentPointer(PersistentVars::BacktestConfigPtr));
     auto *combinations = reinterpret_cast<std::vector<std::vector<double>> *>(sc.GetPersistentPointer(PersistentVars::CombinationsPtr));
     auto *logging = reinterpret_cast<Logging *>(sc.GetPersistentPointer(PersistentVars::LoggingPtr));
 
     if (sc.LastCallToFunction)
     {
-        StrategyOptimizerHelpers::HandleResetEvent(sc, replayState, comboIndex, config, combinations, logging);
+        StrategyOptimizerHelpers::HandleResetEvent(sc, config, combinations, logging);
         return;
     }
 
@@ -90,6 +111,7 @@ void HandleSetDefaults(SCStudyInterfaceRef sc)
     sc.AutoLoop = 0;
     sc.GraphRegion = 0;
     sc.MaintainTradeStatisticsAndTradesData = true;
+    sc.UpdateAlways = 1; // Keeps the replay watchdog ticking while a replay is stuck
 
     sc.Subgraph[Subgraphs::LogText].Name = "Log";
     sc.Subgraph[Subgraphs::LogText].DrawStyle = DRAWSTYLE_HIDDEN;
@@ -119,6 +141,10 @@ void HandleSetDefaults(SCStudyInterfaceRef sc)
     sc.Input[StudyInputs::TargetStudyRef].SetDescription("Only study id (first dropdown) required, subgraph index (second dropdown) values not used)");
     sc.Input[StudyInputs::TargetStudyRef].SetStudySubgraphValues(0, 0);
 
+    sc.Input[StudyInputs::JobQueueFilePath].Name = "Job Queue File Path";
+    sc.Input[StudyInputs::JobQueueFilePath].SetDescription("Queue of config files that Start runs back to back. Leave empty to run the config file above alone.");
+    sc.Input[StudyInputs::JobQueueFilePath].SetString("");
+
     OnChartLogging::AddLog(sc, "Strategy Optimizer defaults set.");
 }
 
@@ -147,9 +173,67 @@ void HandleFullRecalculation(SCStudyInterfaceRef sc)
 
 bool HandleReplayLogic(SCStudyInterfaceRef sc)
 {
-    ReplayState &replayState = reinterpret_cast<ReplayState &>(sc.GetPersistentIntFast(PersistentVars::ReplayStateEnum));
+    SweepRun *run = LaneDispatcher::FindRunForChart(sc.ChartNumber);
+    if (run == nullptr)
+    {
+        return false;
+    }
+
+    LaneState &lane = *LaneDispatcher::FindLane(*run, sc.ChartNumber);
+    const StrategyOptimizerConfig &config = *run->Config;
+    lane.Attached = true;
+
+    if (run->Coordinator != nullptr && sc.ChartNumber == run->DispatcherChartNumber)
+    {
+        run->Coordinator->Heartbeat();
+    }
+
+    auto *jobQueue = reinterpret_cast<JobQueue *>(sc.GetPersistentPointer(PersistentVars::JobQueuePtr));
+    if (jobQueue != nullptr && sc.ChartNumber == run->DispatcherChartNumber && sc.IsFullRecalculation == 0)
+    {
+        if (LaneDispatcher::IsFinished(*run) && LaneDispatcher::AreAllLanesIdle(*run))
+        {
+            // The job's summary is written, the next job takes over the charts
+            StrategyOptimizerHelpers::StartNextJob(sc);
+            return true;
+        }
+        if (!LaneDispatcher::HasWorkLeft(*run))
+        {
+            // Only the last combinations are left, the next job is ready by the time they finish
+            StrategyOptimizerHelpers::PrefetchNextJob(sc);
+        }
+    }
+
+    if (run->Portfolio != nullptr && run->Portfolio->IsNative())
+    {
+        // Nothing is replayed, the dispatcher chart evaluates one batch per study call
+        if (sc.IsFullRecalculation == 0)
+            RunNativeBatch(sc, *run);
+        return true;
+    }
+
+    if (sc.ChartNumber == run->DispatcherChartNumber && sc.IsFullRecalculation == 0 && LaneDispatcher::IsBatchReady(*run))
+    {
+        ReplayManager::StartLinkedReplay(sc, config, *run);
+        return true;
+    }
+
+    if (lane.State == ReplayState::Idle && sc.IsFullRecalculation == 0)
+    {
+        // Lane charts pick up work here, the dispatcher chart starts its first combination from the Start button
+        if ((!run->LinkedReplay || run->BatchOpen) && LaneDispatcher::ClaimNextCombination(*run, lane))
+        {
+            StrategyOptimizerHelpers::ApplyLogConfig(sc, config);
+            bool prepared = run->LinkedReplay ? ReplayManager::PrepareCombination(sc, config, *run, lane)
+                                              : ReplayManager::StartReplayForCombination(sc, config, *run, lane);
+            if (!prepared)
+                HandlePrepareFailure(sc, *run, lane);
+            return true;
+        }
+        return false;
+    }
 
-    if (replayState == ReplayState::WaitingForReplayToStart && sc.IsFullRecalculation == 0)
+    if (lane.State == ReplayState::WaitingForReplayToStart && sc.IsFullRecalculation == 0)
     {
         int replayStatus = sc.GetReplayStatusFromChart(sc.ChartNumber);
         SCString msg;
@@ -159,9 +243,14 @@ bool HandleReplayLogic(SCStudyInterfaceRef sc)
         if (replayStatus == REPLAY_RUNNING)
         {
             OnChartLogging::AddLog(sc, "Replay has started successfully.");
-            replayState = ReplayState::ReplayInProgress;
+            lane.State = ReplayState::ReplayInProgress;
+            lane.StateChangedTime = std::chrono::steady_clock::now();
             OnChartLogging::AddLog(sc, "State changed: Replay in progress.");
         }
+        else if (GetSecondsInCurrentState(lane) > config.WatchdogConfig.StartTimeoutSeconds)
+        {
+            HandleReplayTimeout(sc, *run, lane, "Replay did not start within the start timeout.");
+        }
         else if (replayStatus == REPLAY_STOPPED || replayStatus == REPLAY_PAUSED)
         {
             OnChartLogging::AddLog(sc, "Attempting to resume replay...");
@@ -170,78 +259,500 @@ bool HandleReplayLogic(SCStudyInterfaceRef sc)
         return true;
     }
 
-    if (replayState == ReplayState::ReplayInProgress && sc.GetReplayHasFinishedStatus())
+    if (lane.State == ReplayState::ReplayInProgress && sc.GetReplayHasFinishedStatus())
     {
-        HandleReplayCompletion(sc);
+        HandleReplayCompletion(sc, *run, lane);
+        return true;
+    }
+
+    if (lane.State == ReplayState::ReplayInProgress && HasReachedReplayEnd(sc, *run, lane))
+    {
+        OnChartLogging::AddLog(sc, "Replay reached the end of its date range, stopping replay.");
+        sc.StopChartReplay(sc.ChartNumber);
+        HandleReplayCompletion(sc, *run, lane);
+        return true;
+    }
+
+    if (lane.State == ReplayState::ReplayInProgress && config.WatchdogConfig.RunTimeoutSeconds > 0 && GetSecondsInCurrentState(lane) > config.WatchdogConfig.RunTimeoutSeconds)
+    {
+        HandleReplayTimeout(sc, *run, lane, "Replay did not finish within the run timeout.");
         return true;
     }
 
     return false;
 }
 
-void HandleReplayCompletion(SCStudyInterfaceRef sc)
+bool HasReachedReplayEnd(SCStudyInterfaceRef sc, const SweepRun &run, const LaneState &lane)
+{
+    // The replay has no end setting of its own, during a replay the current date time is the replay position
+    SCDateTime endDateTime = LaneDispatcher::GetReplayConfig(run, lane.ComboIndex).EndDateTime;
+    return endDateTime.GetAsDouble() != 0.0 && sc.GetCurrentDateTime() >= endDateTime;
+}
+
+double GetSecondsInCurrentState(const LaneState &lane)
+{
+    // Real time, during a replay the chart's date times follow the replay position
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - lane.StateChangedTime).count();
+}
+
+std::vector<std::pair<std::string, double>> GetCombinationParams(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config, const std::vector<double> &combo, unsigned int studyID)
+{
+    std::vector<std::pair<std::string, double>> params;
+    for (size_t i = 0; i < combo.size(); ++i)
+    {
+        SCString inputName;
+        sc.GetStudyInputName(sc.ChartNumber, studyID, config.ParamConfigs[i].Index, inputName);
+        params.push_back({inputName.GetChars(), combo[i]});
+    }
+    return params;
+}
+
+std::string GetReportPath(SCStudyInterfaceRef sc, const SweepRun &run, int comboIndex, n_ACSIL::s_CustomStudyInformation &customStudyInfo)
+{
+    unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+    sc.GetCustomStudyInformation(sc.ChartNumber, studyID, customStudyInfo);
+
+    if (run.WalkForward != nullptr)
+    {
+        std::string reportDir = WalkForward::GetReportDirectory(*run.WalkForward, run.ResultsDir, comboIndex);
+        std::filesystem::create_directories(reportDir);
+        return reportDir + WalkForward::GetReportFileName(*run.WalkForward, comboIndex);
+    }
+
+    std::stringstream reportFileName;
+    reportFileName << customStudyInfo.DLLFileName
+                   << "-" << LaneDispatcher::GetGlobalComboIndex(run, comboIndex);
+
+    // Symbol charts of a portfolio keep their own reports in a folder per chart, the combination's report is the portfolio's
+    std::string reportDir = run.ResultsDir;
+    if (run.Portfolio != nullptr)
+        reportDir += "chart-" + std::to_string(sc.ChartNumber) + "-" + Portfolio::GetSymbolFileName(sc.Symbol.GetChars()) + "/";
+
+    std::filesystem::create_directories(reportDir);
+    return reportDir + reportFileName.str() + ".json";
+}
+
+int MarkShardDone(const SweepRun &run)
+{
+    const ShardConfig &shardConfig = run.Config->ShardConfig;
+    std::ofstream(run.ResultsDir + "shard-" + std::to_string(shardConfig.ShardIndex) + "-of-" + std::to_string(shardConfig.ShardCount) + ".done").close();
+
+    int doneShards = 0;
+    for (int i = 0; i < shardConfig.ShardCount; ++i)
+    {
+        if (std::filesystem::exists(run.ResultsDir + "shard-" + std::to_string(i) + "-of-" + std::to_string(shardConfig.ShardCount) + ".done"))
+        {
+            doneShards++;
+        }
+    }
+    return doneShards;
+}
+
+void HandleReplayTimeout(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane, const char *reason)
 {
-    int &comboIndex = sc.GetPersistentIntFast(PersistentVars::ComboIndex);
-    auto *combinations = reinterpret_cast<std::vector<std::vector<double>> *>(sc.GetPersistentPointer(PersistentVars::CombinationsPtr));
-    auto *config = reinterpret_cast<StrategyOptimizerConfig *>(sc.GetPersistentPointer(PersistentVars::BacktestConfigPtr));
     auto *logging = reinterpret_cast<Logging *>(sc.GetPersistentPointer(PersistentVars::LoggingPtr));
-    ReplayState &replayState = reinterpret_cast<ReplayState &>(sc.GetPersistentIntFast(PersistentVars::ReplayStateEnum));
+    const StrategyOptimizerConfig &config = *run.Config;
 
     SCString msg;
-    msg.Format("--- Combination %d/%d finished ---", comboIndex + 1, (int)combinations->size());
+    msg.Format("Watchdog: %s (combination %d/%d, retry %d/%d)", reason, lane.ComboIndex + 1, LaneDispatcher::GetWorkItemCount(run), lane.RetryCount, config.WatchdogConfig.MaxRetries);
     OnChartLogging::AddLog(sc, msg);
 
-    const auto &currentCombo = (*combinations)[comboIndex];
-    unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
-    std::vector<std::pair<std::string, double>> params;
+    sc.StopChartReplay(sc.ChartNumber);
 
-    std::stringstream paramStream;
-    for (size_t i = 0; i < currentCombo.size(); ++i)
+    // Restarting one lane of a linked replay would restart every linked chart, so linked lanes fail straight away
+    if (!run.LinkedReplay && lane.RetryCount < config.WatchdogConfig.MaxRetries)
     {
-        SCString inputName;
-        sc.GetStudyInputName(sc.ChartNumber, studyID, config->ParamConfigs[i].Index, inputName);
-        params.push_back({inputName.GetChars(), currentCombo[i]});
-        paramStream << "-" << inputName.GetChars() << "-" << currentCombo[i];
+        lane.RetryCount++;
+        OnChartLogging::AddLog(sc, "Watchdog: Restarting replay for the same combination.");
+        if (!ReplayManager::StartReplayForCombination(sc, config, run, lane))
+            HandlePrepareFailure(sc, run, lane);
+        return;
     }
 
-    SCDateTime &backtestStartDateTime = sc.GetPersistentSCDateTimeFast(PersistentVars::BacktestStartDateTime);
-    std::string startDateTimeString(sc.FormatDateTime(backtestStartDateTime).GetChars());
-    std::replace(startDateTimeString.begin(), startDateTimeString.end(), '/', '-');
-    std::replace(startDateTimeString.begin(), startDateTimeString.end(), ':', '-');
-    std::replace(startDateTimeString.begin(), startDateTimeString.end(), ' ', '_');
+    OnChartLogging::AddLog(sc, "Watchdog: Retries exhausted, recording failure and skipping combination.");
 
+    unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
     n_ACSIL::s_CustomStudyInformation customStudyInfo;
-    sc.GetCustomStudyInformation(sc.ChartNumber, studyID, customStudyInfo);
+    std::string reportPath = GetReportPath(sc, run, lane.ComboIndex, customStudyInfo);
+    logging->LogFailure(sc, reportPath, GetCombinationParams(sc, config, (*run.Combinations)[LaneDispatcher::GetComboIndex(run, lane.ComboIndex)], studyID), studyID, LaneDispatcher::GetGlobalComboIndex(run, lane.ComboIndex), reason, lane.RetryCount);
+    if (run.Portfolio != nullptr)
+    {
+        RecordPortfolioSymbol(sc, run, lane, reason);
+    }
 
-    std::stringstream reportFileName;
-    reportFileName << customStudyInfo.DLLFileName
-                   << "-" << comboIndex;
+    ProceedToNextCombination(sc, run, lane);
+}
+
+void HandleReplayCompletion(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane)
+{
+    auto *logging = reinterpret_cast<Logging *>(sc.GetPersistentPointer(PersistentVars::LoggingPtr));
+
+    SCString msg;
+    msg.Format("--- Combination %d/%d finished on chart %d ---", lane.ComboIndex + 1, LaneDispatcher::GetWorkItemCount(run), sc.ChartNumber);
+    OnChartLogging::AddLog(sc, msg);
 
-    std::string resultsDir = std::filesystem::path(sc.Input[StudyInputs::ConfigFilePath].GetString()).parent_path().string() + "/results/" + customStudyInfo.DLLFileName.GetChars() + "-" + startDateTimeString + "/";
-    std::filesystem::create_directories(resultsDir);
-    std::string reportPath = resultsDir + reportFileName.str() + ".json";
+    unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+    std::vector<std::pair<std::string, double>> params = GetCombinationParams(sc, *run.Config, (*run.Combinations)[LaneDispatcher::GetComboIndex(run, lane.ComboIndex)], studyID);
+
+    n_ACSIL::s_CustomStudyInformation customStudyInfo;
+    std::string reportPath = GetReportPath(sc, run, lane.ComboIndex, customStudyInfo);
 
-    logging->LogMetrics(sc, customStudyInfo.DLLFileName.GetChars(), reportPath, params, studyID);
+    // A linked replay runs the whole batch at once, each of its combinations is charged the time of the batch
+    logging->LogMetrics(sc, customStudyInfo.DLLFileName.GetChars(), reportPath, params, studyID, LaneDispatcher::GetGlobalComboIndex(run, lane.ComboIndex), GetSecondsInCurrentState(lane));
     OnChartLogging::AddLog(sc, "Logged metrics for completed combination.");
 
-    replayState = ReplayState::Idle;
-    comboIndex++;
+    if (run.Portfolio != nullptr)
+    {
+        RecordPortfolioSymbol(sc, run, lane, "");
+    }
+
+    if (run.WalkForward != nullptr && WalkForward::IsOutOfSample(*run.WalkForward, lane.ComboIndex))
+    {
+        WalkForward::RecordOutOfSample(*run.WalkForward, lane.ComboIndex, TradeMetricsCalculator::GetTradeSeries(sc));
+    }
+
+    if (run.Surrogate != nullptr)
+    {
+        CombinationResult result = ResultAnalyzer::ParseJsonResult(reportPath, sc);
+        if (result.status == "completed")
+        {
+            run.Surrogate->TrainingCombos.push_back(LaneDispatcher::GetComboIndex(run, lane.ComboIndex));
+            run.Surrogate->TrainingValues.push_back(result.GetMetric(run.Config->SurrogateConfig.Objective.Metric));
+        }
+    }
+
+    ProceedToNextCombination(sc, run, lane);
+}
+
+void ProceedToNextCombination(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane)
+{
+    if (!CompleteCombination(sc, run, lane))
+    {
+        return;
+    }
 
-    if (comboIndex < (int)combinations->size())
+    if (run.LinkedReplay)
+    {
+        if (LaneDispatcher::AreAllLanesIdle(run))
+        {
+            // The whole batch has been logged, lanes may claim the next one
+            OnChartLogging::AddLog(sc, "Linked replay batch finished, preparing next batch.");
+            run.BatchOpen = true;
+        }
+        return;
+    }
+
+    if (LaneDispatcher::ClaimNextCombination(run, lane))
     {
         OnChartLogging::AddLog(sc, "Proceeding to next combination.");
         sc.StopChartReplay(sc.ChartNumber);
-        ReplayManager::StartReplayForCombination(sc, *config, *combinations, comboIndex, replayState);
+        if (!ReplayManager::StartReplayForCombination(sc, *run.Config, run, lane))
+            HandlePrepareFailure(sc, run, lane);
     }
     else
     {
-        OnChartLogging::AddLog(sc, "--- All combinations finished. Backtesting complete. ---");
-        ResultAnalyzer::AnalyzeResults(sc, resultsDir, resultsDir + reportFileName.str() + "-summary.csv");
-        if (config->OpenResultsFolder)
+        SCString msg;
+        msg.Format("No combinations left to claim, waiting for other lanes (%d/%d finished).", run.CompletedCount, LaneDispatcher::GetWorkItemCount(run));
+        OnChartLogging::AddLog(sc, msg);
+    }
+}
+
+// Counts the lane's combination as done, false once that finished the run
+bool CompleteCombination(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane)
+{
+    int workItem = lane.ComboIndex;
+    LaneDispatcher::CompleteLane(run, lane);
+    if (run.WalkForward != nullptr)
+    {
+        CompleteWalkForwardItem(sc, run, workItem);
+    }
+
+    if (run.Portfolio != nullptr && LaneDispatcher::AreAllLanesIdle(run))
+    {
+        // Every symbol chart has reported this combination
+        LogPortfolio(sc, run, workItem, GetSecondsInCurrentState(lane));
+        run.Portfolio->BatchComboIndex = -1;
+    }
+
+    if (LaneDispatcher::IsFinished(run))
+    {
+        FinishRun(sc, run);
+        return false;
+    }
+
+    if (run.Surrogate != nullptr)
+    {
+        UpdateSurrogate(sc, run);
+    }
+    return true;
+}
+
+void HandlePrepareFailure(SCStudyInterfaceRef sc, SweepRun &run, LaneState &lane)
+{
+    auto *logging = reinterpret_cast<Logging *>(sc.GetPersistentPointer(PersistentVars::LoggingPtr));
+    const char *reason = "The target study of the chart could not be found";
+
+    // Recorded as failed and counted, so the sweep still reaches its end. The lane is idle again and claims its
+    // next combination on the next study call, not from here.
+    unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+    n_ACSIL::s_CustomStudyInformation customStudyInfo;
+    std::string reportPath = GetReportPath(sc, run, lane.ComboIndex, customStudyInfo);
+    logging->LogFailure(sc, reportPath, GetCombinationParams(sc, *run.Config, (*run.Combinations)[LaneDispatcher::GetComboIndex(run, lane.ComboIndex)], studyID), studyID, LaneDispatcher::GetGlobalComboIndex(run, lane.ComboIndex), reason, 0);
+    if (run.Portfolio != nullptr)
+    {
+        RecordPortfolioSymbol(sc, run, lane, reason);
+    }
+
+    CompleteCombination(sc, run, lane);
+}
+
+void FinishRun(SCStudyInterfaceRef sc, SweepRun &run)
+{
+    // Lanes complete in any order, whichever lane finishes the last combination writes the summary
+    OnChartLogging::AddLog(sc, "--- All combinations finished. Backtesting complete. ---");
+    if (run.Coordinator != nullptr && !run.Coordinator->TryAcquireSummary())
+    {
+        OnChartLogging::AddLog(sc, "Summary report is written by another worker of the distributed sweep.");
+        return;
+    }
+    if (run.Config->ShardConfig.ShardCount > 1)
+    {
+        // Every shard merges whatever reports are in the shared folder, the last shard to finish sees them all
+        int doneShards = MarkShardDone(run);
+        SCString msg;
+        msg.Format("Shard %d of %d finished, %d of %d shards done.", run.Config->ShardConfig.ShardIndex, run.Config->ShardConfig.ShardCount, doneShards, run.Config->ShardConfig.ShardCount);
+        OnChartLogging::AddLog(sc, msg);
+    }
+    if (run.WalkForward != nullptr)
+        WalkForward::WriteResults(sc, *run.WalkForward, run.SummaryPath);
+    else
+        ResultAnalyzer::AnalyzeResults(sc, run.ResultsDir, run.SummaryPath, *run.Config);
+    if (run.Coordinator != nullptr)
+        run.Coordinator->ReleaseSummary();
+    if (run.Config->OpenResultsFolder)
+    {
+        ShellExecuteA(NULL, "open", run.ResultsDir.c_str(), NULL, NULL, SW_SHOWNORMAL);
+    }
+}
+
+void RecordPortfolioSymbol(SCStudyInterfaceRef sc, SweepRun &run, const LaneState &lane, const std::string &failureReason)
+{
+    PortfolioSymbol &symbol = run.Portfolio->Symbols[&lane - run.Lanes.data()];
+    symbol.Name = sc.Symbol.GetChars();
+    symbol.Trades.clear();
+    symbol.FailureReason = failureReason;
+    symbol.Done = true;
+    if (!failureReason.empty())
+        return;
+
+    for (int i = 0; i < sc.GetTradeListSize(); ++i)
+    {
+        s_ACSTrade trade;
+        if (sc.GetTradeListEntry(i, trade))
+            symbol.Trades.push_back(trade);
+    }
+}
+
+void LogPortfolio(SCStudyInterfaceRef sc, SweepRun &run, int workItem, double seconds)
+{
+    auto *logging = reinterpret_cast<Logging *>(sc.GetPersistentPointer(PersistentVars::LoggingPtr));
+    PortfolioState &portfolio = *run.Portfolio;
+
+    unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+    n_ACSIL::s_CustomStudyInformation customStudyInfo;
+    sc.GetCustomStudyInformation(sc.ChartNumber, studyID, customStudyInfo);
+
+    int globalIndex = LaneDispatcher::GetGlobalComboIndex(run, workItem);
+    std::string reportPath = run.ResultsDir + customStudyInfo.DLLFileName.GetChars() + "-" + std::to_string(globalIndex) + ".json";
+    std::vector<std::pair<std::string, double>> params = GetCombinationParams(sc, *run.Config, (*run.Combinations)[LaneDispatcher::GetComboIndex(run, workItem)], studyID);
+
+    std::string failureReason = Portfolio::GetFailureReason(portfolio.Symbols);
+    if (failureReason.empty())
+    {
+        Portfolio::LogMetrics(sc, reportPath, portfolio.Symbols, params, studyID, globalIndex, seconds);
+    }
+    else
+    {
+        SCString msg;
+        msg.Format("Portfolio of combination %d not counted: %s", workItem + 1, failureReason.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        logging->LogFailure(sc, reportPath, params, studyID, globalIndex, failureReason.c_str(), 0);
+    }
+    Portfolio::ResetSymbols(portfolio);
+}
+
+void RunNativeBatch(SCStudyInterfaceRef sc, SweepRun &run)
+{
+    const StrategyOptimizerConfig &config = *run.Config;
+    PortfolioState &portfolio = *run.Portfolio;
+    LaneState &lane = run.Lanes.front();
+
+    std::vector<int> workItems;
+    while ((int)workItems.size() < config.PortfolioConfig.BatchSize && LaneDispatcher::ClaimNextCombination(run, lane))
+    {
+        workItems.push_back(lane.ComboIndex);
+    }
+    if (workItems.empty())
+    {
+        return;
+    }
+
+    // Engines take a value for every input, the combinations only hold the varying ones
+    std::vector<std::vector<double>> inputValues;
+    for (int workItem : workItems)
+    {
+        inputValues.push_back(CombinationGenerator::ExpandCombination(config.ParamConfigs, (*run.Combinations)[LaneDispatcher::GetComboIndex(run, workItem)]));
+    }
+
+    // Every combination of the batch on every symbol, runs only read their engine so symbols are shared between threads
+    int symbolCount = (int)portfolio.Symbols.size();
+    int threadCount = Parallel::GetThreadCount(config.PortfolioConfig.Threads);
+    if ((int)portfolio.Simulators.size() != threadCount)
+    {
+        portfolio.Simulators.assign(threadCount, FillSimulator(portfolio.Engines.front()->GetFillConfig())); // Symbols share the fill settings
+        portfolio.ThreadTrades.assign(threadCount, std::vector<s_ACSTrade>());
+    }
+    std::vector<PortfolioSymbol> &results = portfolio.BatchResults;
+    results.resize((std::max)(results.size(), workItems.size() * symbolCount));
+    std::vector<double> seconds(workItems.size() * symbolCount, 0.0);
+    Parallel::ForEach(threadCount, (int)seconds.size(), [&](int thread, int item)
+                      {
+                          int symbol = item % symbolCount;
+                          const std::vector<double> &combination = inputValues[item / symbolCount];
+                          auto started = std::chrono::steady_clock::now();
+                          std::string error;
+                          std::vector<s_ACSTrade> &trades = portfolio.ThreadTrades[thread];
+                          PortfolioSymbol &result = results[item];
+                          result.Trades.clear();
+                          result.FailureReason.clear();
+                          if (portfolio.Engines[symbol]->Run(config.ParamConfigs, combination, config.ReplayConfig.StartDateTime, config.ReplayConfig.EndDateTime, portfolio.Simulators[thread], trades, error))
+                              result.Trades.assign(trades.begin(), trades.end());
+                          else
+                              result.FailureReason = error;
+                          result.Done = true;
+                          seconds[item] = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+                      });
+
+    // Swapped rather than moved, so the trades the report was written from hand their capacity to the next batch
+    for (int i = 0; i < (int)workItems.size(); ++i)
+    {
+        double combinationSeconds = 0.0;
+        for (int symbol = 0; symbol < symbolCount; ++symbol)
+        {
+            PortfolioSymbol &result = results[i * symbolCount + symbol];
+            portfolio.Symbols[symbol].Trades.swap(result.Trades);
+            portfolio.Symbols[symbol].FailureReason.swap(result.FailureReason);
+            portfolio.Symbols[symbol].Done = result.Done;
+            combinationSeconds += seconds[i * symbolCount + symbol];
+        }
+        LogPortfolio(sc, run, workItems[i], combinationSeconds);
+        run.CompletedCount++;
+    }
+    lane.ComboIndex = -1;
+
+    SCString msg;
+    msg.Format("Native portfolio: %d/%d combinations evaluated over %d symbols.", run.CompletedCount, LaneDispatcher::GetWorkItemCount(run), symbolCount);
+    OnChartLogging::AddLog(sc, msg);
+
+    if (LaneDispatcher::IsFinished(run))
+    {
+        FinishRun(sc, run);
+    }
+}
+
+void CompleteWalkForwardItem(SCStudyInterfaceRef sc, SweepRun &run, int workItem)
+{
+    WalkForwardPlan &plan = *run.WalkForward;
+    if (WalkForward::IsOutOfSample(plan, workItem))
+    {
+        return;
+    }
+
+    int windowIndex = WalkForward::GetWindowIndex(plan, workItem);
+    WalkForwardWindow &window = plan.Windows[windowIndex];
+    if (--window.RemainingInSample > 0)
+    {
+        return;
+    }
+
+    // The in-sample sweep of this window is complete, analyze it like a normal sweep and replay its winner out of sample
+    SCString msg;
+    std::string windowDir = WalkForward::GetReportDirectory(plan, run.ResultsDir, workItem);
+    std::vector<CombinationResult> results = ResultAnalyzer::AnalyzeResults(sc, windowDir, windowDir + plan.FilePrefix + "-summary.csv", *run.Config);
+
+    const ObjectiveConfig &objective = run.Config->WalkForwardConfig.Objective;
+    window.BestComboIndex = WalkForward::SelectBest(results, objective, window.BestObjective);
+    if (window.BestComboIndex < 0)
+    {
+        // Nothing to replay, the out-of-sample item counts as done
+        msg.Format("Walk-forward window %d has no completed in-sample combination, skipping its out-of-sample replay.", windowIndex);
+        OnChartLogging::AddLog(sc, msg);
+        run.CompletedCount++;
+        return;
+    }
+
+    msg.Format("Walk-forward window %d: combination %d is best in sample (%s %.4f), queued for its out-of-sample replay.", windowIndex, window.BestComboIndex, objective.Name.c_str(), window.BestObjective);
+    OnChartLogging::AddLog(sc, msg);
+    run.RequeuedComboIndices.push_back(WalkForward::GetOutOfSampleItem(plan, windowIndex));
+}
+
+void UpdateSurrogate(SCStudyInterfaceRef sc, SweepRun &run)
+{
+    SurrogateState &surrogate = *run.Surrogate;
+    const SurrogateConfig &surrogateConfig = run.Config->SurrogateConfig;
+    SCString msg;
+
+    if (surrogate.Ranking.valid())
+    {
+        if (surrogate.Ranking.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        std::vector<int> ranked;
+        try
         {
-            ShellExecuteA(NULL, "open", resultsDir.c_str(), NULL, NULL, SW_SHOWNORMAL);
+            ranked = surrogate.Ranking.get();
         }
+        catch (const std::exception &e)
+        {
+            // The queue keeps its current order, the next refit tries again
+            msg.Format("Surrogate model failed: %s", e.what());
+            OnChartLogging::AddLog(sc, msg);
+            return;
+        }
+
+        // Lanes kept claiming while the model was fitted, those combinations are no longer in the queue
+        std::vector<char> claimed(run.Combinations->size(), 0);
+        for (int position = surrogate.RankedFrom; position < run.NextComboIndex; ++position)
+        {
+            claimed[run.ComboOrder[position]] = 1;
+        }
+        int position = run.NextComboIndex;
+        for (int combo : ranked)
+        {
+            if (!claimed[combo])
+                run.ComboOrder[position++] = combo;
+        }
+
+        surrogate.FitCount++;
+        msg.Format("Surrogate model %d fitted on %d combinations, %d queued combinations reordered.", surrogate.FitCount, surrogate.FittedCount, (std::max)(0, run.EndComboIndex - run.NextComboIndex));
+        OnChartLogging::AddLog(sc, msg);
     }
+
+    int trainingCount = (int)surrogate.TrainingValues.size();
+    if (trainingCount < surrogateConfig.WarmUp || (surrogate.FittedCount > 0 && trainingCount - surrogate.FittedCount < surrogateConfig.RefitEvery))
+        return;
+    if (run.NextComboIndex >= run.EndComboIndex)
+        return;
+
+    // Everything not claimed yet is ranked, the combinations past the budget included, so a later fit can pull them in.
+    // The worker gets copies of what changes while it runs, the combinations stay untouched until the run ends.
+    std::vector<int> candidates(run.ComboOrder.begin() + run.NextComboIndex, run.ComboOrder.end());
+    surrogate.FittedCount = trainingCount;
+    surrogate.RankedFrom = run.NextComboIndex;
+    surrogate.Ranking = std::async(std::launch::async, SurrogateModel::Rank, std::cref(*run.Combinations), surrogate.TrainingCombos, surrogate.TrainingValues, std::move(candidates), surrogateConfig);
+
+    msg.Format("Fitting surrogate model on %d combinations to rank %d candidates in the background.", trainingCount, (int)run.ComboOrder.size() - run.NextComboIndex);
+    OnChartLogging::AddLog(sc, msg);
 }
 
 void HandleMenuEvents(SCStudyInterfaceRef sc)
@@ -251,29 +762,32 @@ void HandleMenuEvents(SCStudyInterfaceRef sc)
     SCInputRef Input_VerifyConfig = sc.Input[StudyInputs::VerifyConfigButtonNumber];
     SCInputRef Input_GenerateConfig = sc.Input[StudyInputs::GenerateConfigButtonNumber];
     SCInputRef Input_ConfigFilePath = sc.Input[StudyInputs::ConfigFilePath];
+    SCInputRef Input_JobQueueFilePath = sc.Input[StudyInputs::JobQueueFilePath];
 
-    ReplayState &replayState = reinterpret_cast<ReplayState &>(sc.GetPersistentIntFast(PersistentVars::ReplayStateEnum));
-    int &comboIndex = sc.GetPersistentIntFast(PersistentVars::ComboIndex);
     auto *config = reinterpret_cast<StrategyOptimizerConfig *>(sc.GetPersistentPointer(PersistentVars::BacktestConfigPtr));
     auto *combinations = reinterpret_cast<std::vector<std::vector<double>> *>(sc.GetPersistentPointer(PersistentVars::CombinationsPtr));
     auto *logging = reinterpret_cast<Logging *>(sc.GetPersistentPointer(PersistentVars::LoggingPtr));
 
     if (sc.MenuEventID == Input_Start.GetInt())
     {
-        if (sc.GlobalTradeSimulationIsOn)
+        if (!sc.GlobalTradeSimulationIsOn)
         {
-            StrategyOptimizerHelpers::HandleStartEvent(sc, Input_ConfigFilePath, config, combinations, replayState, comboIndex);
+            OnChartLogging::AddLog(sc, "Trade Simulation Mode is off.");
+        }
+        else if (std::string(Input_JobQueueFilePath.GetString()).empty())
+        {
+            StrategyOptimizerHelpers::HandleStartEvent(sc, Input_ConfigFilePath, config, combinations);
         }
         else
         {
-            OnChartLogging::AddLog(sc, "Trade Simulation Mode is off.");
+            StrategyOptimizerHelpers::HandleStartQueueEvent(sc, Input_JobQueueFilePath);
         }
         ReplayManager::ResetButton(sc, Input_Start);
     }
     else if (sc.MenuEventID == Input_Reset.GetInt())
     {
         sc.StopChartReplay(sc.ChartNumber);
-        StrategyOptimizerHelpers::HandleResetEvent(sc, replayState, comboIndex, config, combinations, logging);
+        StrategyOptimizerHelpers::HandleResetEvent(sc, config, combinations, logging);
         ReplayManager::ResetButton(sc, Input_Reset);
     }
     else if (sc.MenuEventID == Input_VerifyConfig.GetInt())
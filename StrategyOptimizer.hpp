@@ -11,10 +11,17 @@
 
 namespace StrategyOptimizerHelpers
 {
-    void HandleStartEvent(SCStudyInterfaceRef sc, SCInputRef Input_ConfigFilePath, StrategyOptimizerConfig* config, std::vector<std::vector<double>>* combinations, ReplayState& replayState, int& ComboIndex);
-    void HandleResetEvent(SCStudyInterfaceRef sc, ReplayState& replayState, int& ComboIndex, StrategyOptimizerConfig* config, std::vector<std::vector<double>>* combinations, Logging* logging);
+    void HandleStartEvent(SCStudyInterfaceRef sc, SCInputRef Input_ConfigFilePath, StrategyOptimizerConfig* config, std::vector<std::vector<double>>* combinations);
+    void HandleStartQueueEvent(SCStudyInterfaceRef sc, SCInputRef Input_JobQueueFilePath);
+    void HandleResetEvent(SCStudyInterfaceRef sc, StrategyOptimizerConfig* config, std::vector<std::vector<double>>* combinations, Logging* logging);
     void HandleVerifyConfigEvent(SCStudyInterfaceRef sc, SCInputRef Input_ConfigFilePath, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations);
     void HandleGenerateConfigEvent(SCStudyInterfaceRef sc);
+    void ApplyLogConfig(SCStudyInterfaceRef sc, const StrategyOptimizerConfig& config);
+    std::string GetResultsDirectory(SCStudyInterfaceRef sc, const std::string& configPath, const StrategyOptimizerConfig& config, const n_ACSIL::s_CustomStudyInformation& customStudyInfo);
+    void EndSweepRun(SCStudyInterfaceRef sc);
+    void StartNextJob(SCStudyInterfaceRef sc);
+    void PrefetchNextJob(SCStudyInterfaceRef sc);
+    void EndJobQueue(SCStudyInterfaceRef sc);
 }
 
 #endif
\ No newline at end of file
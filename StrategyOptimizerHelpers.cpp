@@ -10,6 +10,9 @@
 #include "ResultAnalyzer.hpp"
 #include "CombinationGenerator.hpp"
 #include "InputParameter.hpp"
+#include "LaneDispatcher.hpp"
+#include "ParityHarness.hpp"
+#include "JobQueue.hpp"
 #include <string>
 #include <vector>
 #include <utility>
@@ -17,6 +20,7 @@
 #include <filesystem>
 #include <sstream>
 #include <algorithm>
+#include <future>
 #include <windows.h>
 #include <fstream>
 #include "nlohmann/json.hpp"
@@ -26,58 +30,533 @@ using json = nlohmann::json;
 
 namespace StrategyOptimizerHelpers
 {
-    void HandleStartEvent(SCStudyInterfaceRef sc, SCInputRef Input_ConfigFilePath, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations, ReplayState &replayState, int &ComboIndex)
+    void ApplyLogConfig(SCStudyInterfaceRef sc, const StrategyOptimizerConfig &config)
     {
+        int &enableLog = sc.GetPersistentIntFast(PersistentVars::EnableLog);
+        enableLog = config.LogConfig.EnableLog;
+
+        int &enableShowLogOnChart = sc.GetPersistentIntFast(PersistentVars::EnableShowLogOnChart);
+        enableShowLogOnChart = config.LogConfig.EnableShowLogOnChart;
+
+        int &maxLogLines = sc.GetPersistentIntFast(PersistentVars::MaxLogLines);
+        maxLogLines = config.LogConfig.MaxLogLines;
+    }
+
+    std::string GetResultsDirectory(SCStudyInterfaceRef sc, const std::string &configPath, const StrategyOptimizerConfig &config, const n_ACSIL::s_CustomStudyInformation &customStudyInfo)
+    {
+        std::string resultsRoot = std::filesystem::path(configPath).parent_path().string() + "/results/";
+        if (config.ShardConfig.ShardCount > 1)
+        {
+            // All shards of a run write into one folder so the last shard can merge them
+            return resultsRoot + customStudyInfo.DLLFileName.GetChars() + "-" + config.ShardConfig.RunName + "/";
+        }
+
+        SCDateTime &backtestStartDateTime = sc.GetPersistentSCDateTimeFast(PersistentVars::BacktestStartDateTime);
+        std::string startDateTimeString(sc.FormatDateTime(backtestStartDateTime).GetChars());
+        std::replace(startDateTimeString.begin(), startDateTimeString.end(), '/', '-');
+        std::replace(startDateTimeString.begin(), startDateTimeString.end(), ':', '-');
+        std::replace(startDateTimeString.begin(), startDateTimeString.end(), ' ', '_');
+
+        return resultsRoot + customStudyInfo.DLLFileName.GetChars() + "-" + startDateTimeString + "/";
+    }
+
+    void EndSweepRun(SCStudyInterfaceRef sc)
+    {
+        auto *run = reinterpret_cast<SweepRun *>(sc.GetPersistentPointer(PersistentVars::SweepRunPtr));
+        if (run != nullptr)
+        {
+            // The dispatcher owns the run, stop every lane it handed work to
+            for (const auto &lane : run->Lanes)
+            {
+                if (lane.ChartNumber != sc.ChartNumber && lane.State != ReplayState::Idle)
+                {
+                    sc.StopChartReplay(lane.ChartNumber);
+                }
+            }
+            if (run->Coordinator != nullptr)
+            {
+                run->Coordinator->ReleaseAll();
+                delete run->Coordinator;
+            }
+            delete run->WalkForward;
+
+            // Waits for a ranking still being computed, it reads the combinations
+            delete run->Surrogate;
+            delete run->Portfolio;
+            LaneDispatcher::UnregisterRun(run);
+            delete run;
+            sc.SetPersistentPointer(PersistentVars::SweepRunPtr, nullptr);
+            return;
+        }
+
+        // A lane chart leaving an active run hands its combination back to the dispatcher
+        SweepRun *otherRun = LaneDispatcher::FindRunForChart(sc.ChartNumber);
+        if (otherRun != nullptr)
+        {
+            LaneDispatcher::ReleaseLane(*otherRun, *LaneDispatcher::FindLane(*otherRun, sc.ChartNumber));
+        }
+    }
+
+    GeneratedCombinations GenerateCombinations(const std::vector<InputConfig> &paramConfigs, const ShardConfig &shardConfig)
+    {
+        GeneratedCombinations generated;
+        if (shardConfig.ShardCount > 1)
+        {
+            generated.Combinations = CombinationGenerator::GenerateShard(paramConfigs, shardConfig, generated.GlobalComboIndices);
+        }
+        else
+        {
+            generated.Combinations = CombinationGenerator::GenerateIterative(paramConfigs);
+        }
+        return generated;
+    }
+
+    bool LoadSweepConfig(SCStudyInterfaceRef sc, const std::string &configPath, StrategyOptimizerConfig &config)
+    {
+        config.ParamConfigs.clear();
+        SCString msg;
+        msg.Format("Attempting to load configuration from '%s'...", configPath.c_str());
+        OnChartLogging::AddLog(sc, msg);
+
+        if (!ConfigLoader::LoadConfig(sc, configPath, config))
+        {
+            OnChartLogging::AddLog(sc, "Failed to load config file.");
+            return false;
+        }
+        return true;
+    }
+
+    // Starts the sweep of a loaded config, false when it could not start. A parity check runs to the end here and leaves no run.
+    bool StartSweep(SCStudyInterfaceRef sc, const std::string &configPath, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations, std::vector<int> globalComboIndices, const std::string &resumeDir, std::string &error);
+
+    void HandleStartEvent(SCStudyInterfaceRef sc, SCInputRef Input_ConfigFilePath, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations)
+    {
+        SweepRun *activeRun = LaneDispatcher::FindRunForChart(sc.ChartNumber);
+        if (activeRun != nullptr && activeRun->DispatcherChartNumber != sc.ChartNumber)
+        {
+            SCString msg;
+            msg.Format("This chart is a lane of the run started on chart %d. Reset that run first.", activeRun->DispatcherChartNumber);
+            OnChartLogging::AddLog(sc, msg);
+            return;
+        }
+        EndSweepRun(sc);
+        EndJobQueue(sc);
+
         SCDateTime &backtestStartDateTime = sc.GetPersistentSCDateTimeFast(PersistentVars::BacktestStartDateTime);
         backtestStartDateTime = sc.CurrentSystemDateTimeMS;
 
-        ComboIndex = 0;
-        config->ParamConfigs.clear();
         combinations->clear();
         OnChartLogging::AddLog(sc, "'Start Replay' button clicked.");
-        SCString configPath = Input_ConfigFilePath.GetString();
+        std::string configPath = Input_ConfigFilePath.GetString();
+        if (!LoadSweepConfig(sc, configPath, *config))
+        {
+            return;
+        }
+
+        OnChartLogging::AddLog(sc, "Configuration loaded successfully. Generating parameter combinations...");
+        GeneratedCombinations generated = GenerateCombinations(config->ParamConfigs, config->ShardConfig);
+        *combinations = std::move(generated.Combinations);
+
+        std::string error;
+        StartSweep(sc, configPath, config, combinations, std::move(generated.GlobalComboIndices), "", error);
+    }
+
+    bool StartSweep(SCStudyInterfaceRef sc, const std::string &configPath, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations, std::vector<int> globalComboIndices, const std::string &resumeDir, std::string &error)
+    {
         SCString msg;
-        msg.Format("Attempting to load configuration from '%s'...", configPath.GetChars());
+        ApplyLogConfig(sc, *config);
+        if (combinations->empty() && config->ParamConfigs.empty())
+        {
+            error = "No varying parameters found.";
+            OnChartLogging::AddLog(sc, "No varying parameters found.");
+            return false;
+        }
+
+        msg.Format("Generated %d combinations.", (int)combinations->size());
         OnChartLogging::AddLog(sc, msg);
 
-        bool isConfigLoaded = false;
-        if (ConfigLoader::LoadConfig(sc, configPath.GetChars(), *config))
+        if (!config->ParityConfig.ReferenceDirectory.empty())
         {
-            OnChartLogging::AddLog(sc, "Configuration loaded successfully. Generating parameter combinations...");
-            *combinations = CombinationGenerator::GenerateIterative(config->ParamConfigs);
+            // The reference replays are compared with native runs of their combinations, nothing is replayed
+            OnChartLogging::AddLog(sc, "Running the parity check against the reference results.");
+            if (!ParityHarness::Run(sc, *config))
+            {
+                error = "The parity check compared no report.";
+                return false;
+            }
+            return true;
+        }
 
-            int &enableLog = sc.GetPersistentIntFast(PersistentVars::EnableLog);
-            enableLog = config->LogConfig.EnableLog;
+        unsigned int studyID = sc.Input[StudyInputs::TargetStudyRef].GetStudyID();
+        if (studyID == 0)
+        {
+            // Lane charts are checked as they prepare each combination, the dispatcher chart before anything is claimed
+            error = "No target study is selected on this chart.";
+            OnChartLogging::AddLog(sc, error.c_str());
+            return false;
+        }
+        n_ACSIL::s_CustomStudyInformation customStudyInfo;
+        sc.GetCustomStudyInformation(sc.ChartNumber, studyID, customStudyInfo);
+
+        auto *run = new SweepRun();
+        run->DispatcherChartNumber = sc.ChartNumber;
+        run->Config = config;
+        run->Combinations = combinations;
+        run->ResultsDir = resumeDir.empty() ? GetResultsDirectory(sc, configPath, *config, customStudyInfo) : resumeDir;
+        run->LinkedReplay = config->LaneConfig.LinkedReplay;
+        run->EndComboIndex = (int)combinations->size();
+        run->GlobalComboIndices = std::move(globalComboIndices);
+
+        if (!config->DistributedConfig.LeaseDirectory.empty())
+        {
+            std::string workerId = config->DistributedConfig.WorkerId.empty() ? LeaseCoordinator::GetDefaultWorkerId() : config->DistributedConfig.WorkerId;
+            run->Coordinator = new LeaseCoordinator(config->DistributedConfig.LeaseDirectory, workerId, (int)combinations->size(), config->DistributedConfig.ChunkSize, config->DistributedConfig.LeaseTimeoutSeconds, config->DistributedConfig.HeartbeatSeconds);
 
-            int &enableShowLogOnChart = sc.GetPersistentIntFast(PersistentVars::EnableShowLogOnChart);
-            enableShowLogOnChart = config->LogConfig.EnableShowLogOnChart;
+            if (!run->Coordinator->Initialize(run->ResultsDir, error))
+            {
+                msg.Format("Failed to join distributed sweep: %s", error.c_str());
+                OnChartLogging::AddLog(sc, msg);
+                error = msg.GetChars();
+                delete run->Coordinator;
+                delete run;
+                return false;
+            }
 
-            int &maxLogLines = sc.GetPersistentIntFast(PersistentVars::MaxLogLines);
-            maxLogLines = config->LogConfig.MaxLogLines;
+            // Chunks are leased on demand as lanes run out of work
+            run->EndComboIndex = 0;
+            msg.Format("Joined distributed sweep as '%s' (%d chunks). Results folder: %s", workerId.c_str(), run->Coordinator->GetChunkCount(), run->ResultsDir.c_str());
+            OnChartLogging::AddLog(sc, msg);
+        }
 
-            if (combinations->empty() && config->ParamConfigs.empty())
+        if (config->WalkForwardConfig.Enabled)
+        {
+            // In-sample replays are claimed like combinations, out-of-sample replays are queued as windows finish
+            run->WalkForward = new WalkForwardPlan();
+            run->WalkForward->Windows = WalkForward::BuildWindows(config->ReplayConfig, config->WalkForwardConfig, (int)combinations->size());
+            run->WalkForward->ComboCount = (int)combinations->size();
+            run->WalkForward->FilePrefix = customStudyInfo.DLLFileName.GetChars();
+            run->EndComboIndex = WalkForward::GetInSampleItemCount(*run->WalkForward);
+            msg.Format("Walk-forward over %d windows, %d in-sample replays. Results folder: %s", (int)run->WalkForward->Windows.size(), run->EndComboIndex, run->ResultsDir.c_str());
+            OnChartLogging::AddLog(sc, msg);
+        }
+
+        if (config->SurrogateConfig.Enabled)
+        {
+            // Random order until the model has seen the warm-up, then the model's order
+            run->Surrogate = new SurrogateState();
+            run->ComboOrder = SurrogateModel::GetInitialOrder((int)combinations->size(), config->SurrogateConfig.Seed);
+            if (config->SurrogateConfig.Budget > 0 && config->SurrogateConfig.Budget < run->EndComboIndex)
             {
-                OnChartLogging::AddLog(sc, "No varying parameters found.");
-                return;
+                run->SkippedCount = run->EndComboIndex - config->SurrogateConfig.Budget;
+                run->EndComboIndex = config->SurrogateConfig.Budget;
             }
+            msg.Format("Surrogate search: %d of %d combinations will be replayed, in random order until %d have completed.", run->EndComboIndex, (int)combinations->size(), config->SurrogateConfig.WarmUp);
+            OnChartLogging::AddLog(sc, msg);
+        }
 
-            msg.Format("Generated %d combinations.", (int)combinations->size());
+        if (config->PortfolioConfig.Enabled)
+        {
+            run->Portfolio = new PortfolioState();
+            for (const std::string &scidPath : config->PortfolioConfig.ScidPaths)
+            {
+                // Each symbol gets its own engine over its own bars, with the plug-in and fill settings of nativeConfig
+                NativeConfig nativeConfig = config->NativeConfig;
+                nativeConfig.ScidPath = scidPath;
+                auto engine = std::make_unique<NativeEngine>();
+                if (!engine->Open(nativeConfig, error))
+                {
+                    msg.Format("Failed to open portfolio symbol '%s': %s", scidPath.c_str(), error.c_str());
+                    OnChartLogging::AddLog(sc, msg);
+                    error = msg.GetChars();
+                    delete run->Portfolio;
+                    delete run;
+                    return false;
+                }
+                run->Portfolio->Engines.push_back(std::move(engine));
+
+                PortfolioSymbol symbol;
+                symbol.Name = std::filesystem::path(scidPath).stem().string();
+                run->Portfolio->Symbols.push_back(symbol);
+            }
+        }
+
+        std::stringstream summaryFileName;
+        if (config->WalkForwardConfig.Enabled)
+        {
+            summaryFileName << customStudyInfo.DLLFileName << "-walkforward.csv";
+        }
+        else if (config->ShardConfig.ShardCount > 1)
+        {
+            summaryFileName << customStudyInfo.DLLFileName << "-summary.csv";
+            msg.Format("Running shard %d of %d. Results folder: %s", config->ShardConfig.ShardIndex, config->ShardConfig.ShardCount, run->ResultsDir.c_str());
             OnChartLogging::AddLog(sc, msg);
-            isConfigLoaded = true;
         }
         else
         {
-            OnChartLogging::AddLog(sc, "Failed to load config file.");
+            summaryFileName << customStudyInfo.DLLFileName << "-" << (int)combinations->size() - 1 << "-summary.csv";
         }
+        run->SummaryPath = run->ResultsDir + summaryFileName.str();
 
-        if (isConfigLoaded == false)
+        if (!resumeDir.empty() && run->Coordinator == nullptr && run->WalkForward == nullptr && run->Surrogate == nullptr)
         {
-            return;
+            // A job interrupted by a restart only replays the combinations without a completed report
+            for (int i = 0; i < (int)combinations->size(); ++i)
+            {
+                std::string reportPath = run->ResultsDir + customStudyInfo.DLLFileName.GetChars() + "-" + std::to_string(LaneDispatcher::GetGlobalComboIndex(*run, i)) + ".json";
+                if (std::filesystem::exists(reportPath) && ResultAnalyzer::ParseJsonResult(reportPath, sc).status == "completed")
+                    run->SkippedCount++;
+                else
+                    run->ComboOrder.push_back(i);
+            }
+            run->EndComboIndex = (int)run->ComboOrder.size();
+            msg.Format("Resuming in %s, %d of %d combinations already have a report.", run->ResultsDir.c_str(), run->SkippedCount, (int)combinations->size());
+            OnChartLogging::AddLog(sc, msg);
+
+            if (run->ComboOrder.empty())
+            {
+                // Nothing is left to replay, the restart came after the last report but before the summary
+                ResultAnalyzer::AnalyzeResults(sc, run->ResultsDir, run->SummaryPath, *config);
+            }
+        }
+
+        // The dispatcher chart is always the first lane
+        run->Lanes.push_back({sc.ChartNumber});
+        for (int chartNumber : config->LaneConfig.ChartNumbers)
+        {
+            if (LaneDispatcher::FindLane(*run, chartNumber) != nullptr)
+                continue;
+
+            SweepRun *otherRun = LaneDispatcher::FindRunForChart(chartNumber);
+            if (otherRun != nullptr)
+            {
+                msg.Format("Chart %d is already a lane of the run started on chart %d, skipped.", chartNumber, otherRun->DispatcherChartNumber);
+                OnChartLogging::AddLog(sc, msg);
+                continue;
+            }
+            run->Lanes.push_back({chartNumber});
+        }
+
+        if (run->Portfolio != nullptr && !run->Portfolio->IsNative())
+        {
+            // Lane order, named by their chart symbol once they report
+            for (const auto &symbolLane : run->Lanes)
+            {
+                PortfolioSymbol symbol;
+                symbol.Name = "Chart " + std::to_string(symbolLane.ChartNumber);
+                run->Portfolio->Symbols.push_back(symbol);
+            }
+        }
+
+        sc.SetPersistentPointer(PersistentVars::SweepRunPtr, run);
+        LaneDispatcher::RegisterRun(run);
+
+        if (run->Lanes.size() > 1)
+        {
+            msg.Format("Dispatching combinations across %d lane charts.", (int)run->Lanes.size());
+            OnChartLogging::AddLog(sc, msg);
+        }
+
+        LaneState &lane = run->Lanes.front();
+        lane.Attached = true;
+        if (run->Portfolio != nullptr && run->Portfolio->IsNative())
+        {
+            msg.Format("Evaluating %d combinations natively over %d symbols. Results folder: %s", LaneDispatcher::GetWorkItemCount(*run), (int)run->Portfolio->Symbols.size(), run->ResultsDir.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            return true;
+        }
+        if (!LaneDispatcher::ClaimNextCombination(*run, lane))
+        {
+            OnChartLogging::AddLog(sc, "No combinations left to claim, every chunk is leased or done.");
+            return true;
+        }
+        if (run->LinkedReplay)
+        {
+            // The linked replay starts once every attached lane has its inputs set
+            OnChartLogging::AddLog(sc, "Preparing the first batch of combinations for a linked replay.");
+            ReplayManager::PrepareCombination(sc, *config, *run, lane);
+            return true;
         }
 
-        ComboIndex = 0;
         OnChartLogging::AddLog(sc, "Starting backtesting process with the first combination.");
-        ReplayManager::StartReplayForCombination(sc, *config, *combinations, ComboIndex, replayState);
+        ReplayManager::StartReplayForCombination(sc, *config, *run, lane);
+        return true;
+    }
+
+    void HandleStartQueueEvent(SCStudyInterfaceRef sc, SCInputRef Input_JobQueueFilePath)
+    {
+        SCString msg;
+        SweepRun *activeRun = LaneDispatcher::FindRunForChart(sc.ChartNumber);
+        if (activeRun != nullptr && activeRun->DispatcherChartNumber != sc.ChartNumber)
+        {
+            msg.Format("This chart is a lane of the run started on chart %d. Reset that run first.", activeRun->DispatcherChartNumber);
+            OnChartLogging::AddLog(sc, msg);
+            return;
+        }
+        EndSweepRun(sc);
+        EndJobQueue(sc);
+
+        OnChartLogging::AddLog(sc, "'Start Replay' button clicked, running the job queue.");
+        auto *jobQueue = new JobQueue(Input_JobQueueFilePath.GetString());
+        std::string error;
+        if (!jobQueue->Load(error))
+        {
+            msg.Format("Failed to load job queue: %s", error.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            delete jobQueue;
+            return;
+        }
+        sc.SetPersistentPointer(PersistentVars::JobQueuePtr, jobQueue);
+
+        msg.Format("Job queue loaded: %d pending, %d interrupted, %d completed, %d failed. Progress file: %s", jobQueue->CountJobs("pending"), jobQueue->CountJobs("running"), jobQueue->CountJobs("completed"), jobQueue->CountJobs("failed"), jobQueue->GetProgressPath().c_str());
+        OnChartLogging::AddLog(sc, msg);
+        StartNextJob(sc);
+    }
+
+    void StartNextJob(SCStudyInterfaceRef sc)
+    {
+        auto *jobQueue = reinterpret_cast<JobQueue *>(sc.GetPersistentPointer(PersistentVars::JobQueuePtr));
+        auto *config = reinterpret_cast<StrategyOptimizerConfig *>(sc.GetPersistentPointer(PersistentVars::BacktestConfigPtr));
+        auto *combinations = reinterpret_cast<std::vector<std::vector<double>> *>(sc.GetPersistentPointer(PersistentVars::CombinationsPtr));
+        if (jobQueue == nullptr)
+        {
+            return;
+        }
+
+        SCString msg;
+        std::string error;
+        std::string now = sc.FormatDateTime(sc.CurrentSystemDateTime).GetChars();
+
+        // Called once the run of the current job has finished, its summary is written by now
+        auto *run = reinterpret_cast<SweepRun *>(sc.GetPersistentPointer(PersistentVars::SweepRunPtr));
+        std::string finishedJob = jobQueue->GetRunningJob();
+        std::string finishedResultsDir = run != nullptr ? run->ResultsDir : "";
+        EndSweepRun(sc);
+
+        if (!jobQueue->Load(error))
+        {
+            msg.Format("Job queue stopped: %s", error.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            EndJobQueue(sc);
+            return;
+        }
+        if (!finishedJob.empty())
+        {
+            if (!jobQueue->MarkFinished(finishedJob, true, finishedResultsDir, "", now, error))
+                OnChartLogging::AddLog(sc, error.c_str());
+            msg.Format("--- Job '%s' completed. ---", finishedJob.c_str());
+            OnChartLogging::AddLog(sc, msg);
+        }
+
+        // Jobs that cannot start are recorded as failed and skipped until one runs or none is left
+        for (int job = jobQueue->GetNextJob(); job >= 0; job = jobQueue->GetNextJob())
+        {
+            QueuedJob queued = jobQueue->GetJob(job);
+            bool resuming = queued.Status == "running";
+            msg.Format("--- Job '%s'%s, %d more pending. ---", queued.Name.c_str(), resuming ? " resumed" : "", jobQueue->CountJobs("pending") - (resuming ? 0 : 1));
+            OnChartLogging::AddLog(sc, msg);
+
+            SCDateTime &backtestStartDateTime = sc.GetPersistentSCDateTimeFast(PersistentVars::BacktestStartDateTime);
+            backtestStartDateTime = sc.CurrentSystemDateTimeMS;
+
+            // The prefetch is only used while it is still the next job, the queue file may have changed since
+            PrefetchedJob &prefetch = jobQueue->Prefetch;
+            GeneratedCombinations generated;
+            bool loaded = false;
+            if (prefetch.Name == queued.Name && prefetch.Loaded)
+            {
+                OnChartLogging::AddLog(sc, "Using the configuration prefetched during the previous job.");
+                *config = std::move(prefetch.Config);
+                generated = prefetch.Combinations.get();
+                loaded = true;
+            }
+            else if (LoadSweepConfig(sc, queued.ConfigPath, *config))
+            {
+                OnChartLogging::AddLog(sc, "Configuration loaded successfully. Generating parameter combinations...");
+                generated = GenerateCombinations(config->ParamConfigs, config->ShardConfig);
+                loaded = true;
+            }
+            prefetch = PrefetchedJob();
+
+            error = "The configuration could not be loaded.";
+            *combinations = std::move(generated.Combinations);
+            bool started = loaded && StartSweep(sc, queued.ConfigPath, config, combinations, std::move(generated.GlobalComboIndices), resuming ? queued.ResultsDir : "", error);
+
+            run = reinterpret_cast<SweepRun *>(sc.GetPersistentPointer(PersistentVars::SweepRunPtr));
+            std::string progressError;
+            if (started && run != nullptr)
+            {
+                if (!jobQueue->MarkRunning(queued.Name, run->ResultsDir, now, progressError))
+                    OnChartLogging::AddLog(sc, progressError.c_str());
+                return;
+            }
+
+            // Without a run the job is over, a parity check has written its results into the reference folder
+            if (!jobQueue->MarkFinished(queued.Name, started, started ? config->ParityConfig.ReferenceDirectory : "", started ? "" : error, now, progressError))
+                OnChartLogging::AddLog(sc, progressError.c_str());
+            if (started)
+                msg.Format("--- Job '%s' completed. ---", queued.Name.c_str());
+            else
+                msg.Format("--- Job '%s' failed: %s ---", queued.Name.c_str(), error.c_str());
+            OnChartLogging::AddLog(sc, msg);
+        }
+
+        msg.Format("--- Job queue finished: %d completed, %d failed. Progress file: %s ---", jobQueue->CountJobs("completed"), jobQueue->CountJobs("failed"), jobQueue->GetProgressPath().c_str());
+        OnChartLogging::AddLog(sc, msg);
+        EndJobQueue(sc);
+    }
+
+    void PrefetchNextJob(SCStudyInterfaceRef sc)
+    {
+        auto *jobQueue = reinterpret_cast<JobQueue *>(sc.GetPersistentPointer(PersistentVars::JobQueuePtr));
+        if (jobQueue == nullptr || jobQueue->Prefetch.Attempted)
+        {
+            return;
+        }
+
+        PrefetchedJob &prefetch = jobQueue->Prefetch;
+        prefetch.Attempted = true;
+
+        SCString msg;
+        std::string error;
+        if (!jobQueue->Load(error))
+        {
+            msg.Format("Job queue: %s", error.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            return;
+        }
+
+        int job = jobQueue->GetNextJob();
+        if (job < 0)
+        {
+            return;
+        }
+
+        const QueuedJob &next = jobQueue->GetJob(job);
+        prefetch.Name = next.Name;
+        msg.Format("Prefetching job '%s' while the last combinations of this job run.", next.Name.c_str());
+        OnChartLogging::AddLog(sc, msg);
+        prefetch.Loaded = LoadSweepConfig(sc, next.ConfigPath, prefetch.Config);
+        if (!prefetch.Loaded)
+        {
+            msg.Format("Job '%s' will fail, its configuration did not load.", next.Name.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            return;
+        }
+
+        // The main thread keeps driving the replays while the combinations are generated
+        prefetch.Combinations = std::async(std::launch::async, GenerateCombinations, prefetch.Config.ParamConfigs, prefetch.Config.ShardConfig);
+    }
+
+    void EndJobQueue(SCStudyInterfaceRef sc)
+    {
+        auto *jobQueue = reinterpret_cast<JobQueue *>(sc.GetPersistentPointer(PersistentVars::JobQueuePtr));
+        if (jobQueue != nullptr)
+        {
+            // Waits for combinations still being generated for a prefetch. The progress file keeps the job running,
+            // the next Start of the queue resumes it.
+            delete jobQueue;
+            sc.SetPersistentPointer(PersistentVars::JobQueuePtr, nullptr);
+        }
     }
 
     void HandleVerifyConfigEvent(SCStudyInterfaceRef sc, SCInputRef Input_ConfigFilePath, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations)
@@ -97,14 +576,7 @@ namespace StrategyOptimizerHelpers
             OnChartLogging::AddLog(sc, "Configuration loaded successfully. Generating parameter combinations...");
             *combinations = CombinationGenerator::GenerateIterative(config->ParamConfigs);
 
-            int &enableLog = sc.GetPersistentIntFast(PersistentVars::EnableLog);
-            enableLog = config->LogConfig.EnableLog;
-
-            int &enableShowLogOnChart = sc.GetPersistentIntFast(PersistentVars::EnableShowLogOnChart);
-            enableShowLogOnChart = config->LogConfig.EnableShowLogOnChart;
-
-            int &maxLogLines = sc.GetPersistentIntFast(PersistentVars::MaxLogLines);
-            maxLogLines = config->LogConfig.MaxLogLines;
+            ApplyLogConfig(sc, *config);
 
             if (combinations->empty() && !config->ParamConfigs.empty())
             {
@@ -178,10 +650,10 @@ namespace StrategyOptimizerHelpers
         OnChartLogging::AddLog(sc, "--- Verify config finished. ---");
     }
 
-    void HandleResetEvent(SCStudyInterfaceRef sc, ReplayState &replayState, int &ComboIndex, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations, Logging *logging)
+    void HandleResetEvent(SCStudyInterfaceRef sc, StrategyOptimizerConfig *config, std::vector<std::vector<double>> *combinations, Logging *logging)
     {
-        replayState = ReplayState::Idle;
-        ComboIndex = 0;
+        EndSweepRun(sc);
+        EndJobQueue(sc);
 
         if (config != nullptr)
         {
@@ -250,6 +722,75 @@ namespace StrategyOptimizerHelpers
             {"enableLog", true},
             {"enableShowLogOnChart", true},
             {"maxLogLines", 25}};
+        config["watchdogConfig"] = {
+            {"startTimeoutSeconds", 60},
+            {"runTimeoutSeconds", 0},
+            {"maxRetries", 2}};
+        config["laneConfig"] = {
+            {"chartNumbers", nlohmann::ordered_json::array()},
+            {"linkedReplay", false}};
+        config["distributedConfig"] = {
+            {"leaseDirectory", ""},
+            {"workerId", ""},
+            {"chunkSize", 20},
+            {"leaseTimeoutSeconds", 600},
+            {"heartbeatSeconds", 30}};
+        config["shardConfig"] = {
+            {"shardIndex", 0},
+            {"shardCount", 1},
+            {"mode", "strided"},
+            {"runName", ""}};
+        config["analysisConfig"] = {
+            {"objectives", nlohmann::ordered_json::array({{{"metric", "totalProfitLoss"}, {"goal", "max"}},
+                                                          {{"metric", "maxDrawdown"}, {"goal", "min"}},
+                                                          {{"metric", "totalTrades"}, {"goal", "max"}}})},
+            {"paretoFronts", 1},
+            {"robustness", {{"metric", "totalProfitLoss"}, {"goal", "max"}, {"radius", 1}, {"shape", "manhattan"}, {"penalty", 1.0}}},
+            {"monteCarlo", {{"topK", 10}, {"resamples", 5000}, {"method", "bootstrap"}, {"ruinCapital", 10000}, {"seed", 20250101}, {"threads", 0}}},
+            {"statistics", {{"enabled", true}, {"resamples", 1000}, {"meanBlockLength", 5}, {"cscvBlocks", 10}, {"seed", 20250101}, {"threads", 0}}},
+            {"clustering", {{"enabled", true}, {"minCorrelation", 0.9}, {"gridPoints", 256}, {"metric", "totalProfitLoss"}, {"goal", "max"}, {"threads", 0}}},
+            {"heatmaps", {{"enabled", true}, {"metrics", nlohmann::ordered_json::array({"sharpeRatio", "totalProfitLoss"})}}}};
+        config["walkForwardConfig"] = {
+            {"enabled", false},
+            {"inSampleDays", 60},
+            {"outOfSampleDays", 20},
+            {"stepDays", 20},
+            {"objective", {{"metric", "totalProfitLoss"}, {"goal", "max"}}}};
+        config["surrogateConfig"] = {
+            {"enabled", false},
+            {"warmUp", 100},
+            {"refitEvery", 100},
+            {"budget", 0},
+            {"trees", 100},
+            {"maxDepth", 12},
+            {"minLeafSize", 3},
+            {"exploration", 1.0},
+            {"objective", {{"metric", "totalProfitLoss"}, {"goal", "max"}}},
+            {"seed", 20250101},
+            {"threads", 0}};
+        config["nativeConfig"] = {
+            {"pluginPath", ""},
+            {"scidPath", ""},
+            {"barType", "time"},
+            {"barSize", 60},
+            {"tickSize", 0.25},
+            {"pointValue", 1.0},
+            {"slippageTicks", 0},
+            {"commissionPerContract", 0},
+            {"limitQueue", "touch"},
+            {"queueVolume", 0}};
+        config["parityConfig"] = {
+            {"referenceDirectory", ""},
+            {"timeToleranceSeconds", 1.0},
+            {"priceToleranceTicks", 0},
+            {"profitLossTolerance", 0.01},
+            {"metricTolerance", 1e-6},
+            {"maxMismatchesPerCombination", 10}};
+        config["portfolioConfig"] = {
+            {"enabled", false},
+            {"scidPaths", nlohmann::ordered_json::array()},
+            {"threads", 0},
+            {"batchSize", 16}};
 
         nlohmann::ordered_json paramConfigs = nlohmann::ordered_json::array();
         int inputIndex = 0;
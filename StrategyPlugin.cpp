@@ -0,0 +1,163 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "StrategyPlugin.hpp"
+#include <algorithm>
+#include <cstddef>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace
+{
+    const uint32_t OLDEST_ABI_VERSION = 1;
+
+    void *OpenLibrary(const std::string &path, std::string &error)
+    {
+#if defined(_WIN32)
+        HMODULE library = LoadLibraryA(path.c_str());
+        if (library == NULL)
+            error = "Cannot load strategy library '" + path + "' (error " + std::to_string(GetLastError()) + ").";
+        return library;
+#else
+        void *library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (library == nullptr)
+            error = "Cannot load strategy library '" + path + "': " + dlerror();
+        return library;
+#endif
+    }
+
+    void *FindSymbol(void *library, const char *name)
+    {
+#if defined(_WIN32)
+        return reinterpret_cast<void *>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+        return dlsym(library, name);
+#endif
+    }
+
+    void CloseLibrary(void *library)
+    {
+#if defined(_WIN32)
+        FreeLibrary(static_cast<HMODULE>(library));
+#else
+        dlclose(library);
+#endif
+    }
+}
+
+StrategyPlugin::StrategyPlugin()
+    : library(nullptr),
+      api(nullptr)
+{
+}
+
+StrategyPlugin::~StrategyPlugin()
+{
+    Unload();
+}
+
+bool StrategyPlugin::Load(const std::string &path, std::string &error)
+{
+    Unload();
+    library = OpenLibrary(path, error);
+    if (library == nullptr)
+        return false;
+
+    SoGetStrategyApiFunction getApi = reinterpret_cast<SoGetStrategyApiFunction>(FindSymbol(library, SO_STRATEGY_ENTRY_POINT));
+    const SoStrategyApi *loadedApi = getApi != nullptr ? getApi() : nullptr;
+    if (loadedApi == nullptr)
+    {
+        error = "'" + path + "' does not export " SO_STRATEGY_ENTRY_POINT ".";
+        Unload();
+        return false;
+    }
+
+    // A newer library may have a longer table, an older one must still have every field this version calls.
+    // Version 1 libraries only lack the fields added to the end of SoBarContext, which they never read.
+    if (loadedApi->AbiVersion < OLDEST_ABI_VERSION || loadedApi->AbiVersion > SO_STRATEGY_ABI_VERSION || loadedApi->StructSize < sizeof(SoStrategyApi))
+    {
+        error = "'" + path + "' was built for strategy ABI version " + std::to_string(loadedApi->AbiVersion) +
+                ", this optimizer supports versions " + std::to_string(OLDEST_ABI_VERSION) + " to " + std::to_string(SO_STRATEGY_ABI_VERSION) + ".";
+        Unload();
+        return false;
+    }
+    if (loadedApi->Create == nullptr || loadedApi->Destroy == nullptr || loadedApi->OnBar == nullptr)
+    {
+        error = "'" + path + "' leaves Create, Destroy or OnBar unset.";
+        Unload();
+        return false;
+    }
+
+    api = loadedApi;
+    return true;
+}
+
+void StrategyPlugin::Unload()
+{
+    if (library != nullptr)
+        CloseLibrary(library);
+    library = nullptr;
+    api = nullptr;
+}
+
+StrategyInstance::StrategyInstance()
+    : api(nullptr),
+      state(nullptr)
+{
+}
+
+StrategyInstance::~StrategyInstance()
+{
+    Destroy();
+}
+
+bool StrategyInstance::Create(const StrategyPlugin &plugin, const std::vector<InputConfig> &inputs, const std::vector<double> &combination, std::string &error)
+{
+    Destroy();
+    if (!plugin.IsLoaded())
+    {
+        error = "No strategy library is loaded.";
+        return false;
+    }
+    if (combination.size() != inputs.size())
+    {
+        error = "The combination has " + std::to_string(combination.size()) + " values for " + std::to_string(inputs.size()) + " inputs.";
+        return false;
+    }
+
+    std::vector<int32_t> inputIndexes;
+    for (const InputConfig &input : inputs)
+    {
+        inputIndexes.push_back(input.Index);
+    }
+
+    char message[512] = "";
+    state = plugin.GetApi()->Create(inputIndexes.data(), combination.data(), (int32_t)inputs.size(), message, (int32_t)sizeof(message));
+    if (state == nullptr)
+    {
+        message[sizeof(message) - 1] = '\0';
+        error = std::string("The strategy rejected the combination: ") + (message[0] != '\0' ? message : "no reason given.");
+        return false;
+    }
+    api = plugin.GetApi();
+    return true;
+}
+
+void StrategyInstance::Destroy()
+{
+    if (state != nullptr)
+        api->Destroy(state);
+    state = nullptr;
+    api = nullptr;
+}
+
+bool StrategyInstance::OnBar(const SoBarContext &context, std::vector<SoOrderRequest> &orders)
+{
+    orders.resize(MAX_ORDERS_PER_BAR);
+    int32_t count = state != nullptr ? api->OnBar(state, &context, orders.data(), MAX_ORDERS_PER_BAR) : -1;
+    orders.resize(count < 0 ? 0 : (std::min)(count, (int32_t)MAX_ORDERS_PER_BAR));
+    return count >= 0;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include "StrategyPluginAbi.h"
+#include <string>
+#include <vector>
+
+// Strategy library loaded through the plug-in ABI, with LoadLibrary on Windows and dlopen elsewhere
+class StrategyPlugin
+{
+public:
+    StrategyPlugin();
+    ~StrategyPlugin();
+    StrategyPlugin(const StrategyPlugin &) = delete;
+    StrategyPlugin &operator=(const StrategyPlugin &) = delete;
+
+    bool Load(const std::string &path, std::string &error);
+    void Unload();
+
+    bool IsLoaded() const { return api != nullptr; }
+    const SoStrategyApi *GetApi() const { return api; }
+
+private:
+    void *library;
+    const SoStrategyApi *api;
+};
+
+// Strategy state of one combination, driven from one thread. States of the same plugin may run on different threads at once.
+// The plugin must stay loaded while its states exist.
+class StrategyInstance
+{
+public:
+    // Requests a strategy may return from one bar
+    static const int MAX_ORDERS_PER_BAR = 16;
+
+    StrategyInstance();
+    ~StrategyInstance();
+    StrategyInstance(const StrategyInstance &) = delete;
+    StrategyInstance &operator=(const StrategyInstance &) = delete;
+
+    // combination holds one value per entry of inputs, in the order of paramConfigs
+    bool Create(const StrategyPlugin &plugin, const std::vector<InputConfig> &inputs, const std::vector<double> &combination, std::string &error);
+    void Destroy();
+
+    // Replaces orders with the requests of the bar, false when the strategy stopped the evaluation
+    bool OnBar(const SoBarContext &context, std::vector<SoOrderRequest> &orders);
+
+private:
+    const SoStrategyApi *api;
+    void *state;
+};
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+// C interface a strategy exports from a shared library so the optimizer can evaluate it in process, without a chart.
+// The header is plain C and has no other dependency, so it can be copied into the strategy's own project.
+//
+// Fixed-width fields only and no enums in structs, so any compiler lays the structs out the same way.
+// Fields are only ever added at the end of a struct, with SO_STRATEGY_ABI_VERSION raised.
+#ifndef STRATEGY_PLUGIN_ABI_H
+#define STRATEGY_PLUGIN_ABI_H
+
+#include <stdint.h>
+
+#define SO_STRATEGY_ABI_VERSION 2
+
+// Name of the function the library exports, returning its SoStrategyApi
+#define SO_STRATEGY_ENTRY_POINT "SoGetStrategyApi"
+
+#if defined(_WIN32)
+#define SO_STRATEGY_EXPORT __declspec(dllexport)
+#else
+#define SO_STRATEGY_EXPORT __attribute__((visibility("default")))
+#endif
+
+// SoOrderRequest.Action
+#define SO_ACTION_BUY 1
+#define SO_ACTION_SELL 2
+#define SO_ACTION_FLATTEN 3    // Closes the position at market and cancels working orders
+#define SO_ACTION_CANCEL_ALL 4 // Cancels working orders
+
+// SoOrderRequest.OrderType
+#define SO_ORDER_MARKET 0
+#define SO_ORDER_LIMIT 1
+#define SO_ORDER_STOP 2
+
+// Kind of SoBarContext.GetIndicator. Windowed kinds are 0 until the first full window, as in Sierra Chart study arrays.
+#define SO_INDICATOR_SMA 1
+#define SO_INDICATOR_EMA 2             // Seeded with the first value, smoothing 2 / (length + 1)
+#define SO_INDICATOR_WMA 3             // Linearly weighted, the newest value weighs length
+#define SO_INDICATOR_ATR 4             // Wilder's smoothing of the true range, source is ignored
+#define SO_INDICATOR_RSI 5             // Wilder's RSI from 0 to 100
+#define SO_INDICATOR_BOLLINGER_UPPER 6 // SMA plus parameter population standard deviations, SO_INDICATOR_SMA is the middle band
+#define SO_INDICATOR_BOLLINGER_LOWER 7 // SMA minus parameter population standard deviations
+#define SO_INDICATOR_VWAP 8            // Volume weighted typical price over the last length bars, source is ignored
+#define SO_INDICATOR_SESSION_VWAP 9    // Volume weighted typical price since the session's first bar, source and length are ignored
+#define SO_INDICATOR_HIGHEST 10        // Highest value of the last length bars
+#define SO_INDICATOR_LOWEST 11         // Lowest value of the last length bars
+#define SO_INDICATOR_ZSCORE 12         // Distance from the SMA in population standard deviations
+
+// Source of SoBarContext.GetIndicator, the bar column an indicator of one input runs over
+#define SO_SOURCE_CLOSE 0
+#define SO_SOURCE_OPEN 1
+#define SO_SOURCE_HIGH 2
+#define SO_SOURCE_LOW 3
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // Bars up to and including the current one, as columns. BarCount - 1 is the current bar, later bars are not visible.
+    typedef struct SoBarContext
+    {
+        const double *DateTime; // Sierra Chart date time, days since 1899-12-30
+        const float *Open;
+        const float *High;
+        const float *Low;
+        const float *Close;
+        const uint32_t *NumTrades;
+        const uint32_t *Volume;
+        const uint32_t *BidVolume;
+        const uint32_t *AskVolume;
+        uint64_t BarCount;
+
+        int32_t PositionQuantity; // Positive long, negative short
+        int32_t WorkingOrderCount;
+        double AveragePrice;
+        double ClosedProfitLoss; // Of the evaluation so far, in price units times quantity
+
+        // Version 2. Indicators the host computes once over every bar of the series and shares between all states run on
+        // the same bars. Returns one value per bar, or NULL for an unknown kind or a length below 1. Values after
+        // BarCount - 1 belong to later bars and must not be read. The array stays valid until the state is destroyed.
+        void *Host;
+        const float *(*GetIndicator)(void *host, int32_t kind, int32_t source, int32_t length, double parameter);
+    } SoBarContext;
+
+    // Limit and stop orders keep working until filled or cancelled
+    typedef struct SoOrderRequest
+    {
+        int32_t Action;
+        int32_t OrderType;
+        int32_t Quantity;
+        int32_t Reserved; // 0
+        double Price;     // Limit or stop price, ignored for market orders
+    } SoOrderRequest;
+
+    typedef struct SoStrategyApi
+    {
+        uint32_t AbiVersion; // SO_STRATEGY_ABI_VERSION the library was built with
+        uint32_t StructSize; // sizeof(SoStrategyApi) the library was built with
+        const char *Name;
+
+        // New strategy state for one combination. Inputs come as the study input indexes of paramConfigs with their values,
+        // so a ported study reads its inputs by the same index as sc.Input[]. Returns NULL with a message in error on failure.
+        void *(*Create)(const int32_t *inputIndexes, const double *inputValues, int32_t inputCount, char *error, int32_t errorSize);
+        void (*Destroy)(void *state);
+
+        // Called once per closed bar, in order. Writes at most maxOrders requests and returns how many it wrote,
+        // or a negative value to stop the evaluation of this state.
+        int32_t (*OnBar)(void *state, const SoBarContext *context, SoOrderRequest *orders, int32_t maxOrders);
+    } SoStrategyApi;
+
+    // Many states are evaluated concurrently on different threads, so everything a strategy keeps must live in its state.
+    // The returned table must stay valid while the library is loaded.
+    typedef const SoStrategyApi *(*SoGetStrategyApiFunction)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STRATEGY_PLUGIN_ABI_H
@@ -0,0 +1,348 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "SurrogateModel.hpp"
+#include "MonteCarloResampler.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+namespace
+{
+    const int MAX_BINS = 64;
+    const int SCORE_BLOCK = 256;
+    const int INTERLEAVE = 16;
+
+    // Streams of the random draws, so bootstrap rows and feature picks of a tree never share a draw
+    const uint64_t BOOTSTRAP_STREAM = 0;
+    const uint64_t FEATURE_STREAM = 1;
+    const uint64_t ORDER_STREAM = ~0ULL;
+
+    size_t DrawIndex(uint64_t draw, size_t count)
+    {
+        // Top 53 bits as a double in [0, 1)
+        return (std::min)((size_t)((double)(draw >> 11) * (1.0 / 9007199254740992.0) * (double)count), count - 1);
+    }
+
+    // Upper value of each bin. Features with few distinct values get one bin per value, others quantile bins.
+    std::vector<double> GetBinEdges(const std::vector<double> &x, int features, int feature)
+    {
+        std::vector<double> values;
+        for (size_t i = feature; i < x.size(); i += features)
+        {
+            values.push_back(x[i]);
+        }
+        std::sort(values.begin(), values.end());
+
+        std::vector<double> edges = values;
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        if ((int)edges.size() > MAX_BINS)
+        {
+            edges.clear();
+            for (int b = 1; b <= MAX_BINS; ++b)
+            {
+                edges.push_back(values[(size_t)b * (values.size() - 1) / MAX_BINS]);
+            }
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        }
+        return edges;
+    }
+
+    // Split in the layout the scoring walks. A leaf points to itself behind an infinite threshold,
+    // so every candidate takes the same number of steps and the descent has no branches.
+    struct FlatNode
+    {
+        double Threshold;
+        int Feature;
+        int Left; // The right child follows the left one
+    };
+
+    struct FlatTree
+    {
+        std::vector<FlatNode> Nodes;
+        std::vector<double> Values;
+        int Depth = 0;
+    };
+
+    FlatTree Flatten(const RegressionTree &tree)
+    {
+        FlatTree flatTree;
+        std::vector<int> depths(tree.Nodes.size(), 0);
+        for (size_t i = 0; i < tree.Nodes.size(); ++i)
+        {
+            const RegressionTreeNode &node = tree.Nodes[i];
+            if (node.Feature < 0)
+            {
+                flatTree.Nodes.push_back({HUGE_VAL, 0, (int)i});
+            }
+            else
+            {
+                flatTree.Nodes.push_back({node.Threshold, node.Feature, node.Left});
+                depths[node.Left] = depths[node.Right] = depths[i] + 1;
+            }
+            flatTree.Values.push_back(node.Value);
+            flatTree.Depth = (std::max)(flatTree.Depth, depths[i]);
+        }
+        return flatTree;
+    }
+
+    struct PendingNode
+    {
+        int Node;
+        int Begin;
+        int End;
+        int Depth;
+    };
+
+    RegressionTree GrowTree(const std::vector<unsigned char> &bins, int features, const std::vector<std::vector<double>> &edges,
+                            const std::vector<double> &y, const SurrogateConfig &config, int tree)
+    {
+        RegressionTree regressionTree;
+        int rows = (int)y.size();
+        int featuresPerSplit = (std::max)(1, (features + 2) / 3);
+
+        // Bootstrap sample of the training rows
+        std::vector<int> sample(rows);
+        for (int i = 0; i < rows; ++i)
+        {
+            sample[i] = (int)DrawIndex(MonteCarloResampler::Draw(config.Seed, tree, BOOTSTRAP_STREAM, i), rows);
+        }
+
+        std::vector<int> featureOrder(features);
+        std::vector<double> binSums(MAX_BINS);
+        std::vector<int> binCounts(MAX_BINS);
+        std::vector<PendingNode> pending;
+        regressionTree.Nodes.push_back(RegressionTreeNode());
+        pending.push_back({0, 0, rows, 0});
+        while (!pending.empty())
+        {
+            PendingNode current = pending.back();
+            pending.pop_back();
+
+            int count = current.End - current.Begin;
+            double sum = 0.0;
+            for (int i = current.Begin; i < current.End; ++i)
+            {
+                sum += y[sample[i]];
+            }
+            regressionTree.Nodes[current.Node].Value = sum / count;
+            if (current.Depth >= config.MaxDepth || count < 2 * config.MinLeafSize)
+                continue;
+
+            // A fresh random subset of the features for every split
+            std::iota(featureOrder.begin(), featureOrder.end(), 0);
+            for (int k = 0; k < featuresPerSplit; ++k)
+            {
+                size_t pick = k + DrawIndex(MonteCarloResampler::Draw(config.Seed, tree, FEATURE_STREAM + current.Node, k), features - k);
+                std::swap(featureOrder[k], featureOrder[pick]);
+            }
+
+            // Largest drop of the squared error, which is the largest sum^2/count over both sides
+            double parentScore = sum * sum / count;
+            double bestGain = 1e-12 * (std::max)(1.0, std::fabs(parentScore));
+            int bestFeature = -1;
+            int bestBin = -1;
+            for (int k = 0; k < featuresPerSplit; ++k)
+            {
+                int feature = featureOrder[k];
+                int binCount = (int)edges[feature].size();
+                if (binCount < 2)
+                    continue;
+
+                std::fill(binSums.begin(), binSums.begin() + binCount, 0.0);
+                std::fill(binCounts.begin(), binCounts.begin() + binCount, 0);
+                for (int i = current.Begin; i < current.End; ++i)
+                {
+                    int bin = bins[(size_t)sample[i] * features + feature];
+                    binSums[bin] += y[sample[i]];
+                    binCounts[bin]++;
+                }
+
+                double leftSum = 0.0;
+                int leftCount = 0;
+                for (int b = 0; b < binCount - 1; ++b)
+                {
+                    leftSum += binSums[b];
+                    leftCount += binCounts[b];
+                    int rightCount = count - leftCount;
+                    if (leftCount < config.MinLeafSize)
+                        continue;
+                    if (rightCount < config.MinLeafSize)
+                        break;
+
+                    double rightSum = sum - leftSum;
+                    double gain = leftSum * leftSum / leftCount + rightSum * rightSum / rightCount - parentScore;
+                    if (gain > bestGain)
+                    {
+                        bestGain = gain;
+                        bestFeature = feature;
+                        bestBin = b;
+                    }
+                }
+            }
+            if (bestFeature < 0)
+                continue;
+
+            int middle = (int)(std::partition(sample.begin() + current.Begin, sample.begin() + current.End, [&](int row)
+                                              { return bins[(size_t)row * features + bestFeature] <= bestBin; }) -
+                               sample.begin());
+
+            // Halfway between the bins, so grid points that never ran fall on the nearer side
+            int left = (int)regressionTree.Nodes.size();
+            RegressionTreeNode &node = regressionTree.Nodes[current.Node];
+            node.Feature = bestFeature;
+            node.Threshold = 0.5 * (edges[bestFeature][bestBin] + edges[bestFeature][bestBin + 1]);
+            node.Left = left;
+            node.Right = left + 1;
+            regressionTree.Nodes.push_back(RegressionTreeNode());
+            regressionTree.Nodes.push_back(RegressionTreeNode());
+            pending.push_back({left, current.Begin, middle, current.Depth + 1});
+            pending.push_back({left + 1, middle, current.End, current.Depth + 1});
+        }
+        return regressionTree;
+    }
+}
+
+namespace SurrogateModel
+{
+    std::vector<RegressionTree> Fit(const std::vector<double> &x, int features, const std::vector<double> &y, const SurrogateConfig &config)
+    {
+        std::vector<std::vector<double>> edges(features);
+        for (int f = 0; f < features; ++f)
+        {
+            edges[f] = GetBinEdges(x, features, f);
+        }
+
+        // Bin of every training value, the first bin whose upper value is not below it
+        std::vector<unsigned char> bins(x.size());
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            const std::vector<double> &featureEdges = edges[i % features];
+            size_t bin = std::lower_bound(featureEdges.begin(), featureEdges.end(), x[i]) - featureEdges.begin();
+            bins[i] = (unsigned char)(std::min)(bin, featureEdges.size() - 1);
+        }
+
+        std::vector<RegressionTree> forest(config.Trees);
+        Parallel::ForEach(Parallel::GetThreadCount(config.Threads), config.Trees, [&](int thread, int tree)
+                          { forest[tree] = GrowTree(bins, features, edges, y, config, tree); });
+        return forest;
+    }
+
+    std::vector<double> Score(const std::vector<RegressionTree> &forest, const std::vector<std::vector<double>> &combinations, const std::vector<int> &candidates, const SurrogateConfig &config)
+    {
+        std::vector<double> scores(candidates.size());
+        if (forest.empty() || candidates.empty())
+        {
+            return scores;
+        }
+
+        std::vector<FlatTree> flatForest;
+        for (const auto &tree : forest)
+        {
+            flatForest.push_back(Flatten(tree));
+        }
+
+        int features = (int)combinations[candidates.front()].size();
+        double sign = config.Objective.Maximize ? 1.0 : -1.0;
+        int blocks = (int)((candidates.size() + SCORE_BLOCK - 1) / SCORE_BLOCK);
+        int threadCount = Parallel::GetThreadCount(config.Threads);
+        std::vector<std::vector<double>> threadPoints(threadCount, std::vector<double>((size_t)SCORE_BLOCK * features, 0.0));
+        std::vector<std::vector<double>> threadMeans(threadCount, std::vector<double>(SCORE_BLOCK));
+        std::vector<std::vector<double>> threadSquares(threadCount, std::vector<double>(SCORE_BLOCK));
+        Parallel::ForEach(threadCount, blocks, [&](int thread, int block)
+                          {
+                              size_t first = (size_t)block * SCORE_BLOCK;
+                              int count = (int)((std::min)(candidates.size(), first + SCORE_BLOCK) - first);
+                              double *points = threadPoints[thread].data();
+                              double *means = threadMeans[thread].data();
+                              double *squares = threadSquares[thread].data();
+                              for (int c = 0; c < count; ++c)
+                              {
+                                  std::copy(combinations[candidates[first + c]].begin(), combinations[candidates[first + c]].end(), points + (size_t)c * features);
+                                  means[c] = 0.0;
+                                  squares[c] = 0.0;
+                              }
+
+                              // Tree by tree over the block, so a tree stays in cache. Several candidates descend together,
+                              // which hides the latency of each node load behind the others.
+                              for (size_t t = 0; t < flatForest.size(); ++t)
+                              {
+                                  const FlatTree &tree = flatForest[t];
+                                  const FlatNode *nodes = tree.Nodes.data();
+                                  for (int c0 = 0; c0 < count; c0 += INTERLEAVE)
+                                  {
+                                      int n[INTERLEAVE] = {};
+                                      for (int depth = 0; depth < tree.Depth; ++depth)
+                                      {
+                                          for (int j = 0; j < INTERLEAVE; ++j)
+                                          {
+                                              const FlatNode &node = nodes[n[j]];
+                                              n[j] = node.Left + (points[(size_t)(c0 + j) * features + node.Feature] > node.Threshold ? 1 : 0);
+                                          }
+                                      }
+
+                                      // Mean and variance over the trees in one pass
+                                      int lanes = (std::min)(INTERLEAVE, count - c0);
+                                      for (int j = 0; j < lanes; ++j)
+                                      {
+                                          double value = tree.Values[n[j]];
+                                          double delta = value - means[c0 + j];
+                                          means[c0 + j] += delta / (double)(t + 1);
+                                          squares[c0 + j] += delta * (value - means[c0 + j]);
+                                      }
+                                  }
+                              }
+
+                              for (int c = 0; c < count; ++c)
+                              {
+                                  scores[first + c] = sign * means[c] + config.Exploration * std::sqrt(squares[c] / (double)flatForest.size());
+                              } });
+        return scores;
+    }
+
+    std::vector<int> Rank(const std::vector<std::vector<double>> &combinations, const std::vector<int> &trainingCombos, const std::vector<double> &trainingValues,
+                          const std::vector<int> &candidates, const SurrogateConfig &config)
+    {
+        int features = combinations.empty() ? 0 : (int)combinations.front().size();
+        if (features == 0 || trainingCombos.empty())
+        {
+            return candidates;
+        }
+
+        std::vector<double> x;
+        x.reserve(trainingCombos.size() * features);
+        for (int combo : trainingCombos)
+        {
+            x.insert(x.end(), combinations[combo].begin(), combinations[combo].end());
+        }
+
+        std::vector<RegressionTree> forest = Fit(x, features, trainingValues, config);
+        std::vector<double> scores = Score(forest, combinations, candidates, config);
+
+        std::vector<int> order(candidates.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                         { return scores[a] > scores[b]; });
+
+        std::vector<int> ranked(candidates.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            ranked[i] = candidates[order[i]];
+        }
+        return ranked;
+    }
+
+    std::vector<int> GetInitialOrder(int count, unsigned long long seed)
+    {
+        // Fisher-Yates from the back, on a stream no tree uses
+        std::vector<int> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        for (int i = count - 1; i > 0; --i)
+        {
+            std::swap(order[i], order[DrawIndex(MonteCarloResampler::Draw(seed, ORDER_STREAM, 0, i), (size_t)i + 1)]);
+        }
+        return order;
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include <future>
+#include <vector>
+
+struct RegressionTreeNode
+{
+    int Feature = -1;       // -1 for a leaf
+    double Threshold = 0.0; // Values at or below the threshold go left
+    int Left = -1;
+    int Right = -1;
+    double Value = 0.0; // Mean objective of the training rows that reached the node
+};
+
+struct RegressionTree
+{
+    std::vector<RegressionTreeNode> Nodes; // Root first
+};
+
+// Objectives collected while the sweep runs, and the ranking of the remaining queue being computed on a worker thread
+struct SurrogateState
+{
+    std::vector<int> TrainingCombos;
+    std::vector<double> TrainingValues;
+    int FittedCount = 0; // Training rows of the last fit
+    int FitCount = 0;
+    int RankedFrom = 0; // Queue position the pending ranking was started from
+    std::future<std::vector<int>> Ranking;
+};
+
+// Random forest regression of the objective over the parameter vectors. Splits are searched on per-feature
+// histograms of at most 64 bins, trees are grown in parallel and every random draw is keyed by (seed, tree, node, draw),
+// so the forest does not depend on the thread count.
+namespace SurrogateModel
+{
+    // x is row-major, one row of features per entry of y
+    std::vector<RegressionTree> Fit(const std::vector<double> &x, int features, const std::vector<double> &y, const SurrogateConfig &config);
+
+    // Forest mean, signed so larger is better, plus exploration times the spread of the trees. One score per candidate.
+    std::vector<double> Score(const std::vector<RegressionTree> &forest, const std::vector<std::vector<double>> &combinations, const std::vector<int> &candidates, const SurrogateConfig &config);
+
+    // Fits on the completed combinations and returns the candidates best first, ties in their current order
+    std::vector<int> Rank(const std::vector<std::vector<double>> &combinations, const std::vector<int> &trainingCombos, const std::vector<double> &trainingValues,
+                          const std::vector<int> &candidates, const SurrogateConfig &config);
+
+    // Seeded shuffle of the grid, so the warm-up replays cover the whole parameter space
+    std::vector<int> GetInitialOrder(int count, unsigned long long seed);
+}
@@ -0,0 +1,335 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "SweepStatistics.hpp"
+#include "MonteCarloResampler.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // A tile of 32 combination rows of a few thousand days stays in L2 while 16 resamples sweep over it
+    const int COMBINATION_TILE = 32;
+    const int RESAMPLE_TILE = 16;
+    const double EULER_GAMMA = 0.5772156649015329;
+    const double E = 2.718281828459045;
+
+    double NormalCdf(double x)
+    {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    // Acklam's rational approximation, relative error below 1.2e-9
+    double NormalQuantile(double p)
+    {
+        const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+        const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+        const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+        const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+        const double low = 0.02425;
+
+        if (p < low)
+        {
+            double q = std::sqrt(-2.0 * std::log(p));
+            return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+        if (p > 1.0 - low)
+        {
+            double q = std::sqrt(-2.0 * std::log(1.0 - p));
+            return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+        double q = p - 0.5;
+        double r = q * q;
+        return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    double GetSharpe(double sum, double sumSquares, double count)
+    {
+        double mean = sum / count;
+        double variance = sumSquares / count - mean * mean;
+        return variance > 0.0 ? mean / std::sqrt(variance) : 0.0;
+    }
+
+    // Day indices of one stationary bootstrap resample: blocks start at random days and have geometric lengths
+    void GenerateStationaryIndices(const SweepStatisticsConfig &config, int resample, int periods, int *indices)
+    {
+        const double restartProbability = 1.0 / config.MeanBlockLength;
+        const double scale = 1.0 / 9007199254740992.0;
+        int day = 0;
+        for (int t = 0; t < periods; ++t)
+        {
+            double u = (double)(MonteCarloResampler::Draw(config.Seed, 0, resample, 2 * (uint64_t)t) >> 11) * scale;
+            if (t == 0 || u < restartProbability)
+            {
+                day = (int)((double)(MonteCarloResampler::Draw(config.Seed, 0, resample, 2 * (uint64_t)t + 1) >> 11) * scale * periods);
+                day = (std::min)(day, periods - 1);
+            }
+            else
+            {
+                day = day + 1 == periods ? 0 : day + 1;
+            }
+            indices[t] = day;
+        }
+    }
+
+    // Mean of every combination row under every resample, visited as visit(thread, resample, combination, mean).
+    // Resamples are processed in tiles so that each tile of rows is read once per tile of resamples.
+    template <typename Visit>
+    void ForEachBootstrapMean(const std::vector<float> &matrix, int rows, int periods, const SweepStatisticsConfig &config, int threadCount, Visit visit)
+    {
+        std::vector<int> indices((size_t)RESAMPLE_TILE * periods);
+        int rowTiles = (rows + COMBINATION_TILE - 1) / COMBINATION_TILE;
+        for (int firstResample = 0; firstResample < config.Resamples; firstResample += RESAMPLE_TILE)
+        {
+            int resampleCount = (std::min)(RESAMPLE_TILE, config.Resamples - firstResample);
+            for (int b = 0; b < resampleCount; ++b)
+            {
+                GenerateStationaryIndices(config, firstResample + b, periods, &indices[(size_t)b * periods]);
+            }
+
+            Parallel::ForEach(threadCount, rowTiles, [&](int thread, int tile)
+                        {
+                            int firstRow = tile * COMBINATION_TILE;
+                            int lastRow = (std::min)(rows, firstRow + COMBINATION_TILE);
+                            for (int b = 0; b < resampleCount; ++b)
+                            {
+                                const int *resampleIndices = &indices[(size_t)b * periods];
+                                for (int n = firstRow; n < lastRow; ++n)
+                                {
+                                    const float *row = &matrix[(size_t)n * periods];
+                                    double sum = 0.0;
+                                    for (int t = 0; t < periods; ++t)
+                                        sum += row[resampleIndices[t]];
+                                    visit(thread, firstResample + b, n, sum / periods);
+                                }
+                            } });
+        }
+    }
+}
+
+namespace SweepStatistics
+{
+    SweepStatisticsResult Compute(const std::vector<std::vector<std::pair<int, double>>> &dailyProfitLoss, const SweepStatisticsConfig &config)
+    {
+        SweepStatisticsResult result;
+        int rows = (int)dailyProfitLoss.size();
+
+        std::vector<int> days;
+        for (const auto &series : dailyProfitLoss)
+        {
+            for (const auto &day : series)
+                days.push_back(day.first);
+        }
+        std::sort(days.begin(), days.end());
+        days.erase(std::unique(days.begin(), days.end()), days.end());
+        int periods = (int)days.size();
+
+        result.Combinations = rows;
+        result.Periods = periods;
+        if (rows < 2 || periods < 3)
+        {
+            return result;
+        }
+
+        // Row per combination, float halves the footprint of the matrix the bootstrap streams through
+        std::vector<float> matrix((size_t)rows * periods, 0.0f);
+        for (int n = 0; n < rows; ++n)
+        {
+            for (const auto &day : dailyProfitLoss[n])
+            {
+                int column = (int)(std::lower_bound(days.begin(), days.end(), day.first) - days.begin());
+                matrix[(size_t)n * periods + column] += (float)day.second;
+            }
+        }
+
+        int threadCount = Parallel::GetThreadCount(config.Threads);
+        double t = (double)periods;
+
+        // Moments of every row
+        std::vector<double> means(rows), sharpes(rows), skews(rows), kurtoses(rows);
+        for (int n = 0; n < rows; ++n)
+        {
+            const float *row = &matrix[(size_t)n * periods];
+            double sum = 0.0;
+            for (int i = 0; i < periods; ++i)
+                sum += row[i];
+            double mean = sum / t;
+
+            double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+            for (int i = 0; i < periods; ++i)
+            {
+                double d = row[i] - mean;
+                double d2 = d * d;
+                m2 += d2;
+                m3 += d2 * d;
+                m4 += d2 * d2;
+            }
+            m2 /= t;
+            m3 /= t;
+            m4 /= t;
+
+            means[n] = mean;
+            sharpes[n] = m2 > 0.0 ? mean / std::sqrt(m2) : 0.0;
+            skews[n] = m2 > 0.0 ? m3 / std::pow(m2, 1.5) : 0.0;
+            kurtoses[n] = m2 > 0.0 ? m4 / (m2 * m2) : 3.0;
+        }
+
+        // Deflated Sharpe ratio of the best combination against the expected maximum of as many unskilled trials
+        int best = (int)(std::max_element(sharpes.begin(), sharpes.end()) - sharpes.begin());
+        double sharpeMean = 0.0;
+        for (double sharpe : sharpes)
+            sharpeMean += sharpe;
+        sharpeMean /= rows;
+        double sharpeVariance = 0.0;
+        for (double sharpe : sharpes)
+            sharpeVariance += (sharpe - sharpeMean) * (sharpe - sharpeMean);
+        sharpeVariance /= rows - 1;
+
+        double expectedMaxSharpe = std::sqrt(sharpeVariance) * ((1.0 - EULER_GAMMA) * NormalQuantile(1.0 - 1.0 / rows) + EULER_GAMMA * NormalQuantile(1.0 - 1.0 / (rows * E)));
+        double bestSharpe = sharpes[best];
+        double denominator = 1.0 - skews[best] * bestSharpe + (kurtoses[best] - 1.0) / 4.0 * bestSharpe * bestSharpe;
+
+        result.BestIndex = best;
+        result.BestSharpe = bestSharpe;
+        result.ExpectedMaxSharpe = expectedMaxSharpe;
+        result.DeflatedSharpe = denominator > 0.0 ? NormalCdf((bestSharpe - expectedMaxSharpe) * std::sqrt(t - 1.0) / std::sqrt(denominator)) : 0.0;
+
+        // Bootstrap pass 1: standard error of each mean, needed to studentize the SPA statistic
+        std::vector<double> bootstrapMean(rows, 0.0), bootstrapM2(rows, 0.0);
+        ForEachBootstrapMean(matrix, rows, periods, config, threadCount, [&](int, int resample, int n, double mean)
+                             {
+                                 // Welford, each row is always visited by the same thread in resample order
+                                 double delta = mean - bootstrapMean[n];
+                                 bootstrapMean[n] += delta / (resample + 1);
+                                 bootstrapM2[n] += delta * (mean - bootstrapMean[n]); });
+
+        std::vector<double> omegas(rows), recentered(rows);
+        double threshold = -std::sqrt(2.0 * std::log(std::log(t)));
+        double realityCheck = -HUGE_VAL;
+        double spa = 0.0;
+        for (int n = 0; n < rows; ++n)
+        {
+            omegas[n] = std::sqrt(t * bootstrapM2[n] / config.Resamples);
+            realityCheck = (std::max)(realityCheck, std::sqrt(t) * means[n]);
+            if (omegas[n] > 0.0)
+            {
+                double studentized = std::sqrt(t) * means[n] / omegas[n];
+                spa = (std::max)(spa, studentized);
+                // Hansen's consistent recentering drops clearly poor combinations from the null
+                recentered[n] = studentized >= threshold ? means[n] : 0.0;
+            }
+        }
+
+        // Bootstrap pass 2: the same resamples again, now taking the maximum statistic per resample
+        std::vector<double> realityCheckStars((size_t)threadCount * config.Resamples, -HUGE_VAL);
+        std::vector<double> spaStars((size_t)threadCount * config.Resamples, 0.0);
+        ForEachBootstrapMean(matrix, rows, periods, config, threadCount, [&](int thread, int resample, int n, double mean)
+                             {
+                                 size_t slot = (size_t)thread * config.Resamples + resample;
+                                 realityCheckStars[slot] = (std::max)(realityCheckStars[slot], std::sqrt(t) * (mean - means[n]));
+                                 if (omegas[n] > 0.0)
+                                     spaStars[slot] = (std::max)(spaStars[slot], std::sqrt(t) * (mean - recentered[n]) / omegas[n]); });
+
+        int realityCheckExceedances = 0;
+        int spaExceedances = 0;
+        for (int b = 0; b < config.Resamples; ++b)
+        {
+            double realityCheckStar = -HUGE_VAL;
+            double spaStar = 0.0;
+            for (int thread = 0; thread < threadCount; ++thread)
+            {
+                realityCheckStar = (std::max)(realityCheckStar, realityCheckStars[(size_t)thread * config.Resamples + b]);
+                spaStar = (std::max)(spaStar, spaStars[(size_t)thread * config.Resamples + b]);
+            }
+            realityCheckExceedances += realityCheckStar >= realityCheck ? 1 : 0;
+            spaExceedances += spaStar >= spa ? 1 : 0;
+        }
+        result.RealityCheckPValue = (double)realityCheckExceedances / config.Resamples;
+        result.SpaPValue = (double)spaExceedances / config.Resamples;
+
+        // CSCV: every half of the blocks is an in-sample set once, the rest is its out-of-sample set
+        int blocks = (std::min)(config.CscvBlocks, periods - periods % 2);
+        std::vector<double> blockSums((size_t)rows * blocks, 0.0), blockSquares((size_t)rows * blocks, 0.0);
+        std::vector<double> blockCounts(blocks, 0.0);
+        for (int k = 0; k < blocks; ++k)
+        {
+            int first = (int)((long long)k * periods / blocks);
+            int last = (int)((long long)(k + 1) * periods / blocks);
+            blockCounts[k] = last - first;
+            for (int n = 0; n < rows; ++n)
+            {
+                const float *row = &matrix[(size_t)n * periods];
+                double sum = 0.0, squares = 0.0;
+                for (int i = first; i < last; ++i)
+                {
+                    sum += row[i];
+                    squares += (double)row[i] * row[i];
+                }
+                blockSums[(size_t)n * blocks + k] = sum;
+                blockSquares[(size_t)n * blocks + k] = squares;
+            }
+        }
+
+        std::vector<unsigned int> splits;
+        for (unsigned int mask = 0; mask < (1u << blocks); ++mask)
+        {
+            int bits = 0;
+            for (int k = 0; k < blocks; ++k)
+                bits += (mask >> k) & 1u;
+            if (bits == blocks / 2)
+                splits.push_back(mask);
+        }
+
+        std::vector<int> overfitCounts(threadCount, 0);
+        Parallel::ForEach(threadCount, (int)splits.size(), [&](int thread, int split)
+                    {
+                        unsigned int mask = splits[split];
+                        auto getSharpe = [&](int n, bool inSample)
+                        {
+                            double sum = 0.0, squares = 0.0, count = 0.0;
+                            for (int k = 0; k < blocks; ++k)
+                            {
+                                if ((((mask >> k) & 1u) != 0) == inSample)
+                                {
+                                    sum += blockSums[(size_t)n * blocks + k];
+                                    squares += blockSquares[(size_t)n * blocks + k];
+                                    count += blockCounts[k];
+                                }
+                            }
+                            return GetSharpe(sum, squares, count);
+                        };
+
+                        int inSampleBest = 0;
+                        double inSampleBestSharpe = -HUGE_VAL;
+                        for (int n = 0; n < rows; ++n)
+                        {
+                            double sharpe = getSharpe(n, true);
+                            if (sharpe > inSampleBestSharpe)
+                            {
+                                inSampleBestSharpe = sharpe;
+                                inSampleBest = n;
+                            }
+                        }
+
+                        double outOfSampleBest = getSharpe(inSampleBest, false);
+                        int rank = 1;
+                        for (int n = 0; n < rows; ++n)
+                        {
+                            if (n != inSampleBest && getSharpe(n, false) < outOfSampleBest)
+                                rank++;
+                        }
+
+                        // The in-sample winner is overfit when it lands in the lower half out of sample
+                        double relativeRank = (double)rank / (rows + 1);
+                        if (std::log(relativeRank / (1.0 - relativeRank)) <= 0.0)
+                            overfitCounts[thread]++; });
+
+        int overfit = 0;
+        for (int count : overfitCounts)
+            overfit += count;
+        result.CscvSplits = (int)splits.size();
+        result.Pbo = splits.empty() ? 0.0 : (double)overfit / splits.size();
+        return result;
+    }
+}
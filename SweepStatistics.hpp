@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "ConfigManager.hpp"
+#include <vector>
+#include <utility>
+
+struct SweepStatisticsResult
+{
+    int Combinations = 0;
+    int Periods = 0;
+    int BestIndex = -1;
+    double BestSharpe = 0.0;
+    double ExpectedMaxSharpe = 0.0;
+    double DeflatedSharpe = 0.0;
+    double RealityCheckPValue = 1.0;
+    double SpaPValue = 1.0;
+    double Pbo = 0.0;
+    int CscvSplits = 0;
+};
+
+// Selection bias statistics over the daily P/L of every combination in a sweep, aligned on a common calendar
+// where a day without trades counts as zero. Sharpe ratios are per day, the benchmark is not trading.
+// - Deflated Sharpe ratio of the best combination (Bailey and Lopez de Prado)
+// - White's Reality Check and Hansen's SPA p-values from a stationary bootstrap (Politis and Romano)
+// - Probability of backtest overfitting from combinatorially symmetric cross-validation
+namespace SweepStatistics
+{
+    // One entry per combination with its (day, P/L) pairs
+    SweepStatisticsResult Compute(const std::vector<std::vector<std::pair<int, double>>> &dailyProfitLoss, const SweepStatisticsConfig &config);
+}
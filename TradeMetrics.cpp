@@ -0,0 +1,268 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "TradeMetrics.hpp"
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace
+{
+    const long long MILLISECONDS_PER_DAY = 86400000LL;
+
+    struct TimeBucket
+    {
+        int Trades = 0;
+        int Profitable = 0;
+        int Losing = 0;
+        double ProfitLoss = 0.0;
+    };
+
+    void AddToBucket(TimeBucket &bucket, double profitLoss)
+    {
+        bucket.Trades++;
+        bucket.Profitable += profitLoss > 0.0 ? 1 : 0;
+        bucket.Losing += profitLoss < 0.0 ? 1 : 0;
+        bucket.ProfitLoss += profitLoss;
+    }
+
+    void AddClosedTrade(TradeSeries &series, const s_ACSTrade &trade)
+    {
+        if (!trade.IsTradeClosed)
+            return;
+
+        double openDateTime = trade.OpenDateTime.GetAsDouble();
+        double closeDateTime = trade.CloseDateTime.GetAsDouble();
+        series.ProfitLoss.push_back(trade.TradeProfitLoss);
+        series.DurationSeconds.push_back((closeDateTime - openDateTime) * SECONDS_PER_DAY);
+        series.OpenDateTime.push_back(openDateTime);
+        series.CloseDateTime.push_back(closeDateTime);
+        series.TradeType.push_back(trade.TradeType);
+    }
+
+    template <typename Key>
+    json BucketsToJson(const std::map<Key, TimeBucket> &buckets)
+    {
+        json keys = json::array();
+        json trades = json::array();
+        json profitable = json::array();
+        json losing = json::array();
+        json profitLoss = json::array();
+        for (const auto &bucket : buckets)
+        {
+            keys.push_back(bucket.first);
+            trades.push_back(bucket.second.Trades);
+            profitable.push_back(bucket.second.Profitable);
+            losing.push_back(bucket.second.Losing);
+            profitLoss.push_back(bucket.second.ProfitLoss);
+        }
+        return {
+            {"Bucket", keys},
+            {"Trades", trades},
+            {"Profitable", profitable},
+            {"Losing", losing},
+            {"ProfitLoss", profitLoss}};
+    }
+}
+
+TradeSeries TradeMetricsCalculator::GetTradeSeries(SCStudyInterfaceRef sc)
+{
+    TradeSeries series;
+    int tradeListSize = sc.GetTradeListSize();
+    series.ProfitLoss.reserve(tradeListSize);
+    series.DurationSeconds.reserve(tradeListSize);
+    series.OpenDateTime.reserve(tradeListSize);
+    series.CloseDateTime.reserve(tradeListSize);
+    series.TradeType.reserve(tradeListSize);
+
+    for (int i = 0; i < tradeListSize; ++i)
+    {
+        s_ACSTrade trade;
+        sc.GetTradeListEntry(i, trade);
+        AddClosedTrade(series, trade);
+    }
+    return series;
+}
+
+TradeSeries TradeMetricsCalculator::GetTradeSeries(const std::vector<s_ACSTrade> &trades)
+{
+    TradeSeries series;
+    for (const s_ACSTrade &trade : trades)
+    {
+        AddClosedTrade(series, trade);
+    }
+    return series;
+}
+
+TradeSeries TradeMetricsCalculator::FilterByTradeType(const TradeSeries &series, int tradeType)
+{
+    TradeSeries filtered;
+    for (size_t i = 0; i < series.Size(); ++i)
+    {
+        if (series.TradeType[i] == tradeType)
+        {
+            filtered.ProfitLoss.push_back(series.ProfitLoss[i]);
+            filtered.DurationSeconds.push_back(series.DurationSeconds[i]);
+            filtered.OpenDateTime.push_back(series.OpenDateTime[i]);
+            filtered.CloseDateTime.push_back(series.CloseDateTime[i]);
+            filtered.TradeType.push_back(series.TradeType[i]);
+        }
+    }
+    return filtered;
+}
+
+TradeMetrics TradeMetricsCalculator::Calculate(const double *profitLoss, const double *durationSeconds, size_t count)
+{
+    TradeMetrics metrics;
+    if (count == 0)
+    {
+        return metrics;
+    }
+
+    // Plain reductions with branch-free selects, so the compiler can vectorize this loop
+    double sum = 0.0;
+    double downsideSquares = 0.0;
+    double grossProfit = 0.0;
+    double grossLoss = 0.0;
+    double wins = 0.0;
+    double losses = 0.0;
+    double durationSum = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double x = profitLoss[i];
+        double gain = x > 0.0 ? x : 0.0;
+        double loss = x < 0.0 ? x : 0.0;
+        sum += x;
+        downsideSquares += loss * loss;
+        grossProfit += gain;
+        grossLoss += loss;
+        wins += x > 0.0 ? 1.0 : 0.0;
+        losses += x < 0.0 ? 1.0 : 0.0;
+        durationSum += durationSeconds[i];
+    }
+
+    double n = (double)count;
+    double mean = sum / n;
+
+    // The equity curve is a running sum, so the drawdown terms stay in a scalar loop
+    double squaredDeviations = 0.0;
+    double equity = 0.0;
+    double peak = -HUGE_VAL;
+    double maxDrawdown = 0.0;
+    double drawdownSquares = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double x = profitLoss[i];
+        double deviation = x - mean;
+        squaredDeviations += deviation * deviation;
+
+        equity += x;
+        peak = (std::max)(peak, equity);
+        double drawdown = equity - peak;
+        maxDrawdown = (std::min)(maxDrawdown, drawdown);
+        drawdownSquares += drawdown * drawdown;
+    }
+
+    // Per trade ratios with a zero risk-free rate, matching the visualizer's original pandas calculation
+    double standardDeviation = count > 1 ? std::sqrt(squaredDeviations / (n - 1.0)) : 0.0;
+    double downsideDeviation = std::sqrt(downsideSquares / n);
+
+    metrics.TotalProfitLoss = sum;
+    metrics.NumberOfTrades = (int)count;
+    metrics.AverageTradeDuration = durationSum / n;
+    metrics.SharpeRatio = standardDeviation > 0.0 ? mean / standardDeviation : 0.0;
+    metrics.SortinoRatio = downsideDeviation > 0.0 ? mean / downsideDeviation : 0.0;
+    metrics.MaximumDrawdown = maxDrawdown;
+    metrics.CalmarRatio = maxDrawdown < 0.0 ? sum / -maxDrawdown : 0.0;
+    metrics.WinRate = wins / n * 100.0;
+    metrics.Expectancy = (wins > 0.0 ? wins / n * (grossProfit / wins) : 0.0) + (losses > 0.0 ? losses / n * (grossLoss / losses) : 0.0);
+    metrics.UlcerIndex = std::sqrt(drawdownSquares / n);
+    return metrics;
+}
+
+TradeMetrics TradeMetricsCalculator::Calculate(const TradeSeries &series)
+{
+    return Calculate(series.ProfitLoss.data(), series.DurationSeconds.data(), series.Size());
+}
+
+json TradeMetricsCalculator::ToJson(const TradeMetrics &metrics)
+{
+    return {
+        {"TotalProfitLoss", metrics.TotalProfitLoss},
+        {"NumberOfTrades", metrics.NumberOfTrades},
+        {"AverageTradeDuration", metrics.AverageTradeDuration},
+        {"SharpeRatio", metrics.SharpeRatio},
+        {"SortinoRatio", metrics.SortinoRatio},
+        {"CalmarRatio", metrics.CalmarRatio},
+        {"MaximumDrawdown", metrics.MaximumDrawdown},
+        {"WinRate", metrics.WinRate},
+        {"Expectancy", metrics.Expectancy},
+        {"UlcerIndex", metrics.UlcerIndex}};
+}
+
+json TradeMetricsCalculator::GetPerformanceMetrics(const TradeSeries &series)
+{
+    return {
+        {"Combined", ToJson(Calculate(series))},
+        {"Long", ToJson(Calculate(FilterByTradeType(series, 1)))},
+        {"Short", ToJson(Calculate(FilterByTradeType(series, -1)))}};
+}
+
+json TradeMetricsCalculator::GetDailyProfitLoss(const TradeSeries &series)
+{
+    // Whole days of the SCDateTime close time, so combinations can be aligned on a common calendar
+    std::map<int, double> profitLossByDay;
+    for (size_t i = 0; i < series.Size(); ++i)
+    {
+        profitLossByDay[(int)std::floor(series.CloseDateTime[i])] += series.ProfitLoss[i];
+    }
+
+    json days = json::array();
+    json profitLoss = json::array();
+    for (const auto &day : profitLossByDay)
+    {
+        days.push_back(day.first);
+        profitLoss.push_back(day.second);
+    }
+    return {
+        {"Days", days},
+        {"ProfitLoss", profitLoss}};
+}
+
+json TradeMetricsCalculator::GetTimeBuckets(const TradeSeries &series, int sessionStartSeconds, int sessionEndSeconds)
+{
+    std::map<int, TimeBucket> minutes;
+    std::map<int, TimeBucket> hours;
+    std::map<int, TimeBucket> weekdays;
+    std::map<std::string, TimeBucket> sessions;
+    for (size_t i = 0; i < series.Size(); ++i)
+    {
+        // Entry time in whole milliseconds, so a time stored as 09:29:59.9999999 still lands in 09:30
+        long long milliseconds = std::llround(series.OpenDateTime[i] * MILLISECONDS_PER_DAY);
+        long long day = milliseconds / MILLISECONDS_PER_DAY;
+        int secondOfDay = (int)(milliseconds % MILLISECONDS_PER_DAY / 1000);
+
+        // Day 0 of SCDateTime, 1899-12-30, was a Saturday. Weekdays count from 0 for Sunday.
+        int weekday = (int)((day + 6) % 7);
+
+        // The day session may wrap past midnight, its end time is inclusive
+        bool inSession = sessionStartSeconds <= sessionEndSeconds
+                             ? secondOfDay >= sessionStartSeconds && secondOfDay <= sessionEndSeconds
+                             : secondOfDay >= sessionStartSeconds || secondOfDay <= sessionEndSeconds;
+
+        double profitLoss = series.ProfitLoss[i];
+        AddToBucket(minutes[secondOfDay / 60], profitLoss);
+        AddToBucket(hours[secondOfDay / 3600], profitLoss);
+        AddToBucket(weekdays[weekday], profitLoss);
+        AddToBucket(sessions[inSession ? "RTH" : "ETH"], profitLoss);
+    }
+
+    return {
+        {"SessionStartSeconds", sessionStartSeconds},
+        {"SessionEndSeconds", sessionEndSeconds},
+        {"MinuteOfDay", BucketsToJson(minutes)},
+        {"Hour", BucketsToJson(hours)},
+        {"Weekday", BucketsToJson(weekdays)},
+        {"Session", BucketsToJson(sessions)}};
+}
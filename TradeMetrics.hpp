@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "nlohmann/json.hpp"
+#include <vector>
+
+using json = nlohmann::json;
+
+// Closed trades of a replay as contiguous arrays, in trade list order.
+// Date times are SCDateTime values as days, durations are seconds.
+struct TradeSeries
+{
+    std::vector<double> ProfitLoss;
+    std::vector<double> DurationSeconds;
+    std::vector<double> OpenDateTime;
+    std::vector<double> CloseDateTime;
+    std::vector<int> TradeType;
+
+    size_t Size() const { return ProfitLoss.size(); }
+};
+
+struct TradeMetrics
+{
+    double TotalProfitLoss = 0.0;
+    int NumberOfTrades = 0;
+    double AverageTradeDuration = 0.0;
+    double SharpeRatio = 0.0;
+    double SortinoRatio = 0.0;
+    double CalmarRatio = 0.0;
+    double MaximumDrawdown = 0.0;
+    double WinRate = 0.0;
+    double Expectancy = 0.0;
+    double UlcerIndex = 0.0;
+};
+
+class TradeMetricsCalculator
+{
+public:
+    static TradeSeries GetTradeSeries(SCStudyInterfaceRef sc);
+    static TradeSeries GetTradeSeries(const std::vector<s_ACSTrade> &trades); // e.g. from FillSimulator
+    static TradeSeries FilterByTradeType(const TradeSeries &series, int tradeType);
+    static TradeMetrics Calculate(const double *profitLoss, const double *durationSeconds, size_t count);
+    static TradeMetrics Calculate(const TradeSeries &series);
+    static json ToJson(const TradeMetrics &metrics);
+    static json GetPerformanceMetrics(const TradeSeries &series);
+    static json GetDailyProfitLoss(const TradeSeries &series);
+    static json GetTimeBuckets(const TradeSeries &series, int sessionStartSeconds, int sessionEndSeconds);
+};
@@ -0,0 +1,212 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#include "WalkForward.hpp"
+#include "OnChartLogging.hpp"
+#include <fstream>
+#include <filesystem>
+#include <iomanip>
+
+namespace fs = std::filesystem;
+
+namespace WalkForward
+{
+    std::vector<WalkForwardWindow> BuildWindows(const ReplayConfig &replayConfig, const WalkForwardConfig &walkForwardConfig, int comboCount)
+    {
+        std::vector<WalkForwardWindow> windows;
+        double end = replayConfig.EndDateTime.GetAsDouble();
+        for (double start = replayConfig.StartDateTime.GetAsDouble();
+             start + walkForwardConfig.InSampleDays + walkForwardConfig.OutOfSampleDays <= end;
+             start += walkForwardConfig.StepDays)
+        {
+            WalkForwardWindow window;
+            window.InSampleStart = start;
+            window.OutOfSampleStart = start + walkForwardConfig.InSampleDays;
+            window.OutOfSampleEnd = start + walkForwardConfig.InSampleDays + walkForwardConfig.OutOfSampleDays;
+            window.RemainingInSample = comboCount;
+            windows.push_back(window);
+        }
+        return windows;
+    }
+
+    int GetInSampleItemCount(const WalkForwardPlan &plan)
+    {
+        return (int)plan.Windows.size() * plan.ComboCount;
+    }
+
+    int GetWorkItemCount(const WalkForwardPlan &plan)
+    {
+        return GetInSampleItemCount(plan) + (int)plan.Windows.size();
+    }
+
+    int GetWindowIndex(const WalkForwardPlan &plan, int workItem)
+    {
+        if (IsOutOfSample(plan, workItem))
+        {
+            return workItem - GetInSampleItemCount(plan);
+        }
+        return workItem / plan.ComboCount;
+    }
+
+    bool IsOutOfSample(const WalkForwardPlan &plan, int workItem)
+    {
+        return workItem >= GetInSampleItemCount(plan);
+    }
+
+    int GetOutOfSampleItem(const WalkForwardPlan &plan, int windowIndex)
+    {
+        return GetInSampleItemCount(plan) + windowIndex;
+    }
+
+    int GetComboIndex(const WalkForwardPlan &plan, int workItem)
+    {
+        if (IsOutOfSample(plan, workItem))
+        {
+            return plan.Windows[GetWindowIndex(plan, workItem)].BestComboIndex;
+        }
+        return workItem % plan.ComboCount;
+    }
+
+    ReplayConfig GetReplayConfig(const WalkForwardPlan &plan, const ReplayConfig &replayConfig, int workItem)
+    {
+        const WalkForwardWindow &window = plan.Windows[GetWindowIndex(plan, workItem)];
+        ReplayConfig windowReplayConfig = replayConfig;
+        if (IsOutOfSample(plan, workItem))
+        {
+            windowReplayConfig.StartDateTime = window.OutOfSampleStart;
+            windowReplayConfig.EndDateTime = window.OutOfSampleEnd;
+        }
+        else
+        {
+            windowReplayConfig.StartDateTime = window.InSampleStart;
+            windowReplayConfig.EndDateTime = window.OutOfSampleStart;
+        }
+        return windowReplayConfig;
+    }
+
+    std::string GetReportDirectory(const WalkForwardPlan &plan, const std::string &resultsDir, int workItem)
+    {
+        // Each in-sample sweep gets its own folder, so it can be analyzed like a normal sweep
+        if (IsOutOfSample(plan, workItem))
+        {
+            return resultsDir + "out-of-sample/";
+        }
+        return resultsDir + "window-" + std::to_string(GetWindowIndex(plan, workItem)) + "/";
+    }
+
+    std::string GetReportFileName(const WalkForwardPlan &plan, int workItem)
+    {
+        if (IsOutOfSample(plan, workItem))
+        {
+            return plan.FilePrefix + "-window-" + std::to_string(GetWindowIndex(plan, workItem)) + ".json";
+        }
+        return plan.FilePrefix + "-" + std::to_string(GetComboIndex(plan, workItem)) + ".json";
+    }
+
+    int SelectBest(const std::vector<CombinationResult> &results, const ObjectiveConfig &objective, double &bestValue)
+    {
+        int bestComboIndex = -1;
+        for (const auto &result : results)
+        {
+            if (result.status != "completed" || result.comboIndex < 0)
+                continue;
+
+            double value = result.GetMetric(objective.Metric);
+            if (bestComboIndex < 0 || (objective.Maximize ? value > bestValue : value < bestValue))
+            {
+                bestComboIndex = result.comboIndex;
+                bestValue = value;
+            }
+        }
+        return bestComboIndex;
+    }
+
+    void RecordOutOfSample(WalkForwardPlan &plan, int workItem, const TradeSeries &series)
+    {
+        WalkForwardWindow &window = plan.Windows[GetWindowIndex(plan, workItem)];
+        window.OutOfSampleCompleted = true;
+        window.OutOfSampleTrades = TradeSeries();
+
+        // The trade list may still hold trades of earlier replays when it is not cleared between them
+        double start = window.OutOfSampleStart.GetAsDouble();
+        double end = window.OutOfSampleEnd.GetAsDouble();
+        for (size_t i = 0; i < series.Size(); ++i)
+        {
+            if (series.OpenDateTime[i] < start || series.OpenDateTime[i] >= end)
+                continue;
+
+            window.OutOfSampleTrades.ProfitLoss.push_back(series.ProfitLoss[i]);
+            window.OutOfSampleTrades.DurationSeconds.push_back(series.DurationSeconds[i]);
+            window.OutOfSampleTrades.OpenDateTime.push_back(series.OpenDateTime[i]);
+            window.OutOfSampleTrades.CloseDateTime.push_back(series.CloseDateTime[i]);
+            window.OutOfSampleTrades.TradeType.push_back(series.TradeType[i]);
+        }
+    }
+
+    void WriteResults(SCStudyInterfaceRef sc, const WalkForwardPlan &plan, const std::string &equityCurvePath)
+    {
+        SCString msg;
+        std::ofstream curveFile(equityCurvePath);
+        std::string windowsPath = fs::path(equityCurvePath).replace_extension().string() + "-windows.csv";
+        std::ofstream windowsFile(windowsPath);
+        if (!curveFile.is_open() || !windowsFile.is_open())
+        {
+            msg.Format("Failed to create walk-forward files at: %s", equityCurvePath.c_str());
+            OnChartLogging::AddLog(sc, msg);
+            return;
+        }
+
+        curveFile << std::fixed << std::setprecision(6);
+        windowsFile << std::fixed << std::setprecision(6);
+        curveFile << "Window,Open DateTime,Close DateTime,Trade Type,Profit/Loss,Equity\n";
+        windowsFile << "Window,In-Sample Start,Out-Of-Sample Start,Out-Of-Sample End,Best Combination,In-Sample Objective,Out-Of-Sample Trades,Out-Of-Sample P/L,Status\n";
+
+        // Windows are replayed in any order across lanes, the curve follows the calendar
+        TradeSeries stitched;
+        double equity = 0.0;
+        double coveredUntil = 0.0;
+        for (int w = 0; w < (int)plan.Windows.size(); ++w)
+        {
+            const WalkForwardWindow &window = plan.Windows[w];
+            const TradeSeries &trades = window.OutOfSampleTrades;
+            double windowProfitLoss = 0.0;
+            for (size_t i = 0; i < trades.Size(); ++i)
+            {
+                // With stepDays < outOfSampleDays the ranges overlap, the earlier window keeps the shared days
+                if (trades.OpenDateTime[i] < coveredUntil)
+                    continue;
+
+                equity += trades.ProfitLoss[i];
+                windowProfitLoss += trades.ProfitLoss[i];
+                stitched.ProfitLoss.push_back(trades.ProfitLoss[i]);
+                stitched.DurationSeconds.push_back(trades.DurationSeconds[i]);
+                stitched.OpenDateTime.push_back(trades.OpenDateTime[i]);
+                stitched.CloseDateTime.push_back(trades.CloseDateTime[i]);
+                stitched.TradeType.push_back(trades.TradeType[i]);
+
+                curveFile << w << ","
+                          << sc.DateTimeToString(trades.OpenDateTime[i], FLAG_DT_COMPLETE_DATETIME).GetChars() << ","
+                          << sc.DateTimeToString(trades.CloseDateTime[i], FLAG_DT_COMPLETE_DATETIME).GetChars() << ","
+                          << trades.TradeType[i] << ","
+                          << trades.ProfitLoss[i] << ","
+                          << equity << "\n";
+            }
+
+            const char *status = window.BestComboIndex < 0 ? "no in-sample winner" : (window.OutOfSampleCompleted ? "completed" : "failed");
+            windowsFile << w << ","
+                        << sc.DateTimeToString(window.InSampleStart, FLAG_DT_COMPLETE_DATETIME).GetChars() << ","
+                        << sc.DateTimeToString(window.OutOfSampleStart, FLAG_DT_COMPLETE_DATETIME).GetChars() << ","
+                        << sc.DateTimeToString(window.OutOfSampleEnd, FLAG_DT_COMPLETE_DATETIME).GetChars() << ","
+                        << window.BestComboIndex << ","
+                        << window.BestObjective << ","
+                        << trades.Size() << ","
+                        << windowProfitLoss << ","
+                        << status << "\n";
+            coveredUntil = window.OutOfSampleEnd.GetAsDouble();
+        }
+
+        TradeMetrics metrics = TradeMetricsCalculator::Calculate(stitched);
+        msg.Format("Walk-forward out-of-sample: %d trades, P/L %.2f, max drawdown %.2f over %d windows. Saved to: %s", metrics.NumberOfTrades, metrics.TotalProfitLoss, metrics.MaximumDrawdown, (int)plan.Windows.size(), equityCurvePath.c_str());
+        OnChartLogging::AddLog(sc, msg);
+    }
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Chek Wei Tan
+// Licensed under the MIT License. See LICENSE file in the project root for full license information.
+
+#pragma once
+#include "../sierrachart.h"
+#include "ConfigManager.hpp"
+#include "ResultAnalyzer.hpp"
+#include "TradeMetrics.hpp"
+#include <string>
+#include <vector>
+
+struct WalkForwardWindow
+{
+    SCDateTime InSampleStart;
+    SCDateTime OutOfSampleStart;
+    SCDateTime OutOfSampleEnd;
+    int RemainingInSample = 0;
+    int BestComboIndex = -1;
+    double BestObjective = 0.0;
+    bool OutOfSampleCompleted = false;
+    TradeSeries OutOfSampleTrades;
+};
+
+// Work items of a walk-forward run. The in-sample replays of every window come first, window by window,
+// followed by one out-of-sample replay per window that is queued once its in-sample sweep is analyzed.
+struct WalkForwardPlan
+{
+    std::vector<WalkForwardWindow> Windows;
+    int ComboCount = 0;
+    std::string FilePrefix;
+};
+
+namespace WalkForward
+{
+    std::vector<WalkForwardWindow> BuildWindows(const ReplayConfig &replayConfig, const WalkForwardConfig &walkForwardConfig, int comboCount);
+
+    int GetInSampleItemCount(const WalkForwardPlan &plan);
+    int GetWorkItemCount(const WalkForwardPlan &plan);
+    int GetWindowIndex(const WalkForwardPlan &plan, int workItem);
+    bool IsOutOfSample(const WalkForwardPlan &plan, int workItem);
+    int GetOutOfSampleItem(const WalkForwardPlan &plan, int windowIndex);
+
+    // Combination replayed by a work item, -1 for an out-of-sample item whose window has no winner yet
+    int GetComboIndex(const WalkForwardPlan &plan, int workItem);
+    ReplayConfig GetReplayConfig(const WalkForwardPlan &plan, const ReplayConfig &replayConfig, int workItem);
+
+    std::string GetReportDirectory(const WalkForwardPlan &plan, const std::string &resultsDir, int workItem);
+    std::string GetReportFileName(const WalkForwardPlan &plan, int workItem);
+
+    // Best completed result by the objective, or -1 when the window has no completed combination
+    int SelectBest(const std::vector<CombinationResult> &results, const ObjectiveConfig &objective, double &bestValue);
+
+    // Keeps the closed trades opened inside the window's out-of-sample range
+    void RecordOutOfSample(WalkForwardPlan &plan, int workItem, const TradeSeries &series);
+
+    // Stitched out-of-sample equity curve, and one row per window next to it
+    void WriteResults(SCStudyInterfaceRef sc, const WalkForwardPlan &plan, const std::string &equityCurvePath);
+}
@@ -55,6 +55,23 @@ def calculate_metrics(trades):
         'Win Rate': win_rate
     }
 
+# Report keys of the optimizer's performanceMetrics section and their column labels
+METRIC_LABELS = {
+    'TotalProfitLoss': 'Total Profit/Loss',
+    'NumberOfTrades': 'Number of trades',
+    'AverageTradeDuration': 'Average trade duration',
+    'SharpeRatio': 'Sharpe Ratio',
+    'SortinoRatio': 'Sortino Ratio',
+    'CalmarRatio': 'Calmar Ratio',
+    'MaximumDrawdown': 'Maximum Drawdown',
+    'WinRate': 'Win Rate',
+    'Expectancy': 'Expectancy',
+    'UlcerIndex': 'Ulcer Index'
+}
+
+def to_metric_labels(metrics):
+    return {label: metrics.get(key, 0) for key, label in METRIC_LABELS.items()}
+
 # Function to generate equity curve data
 def generate_equity_curve(trades):
     if not trades:
@@ -77,8 +94,27 @@ def generate_equity_curve(trades):
     
     return pd.concat([initial_equity_point, equity_curve]).sort_values(by='DateTime').reset_index(drop=True)
 
+# Buckets written by the optimizer into each report, keyed by their numeric entry time
+def get_bucket_analysis(time_buckets, bucket_set, column, all_buckets, fold=None):
+    buckets = time_buckets.get(bucket_set, {})
+    df = pd.DataFrame({
+        column: buckets.get('Bucket', []),
+        'Profitable_Trades': buckets.get('Profitable', []),
+        'Losing_Trades': buckets.get('Losing', [])
+    })
+    if fold:
+        df[column] = df[column].apply(fold)
+    df = df.groupby(column, as_index=False)[['Profitable_Trades', 'Losing_Trades']].sum()
+
+    analysis = pd.merge(pd.DataFrame({column: all_buckets}), df, on=column, how='left').fillna(0)
+    analysis['Profitable_Trades'] = analysis['Profitable_Trades'].astype(int)
+    analysis['Losing_Trades'] = analysis['Losing_Trades'].astype(int)
+    return analysis
+
 # Function to analyze profit/loss by entry minute
-def analyze_profit_loss_by_entry_minute(trades_df):
+def analyze_profit_loss_by_entry_minute(trades_df, time_buckets=None):
+    if time_buckets:
+        return get_bucket_analysis(time_buckets, 'MinuteOfDay', 'EntryMinute', range(60), fold=lambda m: m % 60)
     if trades_df.empty:
         return pd.DataFrame(columns=['EntryMinute', 'Profitable Trades', 'Losing Trades'])
 
@@ -105,7 +141,9 @@ def analyze_profit_loss_by_entry_minute(trades_df):
     return minute_analysis
 
 # Function to analyze profit/loss by entry hour
-def analyze_profit_loss_by_entry_hour(trades_df):
+def analyze_profit_loss_by_entry_hour(trades_df, time_buckets=None):
+    if time_buckets:
+        return get_bucket_analysis(time_buckets, 'Hour', 'EntryHour', range(24))
     if trades_df.empty:
         return pd.DataFrame(columns=['EntryHour', 'Profitable Trades', 'Losing Trades'])
 
@@ -129,7 +167,10 @@ def analyze_profit_loss_by_entry_hour(trades_df):
     return hour_analysis
 
 # Function to analyze profit/loss by session (RTH vs ETH)
-def analyze_profit_loss_by_session(trades_df, rth_start_hour=9, rth_start_minute=30, rth_end_hour=16, rth_end_minute=0):
+def analyze_profit_loss_by_session(trades_df, rth_start_hour=9, rth_start_minute=30, rth_end_hour=16, rth_end_minute=0, time_buckets=None):
+    if time_buckets:
+        # The optimizer takes RTH from the chart's day session
+        return get_bucket_analysis(time_buckets, 'Session', 'Session', ['RTH', 'ETH'])
     if trades_df.empty:
         return pd.DataFrame(columns=['Session', 'Profitable Trades', 'Losing Trades'])
 
@@ -161,6 +202,34 @@ def analyze_profit_loss_by_session(trades_df, rth_start_hour=9, rth_start_minute
 
     return session_analysis
 
+WEEKDAY_NAMES = ['Sunday', 'Monday', 'Tuesday', 'Wednesday', 'Thursday', 'Friday', 'Saturday']
+
+# Function to analyze profit/loss by entry weekday
+def analyze_profit_loss_by_entry_weekday(trades_df, time_buckets=None):
+    if time_buckets:
+        return get_bucket_analysis(time_buckets, 'Weekday', 'EntryWeekday', WEEKDAY_NAMES, fold=lambda d: WEEKDAY_NAMES[d])
+    if trades_df.empty:
+        return pd.DataFrame(columns=['EntryWeekday', 'Profitable Trades', 'Losing Trades'])
+
+    df = trades_df.copy()
+    df['OpenDateTime'] = pd.to_datetime(df['OpenDateTime'])
+    df['EntryWeekday'] = df['OpenDateTime'].dt.day_name()
+
+    df['IsProfitable'] = df['TradeProfitLoss'] > 0
+    df['IsLosing'] = df['TradeProfitLoss'] < 0
+
+    weekday_analysis = df.groupby('EntryWeekday').agg(
+        Profitable_Trades=('IsProfitable', lambda x: x.sum()),
+        Losing_Trades=('IsLosing', lambda x: x.sum())
+    ).reset_index()
+
+    all_weekdays = pd.DataFrame({'EntryWeekday': WEEKDAY_NAMES})
+    weekday_analysis = pd.merge(all_weekdays, weekday_analysis, on='EntryWeekday', how='left').fillna(0)
+    weekday_analysis['Profitable_Trades'] = weekday_analysis['Profitable_Trades'].astype(int)
+    weekday_analysis['Losing_Trades'] = weekday_analysis['Losing_Trades'].astype(int)
+
+    return weekday_analysis
+
 
 # Function to load and process data from JSON files
 def load_and_process_data(folder_path):
@@ -174,6 +243,10 @@ def load_and_process_data(folder_path):
         file_path = os.path.join(folder_path, filename)
         with open(file_path, 'r') as f:
             data = json.load(f)
+
+            # Combinations abandoned by the replay watchdog carry no trades
+            if data.get('status') == 'failed':
+                continue
             
             # Extract strategy name from the first file
             if i == 0:
@@ -185,21 +258,26 @@ def load_and_process_data(folder_path):
             trades_data = data.get('tradesData', [])
             trade_statistics = data.get('tradeStatistics', {})
 
-            # Generate equity curve for the current combination
-            equity_curve_df = generate_equity_curve(trades_data)
-
+            # The equity curve is only needed for the selected combination, it is generated on demand
             raw_data[combination_id] = {
                 "tradeStatistics": trade_statistics,
                 "tradesData": trades_data,
-                "equityCurve": equity_curve_df # Store the equity curve DataFrame
+                "timeBuckets": data.get('timeBuckets')
             }
-            
-            long_trades = [t for t in trades_data if t['TradeType'] == 1]
-            short_trades = [t for t in trades_data if t['TradeType'] == -1]
-            
-            combined_metrics = calculate_metrics(trades_data)
-            long_metrics = calculate_metrics(long_trades)
-            short_metrics = calculate_metrics(short_trades)
+
+            performance_metrics = data.get('performanceMetrics')
+            if performance_metrics:
+                # Reports written by the optimizer carry the metrics already
+                combined_metrics = to_metric_labels(performance_metrics.get('Combined', {}))
+                long_metrics = to_metric_labels(performance_metrics.get('Long', {}))
+                short_metrics = to_metric_labels(performance_metrics.get('Short', {}))
+            else:
+                long_trades = [t for t in trades_data if t['TradeType'] == 1]
+                short_trades = [t for t in trades_data if t['TradeType'] == -1]
+
+                combined_metrics = calculate_metrics(trades_data)
+                long_metrics = calculate_metrics(long_trades)
+                short_metrics = calculate_metrics(short_trades)
             
             row = {**combination}
             row['combination_id'] = combination_id
@@ -214,11 +292,39 @@ def load_and_process_data(folder_path):
                 
     return pd.DataFrame(all_data), raw_data, strategy_name
 
+# Tables precomputed by the optimizer for the combined metrics, by summary metric name
+HEATMAP_CUBE_METRICS = {
+    'Combined_Sharpe_Ratio': 'sharpeRatio',
+    'Combined_Total_Profit/Loss': 'totalProfitLoss',
+}
+
+def load_heatmap_cubes(folder_path):
+    cube_files = [f for f in os.listdir(folder_path) if f.endswith('-heatmaps.csv')]
+    if not cube_files:
+        return None
+    return pd.read_csv(os.path.join(folder_path, cube_files[0]))
+
+def get_cube_pivot(cubes, value_col, x_col, y_col):
+    metric = HEATMAP_CUBE_METRICS.get(value_col)
+    if cubes is None or metric is None:
+        return None
+
+    # Each pair is stored once, with the parameters in input order
+    rows = cubes[(cubes['Metric'] == metric) & (cubes['X Parameter'] == x_col) & (cubes['Y Parameter'] == y_col)]
+    if not rows.empty:
+        return rows.pivot(index='Y Value', columns='X Value', values='Mean')
+    rows = cubes[(cubes['Metric'] == metric) & (cubes['X Parameter'] == y_col) & (cubes['Y Parameter'] == x_col)]
+    if not rows.empty:
+        return rows.pivot(index='X Value', columns='Y Value', values='Mean')
+    return None
+
 # --- Visualization Functions ---
-def create_heatmap(df, value_col, x_col, y_col):
+def create_heatmap(df, value_col, x_col, y_col, cubes=None):
     if x_col and y_col and value_col and x_col != y_col:
         try:
-            pivot_table = df.pivot_table(values=value_col, index=y_col, columns=x_col)
+            pivot_table = get_cube_pivot(cubes, value_col, x_col, y_col)
+            if pivot_table is None:
+                pivot_table = df.pivot_table(values=value_col, index=y_col, columns=x_col)
             fig = px.imshow(pivot_table, text_auto=True, aspect="auto",
                             labels=dict(x=x_col, y=y_col, color=value_col),
                             title=f'Heatmap of {value_col}')
@@ -244,6 +350,7 @@ folder_path = st.text_input('Enter the path to the folder containing JSON files:
 
 if os.path.isdir(folder_path):
     df, raw_data, strategy_name = load_and_process_data(folder_path)
+    heatmap_cubes = load_heatmap_cubes(folder_path)
     
     if not df.empty:
         st.success(f'Successfully loaded and processed {len(df)} JSON files.')
@@ -281,7 +388,7 @@ if os.path.isdir(folder_path):
                 with col2:
                     y_axis = st.selectbox(f'Select Y-axis for {prefix} Heatmap', options=param_cols, index=1 if len(param_cols)>1 else 0, key=f'{prefix}_y')
 
-                heatmap = create_heatmap(df, f'{prefix}Sharpe_Ratio', x_axis, y_axis)
+                heatmap = create_heatmap(df, f'{prefix}Sharpe_Ratio', x_axis, y_axis, heatmap_cubes)
                 if heatmap:
                     st.plotly_chart(heatmap, use_container_width=True)
                     st.download_button(label=f"Save Heatmap as HTML", data=heatmap.to_html(), file_name=f'{prefix}heatmap.html', mime='text/html')
@@ -336,11 +443,12 @@ if os.path.isdir(folder_path):
 
                 st.subheader("Individual Trades")
                 trades_df = pd.DataFrame(raw_data[selected_combination_id]['tradesData'])
+                time_buckets = raw_data[selected_combination_id]['timeBuckets']
                 st.dataframe(trades_df)
 
                 # Display Equity Curve for the selected combination
                 st.subheader("Equity Curve")
-                equity_curve_df = raw_data[selected_combination_id]['equityCurve']
+                equity_curve_df = generate_equity_curve(raw_data[selected_combination_id]['tradesData'])
                 if not equity_curve_df.empty:
                     fig_equity = go.Figure()
                     fig_equity.add_trace(go.Scatter(x=equity_curve_df['DateTime'], y=equity_curve_df['Equity'],
@@ -399,7 +507,7 @@ if os.path.isdir(folder_path):
                 # Add section for P/L by Entry Minute
                 st.subheader("Profit/Loss by Entry Minute")
                 if not trades_df.empty:
-                    minute_pl_analysis_df = analyze_profit_loss_by_entry_minute(trades_df)
+                    minute_pl_analysis_df = analyze_profit_loss_by_entry_minute(trades_df, time_buckets)
                     st.dataframe(minute_pl_analysis_df)
 
                     fig_minute_pl = go.Figure(data=[
@@ -423,7 +531,7 @@ if os.path.isdir(folder_path):
                 # Add section for P/L by Entry Hour
                 st.subheader("Profit/Loss by Entry Hour")
                 if not trades_df.empty:
-                    hour_pl_analysis_df = analyze_profit_loss_by_entry_hour(trades_df)
+                    hour_pl_analysis_df = analyze_profit_loss_by_entry_hour(trades_df, time_buckets)
                     st.dataframe(hour_pl_analysis_df)
 
                     fig_hour_pl = go.Figure(data=[
@@ -443,10 +551,33 @@ if os.path.isdir(folder_path):
                 else:
                     st.info("No individual trade data to analyze profit/loss by entry hour.")
 
+                # Add section for P/L by Entry Weekday
+                st.subheader("Profit/Loss by Entry Weekday")
+                if not trades_df.empty:
+                    weekday_pl_analysis_df = analyze_profit_loss_by_entry_weekday(trades_df, time_buckets)
+                    st.dataframe(weekday_pl_analysis_df)
+
+                    fig_weekday_pl = go.Figure(data=[
+                        go.Bar(name='Profitable Trades', x=weekday_pl_analysis_df['EntryWeekday'], y=weekday_pl_analysis_df['Profitable_Trades'], marker_color='green'),
+                        go.Bar(name='Losing Trades', x=weekday_pl_analysis_df['EntryWeekday'], y=weekday_pl_analysis_df['Losing_Trades'], marker_color='red')
+                    ])
+                    fig_weekday_pl.update_layout(
+                        barmode='group',
+                        title=f'Profitable vs. Losing Trades by Entry Weekday for {selected_combination_id}',
+                        xaxis_title='Entry Weekday',
+                        yaxis_title='Number of Trades'
+                    )
+                    st.plotly_chart(fig_weekday_pl, use_container_width=True)
+                    st.download_button(label=f"Save P/L by Entry Weekday Chart as HTML", data=fig_weekday_pl.to_html(), 
+                                       file_name=f'pl_by_entry_weekday_{selected_combination_id.replace(": ", "_").replace(", ", "__")}.html', 
+                                       mime='text/html')
+                else:
+                    st.info("No individual trade data to analyze profit/loss by entry weekday.")
+
                 # Add section for P/L by Session (RTH vs ETH)
                 st.subheader("Profit/Loss by Session (RTH vs ETH)")
                 if not trades_df.empty:
-                    session_pl_analysis_df = analyze_profit_loss_by_session(trades_df)
+                    session_pl_analysis_df = analyze_profit_loss_by_session(trades_df, time_buckets=time_buckets)
                     st.dataframe(session_pl_analysis_df)
 
                     fig_session_pl = go.Figure(data=[